@@ -16,6 +16,9 @@
 .section .text
 .balign 4
 .global cpuHalt			# halt CPU
+.global cpuTimestamp		# read time-stamp counter
+.global cpuIdle			# wait for interrupt
+.global cpuZeroPage		# zero page
 
 
 # Halt CPU
@@ -26,3 +29,31 @@ cpuHalt:
 	jmp 1b
 .size cpuHalt, . - cpuHalt
 
+# Read time-stamp counter
+.type cpuTimestamp, @function
+cpuTimestamp:
+	rdtsc				# EDX:EAX = TSC
+	retl
+.size cpuTimestamp, . - cpuTimestamp
+
+# Enable interrupts and wait for interrupt (sti holds interrupts until hlt)
+.type cpuIdle, @function
+cpuIdle:
+	sti
+	hlt
+	retl
+.size cpuIdle, . - cpuIdle
+
+# Zero page (plain stores, non-temporal ones need SSE2)
+.type cpuZeroPage, @function
+cpuZeroPage:
+	pushl	%edi			# Save EDI
+	movl	8(%esp), %edi		# Page address
+	xorl	%eax, %eax		# Zero value
+	movl	$0x400, %ecx		# Page size in dwords
+	cld
+	rep	stosl			# Zero page
+	popl	%edi			# Restore EDI
+	retl
+.size cpuZeroPage, . - cpuZeroPage
+
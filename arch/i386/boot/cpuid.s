@@ -0,0 +1,61 @@
+################################################################
+#
+#	CPUID instruction functions
+#
+#	File:	cpuid.s
+#	Date:	16 Oct 2026
+#
+#	Copyright (c) 2017 - 2021, Igor Baklykov
+#	All rights reserved.
+#
+#
+
+
+
+.set	CPUID_EFLAGS_ID,	0x00200000	# EFLAGS ID bit (writable only if CPUID exists)
+
+
+.code32
+
+.section .text
+.balign 4
+
+.global cpuidCheck				# Check if CPUID instruction exists
+.global cpuid					# Execute CPUID instruction with required params
+
+
+# Check if CPUID instruction exists
+.type cpuidCheck, @function
+cpuidCheck:
+	pushfl					# Save EFLAGS
+	pushfl					# Get EFLAGS copy
+	xorl	$CPUID_EFLAGS_ID, (%esp)	# Toggle ID bit
+	popfl					# Try to write it back
+	pushfl					# Read EFLAGS again
+	popl	%eax
+	xorl	(%esp), %eax			# Check which bits were changed
+	popfl					# Restore EFLAGS
+	andl	$CPUID_EFLAGS_ID, %eax		# ID bit changed only if CPUID exists
+	shrl	$21, %eax			# Return bool
+	retl
+.size cpuidCheck, . - cpuidCheck
+
+# Execute CPUID with reauired flags
+.type cpuid, @function
+cpuid:
+	pushl	%ebx				# Save EBX (callee-saved, clobbered by CPUID)
+	pushl	%edi				# Save EDI
+	movl	12(%esp), %edi			# Get hidden pointer to result structure
+	movl	16(%esp), %eax			# Put flag to EAX register
+	xorl	%ecx, %ecx			# Use subleaf 0
+	cpuid					# Execute CPUID
+	movl	%eax, 0(%edi)			# Store EAX
+	movl	%ebx, 4(%edi)			# Store EBX
+	movl	%ecx, 8(%edi)			# Store ECX
+	movl	%edx, 12(%edi)			# Store EDX
+	movl	%edi, %eax			# Return pointer to result structure
+	popl	%edi				# Restore EDI
+	popl	%ebx				# Restore EBX
+	retl	$4				# Pop hidden pointer
+.size cpuid, . - cpuid
+
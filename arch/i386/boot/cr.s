@@ -22,6 +22,7 @@
 .global inCR0			# Write CR0 register
 .global inCR3			# Write CR3 register
 .global inCR4			# Write CR4 register
+.global invalidatePage		# Invalidate TLB entry of page
 
 
 # Read CR0 register
@@ -77,3 +78,12 @@ inCR4:
 	retl
 .size inCR4, . - inCR4
 
+
+# Invalidate TLB entry of page
+.type invalidatePage, @function
+invalidatePage:
+	movl	4(%esp), %eax
+	invlpg	(%eax)
+	retl
+.size invalidatePage, . - invalidatePage
+
@@ -35,6 +35,8 @@
 
 .global irqEnable			# Interrupts
 .global irqDisable			# No interrupts
+.global irqSave				# Save state and disable interrupts
+.global irqRestore			# Restore interrupts state
 
 .extern	interruptServiceRoutine		# Extenral main interrupts handler
 
@@ -198,3 +200,20 @@ irqDisable:
 	retl
 .size irqDisable, . - irqDisable
 
+# Save interrupts state and disable interrupts
+.type irqSave, @function
+irqSave:
+	pushfl				# Save flags
+	popl	%eax			# Return flags
+	cli				# Disable interrupts
+	retl
+.size irqSave, . - irqSave
+
+# Restore interrupts state
+.type irqRestore, @function
+irqRestore:
+	pushl	4(%esp)			# Saved flags
+	popfl				# Restore flags
+	retl
+.size irqRestore, . - irqRestore
+
@@ -35,6 +35,7 @@ interruptServiceRoutine:
 	movw	%ax, %fs		# ---//---
 	movw	%ax, %gs		# ---//---
 
+	cld				# Clear direction flag
 	movl	%esp, %eax		# Take pointer to stack
 	pushl	%eax			# Pass it as a regs struct pointer
 	call	isrHandler		# Call interrupt service routine handler
@@ -0,0 +1,39 @@
+################################################################
+#
+#	Kernel math routines
+#
+#	File:	math.s
+#	Date:	16 Oct 2026
+#
+#	Copyright (c) 2017 - 2021, Igor Baklykov
+#	All rights reserved.
+#
+#
+
+
+.code32
+
+.section .text
+.balign 4
+
+.global mathDivide64		# Divide 64-bit integer by 32-bit integer with two divl
+
+
+# Divide 64-bit integer by 32-bit integer (dividend, divisor, reminder pointer)
+.type mathDivide64, @function
+mathDivide64:
+	pushl	%ebx			# Save EBX
+	movl	16(%esp), %ecx		# Divisor
+	movl	12(%esp), %eax		# Dividend high dword
+	xorl	%edx, %edx
+	divl	%ecx			# High quotient (#DE on zero divisor)
+	movl	%eax, %ebx
+	movl	8(%esp), %eax		# Dividend low dword
+	divl	%ecx			# Low quotient (high reminder in EDX is below divisor)
+	movl	20(%esp), %ecx
+	movl	%edx, (%ecx)		# Store reminder
+	movl	%ebx, %edx		# Quotient high dword
+	popl	%ebx			# Restore EBX
+	retl
+.size mathDivide64, . - mathDivide64
+
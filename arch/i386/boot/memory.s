@@ -0,0 +1,119 @@
+################################################################
+#
+#	Memory fill and copy routines
+#
+#	File:	memory.s
+#	Date:	16 Oct 2026
+#
+#	Copyright (c) 2017 - 2021, Igor Baklykov
+#	All rights reserved.
+#
+#
+
+
+.set	MEMORY_BYTE_BROADCAST,	0x01010101		# Byte to dword broadcast multiplier
+
+
+.code32
+
+.section .text
+.balign 4
+
+.global memorySetRep		# Fill memory with rep stosl
+.global memorySetERMS		# Fill memory with rep stosb
+.global memoryCopyRep		# Copy memory with rep movsl
+.global memoryCopyERMS		# Copy memory with rep movsb
+.global memoryMoveBack		# Copy memory backwards with std; rep movsl
+
+
+# Fill memory with rep stosl (destination, size, value)
+.type memorySetRep, @function
+memorySetRep:
+	pushl	%edi			# Save EDI
+	movl	8(%esp), %edi		# Destination
+	movzbl	16(%esp), %eax		# Value
+	imull	$MEMORY_BYTE_BROADCAST, %eax	# Broadcast byte to dword
+	movl	12(%esp), %ecx
+	shrl	$2, %ecx		# Dwords count
+	cld				# Clear direction flag
+	rep	stosl
+	movl	12(%esp), %ecx
+	andl	$3, %ecx		# Tail bytes count
+	rep	stosb
+	popl	%edi			# Restore EDI
+	retl
+.size memorySetRep, . - memorySetRep
+
+# Fill memory with rep stosb (destination, size, value)
+.type memorySetERMS, @function
+memorySetERMS:
+	pushl	%edi			# Save EDI
+	movl	8(%esp), %edi		# Destination
+	movl	12(%esp), %ecx		# Size
+	movzbl	16(%esp), %eax		# Value
+	cld				# Clear direction flag
+	rep	stosb
+	popl	%edi			# Restore EDI
+	retl
+.size memorySetERMS, . - memorySetERMS
+
+
+# Copy memory with rep movsl (destination, source, size)
+.type memoryCopyRep, @function
+memoryCopyRep:
+	pushl	%edi			# Save EDI
+	pushl	%esi			# Save ESI
+	movl	12(%esp), %edi		# Destination
+	movl	16(%esp), %esi		# Source
+	movl	20(%esp), %ecx
+	shrl	$2, %ecx		# Dwords count
+	cld				# Clear direction flag
+	rep	movsl
+	movl	20(%esp), %ecx
+	andl	$3, %ecx		# Tail bytes count
+	rep	movsb
+	popl	%esi			# Restore ESI
+	popl	%edi			# Restore EDI
+	retl
+.size memoryCopyRep, . - memoryCopyRep
+
+# Copy memory with rep movsb (destination, source, size)
+.type memoryCopyERMS, @function
+memoryCopyERMS:
+	pushl	%edi			# Save EDI
+	pushl	%esi			# Save ESI
+	movl	12(%esp), %edi		# Destination
+	movl	16(%esp), %esi		# Source
+	movl	20(%esp), %ecx		# Size
+	cld				# Clear direction flag
+	rep	movsb
+	popl	%esi			# Restore ESI
+	popl	%edi			# Restore EDI
+	retl
+.size memoryCopyERMS, . - memoryCopyERMS
+
+
+# Copy memory backwards, safe for destination above overlapping source (destination, source, size)
+.type memoryMoveBack, @function
+memoryMoveBack:
+	pushl	%edi			# Save EDI
+	pushl	%esi			# Save ESI
+	movl	12(%esp), %edi		# Destination
+	movl	16(%esp), %esi		# Source
+	movl	20(%esp), %edx		# Size
+	leal	-4(%esi, %edx), %esi	# Last source dword
+	leal	-4(%edi, %edx), %edi	# Last destination dword
+	movl	%edx, %ecx
+	shrl	$2, %ecx		# Dwords count
+	std				# Set direction flag (move down)
+	rep	movsl
+	addl	$3, %esi		# Last source byte left
+	addl	$3, %edi		# Last destination byte left
+	movl	%edx, %ecx
+	andl	$3, %ecx		# Head bytes count
+	rep	movsb
+	cld				# Clear direction flag
+	popl	%esi			# Restore ESI
+	popl	%edi			# Restore EDI
+	retl
+.size memoryMoveBack, . - memoryMoveBack
@@ -17,6 +17,7 @@
 #include <arch/i386/cpu.hpp>
 
 #include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
 
 
 // i386 namespace
@@ -59,6 +60,8 @@ namespace igros::i386 {
 		);
 		// Dump registres
 		cpu::dumpRegisters(regs);
+		// Show events before failure
+		klib::ktraceRing::dump();
 		// Hang CPU
 		cpu::halt();
 	}
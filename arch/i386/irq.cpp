@@ -28,6 +28,10 @@ extern "C" {
 	inline void	irqEnable() noexcept;
 	// Disable interrupts
 	inline void	irqDisable() noexcept;
+	// Save interrupts state and disable interrupts
+	inline std::size_t	irqSave() noexcept;
+	// Restore interrupts state
+	inline void	irqRestore(const std::size_t flags) noexcept;
 
 #ifdef	__cplusplus
 
@@ -70,6 +74,17 @@ namespace igros::i386 {
 		::irqDisable();
 	}
 
+	// Save interrupts state and disable interrupts
+	[[nodiscard]]
+	std::size_t irq::save() noexcept {
+		return ::irqSave();
+	}
+
+	// Restore interrupts state
+	void irq::restore(const std::size_t flags) noexcept {
+		::irqRestore(flags);
+	}
+
 
 	// Mask interrupt
 	void irq::mask(const irq_t irqNumber) noexcept {
@@ -19,7 +19,9 @@
 #include <arch/i386/io.hpp>
 #include <arch/i386/cpu.hpp>
 
+#include <klib/klog.hpp>
 #include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
 
 
 // i386 namespace
@@ -59,8 +61,18 @@ extern "C" {
 	void isrHandler(const igros::i386::register_t* regs) noexcept {
 		// Check if irq/exception handler installed
 		if (const auto isr = igros::i386::isrList[regs->number]; nullptr != isr) {
-			// Handle ISR
-			isr(regs);
+			// IRQ handlers only queue log records (console is drained later)
+			if (regs->number >= igros::i386::IRQ_OFFSET) {
+				const igros::klib::klogDefer defer;
+				// Trace IRQ (formatted on dump only)
+				using igros::operator""_fmt;
+				igros::klib::ktrace(u8"IRQ #%d"_fmt, static_cast<igros::dword_t>(regs->number - igros::i386::IRQ_OFFSET));
+				// Handle IRQ
+				isr(regs);
+			} else {
+				// Handle ISR
+				isr(regs);
+			}
 		} else {
 			// Disable interrupts
 			igros::i386::irq::disable();
@@ -73,6 +85,8 @@ extern "C" {
 			);
 			// Dump registres
 			igros::i386::cpu::dumpRegisters(regs);
+			// Show events before failure
+			igros::klib::ktraceRing::dump();
 			// Hang CPU
 			igros::i386::cpu::halt();
 		}
@@ -21,22 +21,24 @@
 #include <arch/i386/paging.hpp>
 #include <arch/i386/register.hpp>
 #include <arch/i386/cpu.hpp>
+#include <arch/i386/cpuid.hpp>
 
 #include <klib/kalign.hpp>
 #include <klib/kmemory.hpp>
 #include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
+
+#include <mem/direct.hpp>
+#include <mem/tables.hpp>
+#include <mem/vmm.hpp>
 
 
 // Arch-dependent code zone
 namespace igros::i386 {
 
 
-	// Free pages list
-	page_t* paging::mFreePages = reinterpret_cast<page_t*>(&paging::mFreePages);
-
-
 	// Kernel memory map structure
-	const struct PAGE_MAP_t {
+	struct PAGE_MAP_t {
 		const page_t*	phys;
 		const pointer_t	virt;
 	};
@@ -52,16 +54,142 @@ namespace igros::i386 {
 	}};
 
 
+	// Raw page tables entry flags
+	constexpr auto	ENTRY_PRESENT		= static_cast<dword_t>(paging::FLAGS::PRESENT);
+	constexpr auto	ENTRY_WRITABLE		= static_cast<dword_t>(paging::FLAGS::WRITABLE);
+	constexpr auto	ENTRY_USER		= static_cast<dword_t>(paging::FLAGS::USER_ACCESSIBLE);
+	constexpr auto	ENTRY_HUGE		= static_cast<dword_t>(paging::FLAGS::HUGE);
+
+	// Page Global Extension bit in CR4
+	constexpr auto	PAGE_CR4_PGE		= 0x00000080U;
+
+
+	// Get offset mask of memory covered by single entry
+	[[nodiscard]]
+	constexpr dword_t entrySpan(const unsigned shift) noexcept {
+		return (1U << shift) - 1U;
+	}
+
+	// Get raw entry of page directory or page table
+	[[nodiscard]]
+	static inline dword_t& tableEntry(const pointer_t table, const dword_t virt, const unsigned shift) noexcept {
+		return static_cast<dword_t*>(table)[(virt >> shift) & PAGE_ENTRY_MASK];
+	}
+
+	// Get physical address of page table
+	[[nodiscard]]
+	static inline dword_t tablePhys(const pointer_t table) noexcept {
+		return mem::virtToPhys(table);
+	}
+
+	// Get page table entry points to (kernel image shares direct map offset)
+	[[nodiscard]]
+	static inline pointer_t tableVirt(const dword_t entry) noexcept {
+		return mem::physToVirt(entry & PAGE_ENTRY_ADDR_MASK);
+	}
+
+	// Check if single entry of given level fits at current range position
+	[[nodiscard]]
+	static inline bool fits(const dword_t phys, const dword_t virt, const dword_t left, const unsigned shift) noexcept {
+		return (0U == ((phys | virt) & entrySpan(shift))) && (left > entrySpan(shift));
+	}
+
+	// Move range position to next entry of given level
+	static inline void advance(dword_t &phys, dword_t &virt, dword_t &left, const unsigned shift) noexcept {
+		phys	+= 1U << shift;
+		virt	+= 1U << shift;
+		left	-= 1U << shift;
+	}
+
+	// Move virtual range position to next entry boundary of given level
+	static inline void skip(dword_t &virt, dword_t &left, const unsigned shift) noexcept {
+		// Bytes till next entry
+		const auto step	= (1U << shift) - (virt & entrySpan(shift));
+		virt	+= step;
+		left	-= (step < left) ? step : left;
+	}
+
+
+	// Return page table of page directory entry to pool
+	static void release(const dword_t entry) noexcept {
+		// Only present tables are released (4 Mb pages map memory)
+		if (
+			(0U == (entry & ENTRY_PRESENT))	||
+			(0U != (entry & ENTRY_HUGE))
+		) {
+			return;
+		}
+		// Return table to pool
+		paging::deallocate(tableVirt(entry));
+	}
+
+	// Get page table of page directory entry (missing table is made, 4 Mb page is split)
+	[[nodiscard]]
+	static dword_t* descend(dword_t &entry, const dword_t link, paging::batch &pending, const dword_t virt) noexcept {
+		// Entry already points to page table
+		if (
+			(0U != (entry & ENTRY_PRESENT))	&&
+			(0U == (entry & ENTRY_HUGE))
+		) {
+			return static_cast<dword_t*>(tableVirt(entry));
+		}
+		// Make page table (already zeroed by pool)
+		const auto table = static_cast<dword_t*>(paging::allocate());
+		if (nullptr == table) {
+			return nullptr;
+		}
+		// Split 4 Mb page to 4 Kb pages mapping same memory
+		if (0U != (entry & ENTRY_PRESENT)) {
+			// Large page base (low address bits may hold PAT bit)
+			const auto base	= entry & ~entrySpan(PAGE_DIRECTORY_SHIFT);
+			// Large page flags (page table entries have no size bit)
+			const auto bits	= entry & PAGE_MASK & ~ENTRY_HUGE;
+			// Fill new table
+			for (auto i = 0U; i < PAGE_ENTRY_SIZE; i++) {
+				table[i] = (base + (i << PAGE_TABLE_SHIFT)) | bits;
+			}
+			// Drop 4 Mb page translation
+			pending.add(reinterpret_cast<pointer_t>(virt));
+		}
+		// Link table to entry
+		entry = tablePhys(table) | link | (entry & ENTRY_USER);
+		// Return page table
+		return table;
+	}
+
+	// Replace entry of given level with leaf entry (stale translations are queued)
+	static void replace(dword_t &entry, const dword_t value, const dword_t virt, const unsigned shift, paging::batch &pending) noexcept {
+		// Old entry
+		const auto old = entry;
+		// Set new entry
+		entry = value;
+		// Nothing was mapped
+		if (0U == (old & ENTRY_PRESENT)) {
+			return;
+		}
+		// Single page translation
+		if (
+			(PAGE_TABLE_SHIFT == shift)	||
+			(0U != (old & ENTRY_HUGE))
+		) {
+			pending.add(reinterpret_cast<pointer_t>(virt));
+			return;
+		}
+		// Table is returned to pool only after its translations are gone
+		pending.add(reinterpret_cast<pointer_t>(virt), 1U << shift);
+		pending.flush();
+		release(old);
+	}
+
+
 	// Identity map kernel + map higher-half + self-map page directory
 	void paging::init() noexcept {
 
 		// Install exception handler for page fault
 		except::install(except::NUMBER::PAGE_FAULT, paging::exHandler);
 
-		// Get kernel end address
-		const auto kernelEnd = const_cast<byte_t*>(platform::KERNEL_END());
-		// Initialize pages for page tables
-		paging::heap(kernelEnd, PAGE_SIZE << 6);
+		// Initialize page tables pool
+		mem::tables::init();
 
 		// Create flags
 		const auto flags = kflags<FLAGS> {
@@ -72,19 +200,37 @@ namespace igros::i386 {
 		const auto dir = paging::makeDirectory();
 		// Map memory
 		for (const auto &m : PAGE_MAP) {
+			// Kernel half mappings survive address space switch
+			const auto global = reinterpret_cast<dword_t>(m.virt) >= platform::KERNEL_OFFSET();
 			// Map page tables
-			paging::mapTable(dir, m.phys, m.virt, flags);
+			paging::mapTable(dir, m.phys, m.virt, global ? (flags | FLAGS::GLOBAL) : flags);
 		}
 		// Map page directory to itself
-		paging::mapPage(dir, reinterpret_cast<page_t*>(dir), reinterpret_cast<pointer_t>(0xFFFFF000), flags);
+		paging::mapPage(dir, reinterpret_cast<page_t*>(tablePhys(dir)), reinterpret_cast<pointer_t>(0xFFFFF000), flags);
 
 		// Setup page directory
 		// PD address bits ([0 .. 31] in cr3)
 		paging::flush(dir);
-		// Disable PSE
-		paging::disablePSE();
+		// Enable 4 Mb pages if supported (CPUID EDX bit 3), mapRange picks them for big aligned ranges
+		if (
+			cpuidCheck()	&&
+			(0U != (cpuid(cpuidFlags_t::INFO_PROC_VERSION).edx & 0x00000008))
+		) {
+			paging::enablePSE();
+		} else {
+			paging::disablePSE();
+		}
 		// Enable paging
 		paging::enable();
+		// Kernel writes honor read-only pages too (copy-on-write)
+		inCR0(outCR0() | 0x00010000);
+		// Enable global pages if supported (CPUID EDX bit 13)
+		if (
+			cpuidCheck()	&&
+			(0U != (cpuid(cpuidFlags_t::INFO_PROC_VERSION).edx & 0x00002000))
+		) {
+			paging::enablePGE();
+		}
 
 	}
 
@@ -128,70 +274,38 @@ namespace igros::i386 {
 	}
 
 
-	// Initialize paging heap
-	void paging::heap(const pointer_t phys, const std::size_t size) noexcept {
-
-		// Temporary data
-		const auto tempPhys = klib::kalignUp(phys, PAGE_SHIFT);
-		const auto tempSize = size - (reinterpret_cast<std::size_t>(tempPhys) - reinterpret_cast<std::size_t>(phys));
-
-		// Get number of pages
-		const auto numOfPages = (tempSize >> PAGE_SHIFT);
-		// Check input
-		if (0ULL == numOfPages) {
-			return;
-		}
-
-		// Convert to page pointer
-		const auto page = static_cast<page_t*>(tempPhys);
-		// Link first page to free pages list
-		page[0ULL].next = paging::mFreePages;
-		// Create linked list of free pages
-		for (auto i = 1ULL; i < numOfPages; i++) {
-			// Link each next page to previous
-			page[i].next = &page[i - 1ULL];
-		}
-		// Make last page new list head
-		paging::mFreePages = &page[numOfPages - 2ULL];
+	// Enable Page Global Extension
+	void paging::enablePGE() noexcept {
+		// Set PGE bit on in CR4
+		inCR4(outCR4() | PAGE_CR4_PGE);
+	}
 
+	// Disable Page Global Extension
+	void paging::disablePGE() noexcept {
+		// Set PGE bit off in CR4 (flushes global pages too)
+		inCR4(outCR4() & ~PAGE_CR4_PGE);
 	}
 
 
 	// Allocate page
 	[[nodiscard]]
 	pointer_t paging::allocate() noexcept {
-		// Check if pages exist
-		if (paging::mFreePages->next != paging::mFreePages) {
-			// Get free page
-			const auto addr		= paging::mFreePages;
-			// Update free pages list
-			paging::mFreePages	= static_cast<page_t*>(addr->next);
-			// Return pointer to free page
-			return addr;
-		}
-		// Nothing to return
-		return nullptr;
+		// Take zeroed table from pool
+		return mem::tables::alloc();
 	}
 
 	// Deallocate page
 	void paging::deallocate(const pointer_t page) noexcept {
-		// Check alignment
-		if (!klib::kalignCheck(page, PAGE_SHIFT)) {
-			return;
-		}
-		// Deallocate page back to heap free list
-		static_cast<page_t*>(page)->next = paging::mFreePages;
-		paging::mFreePages = static_cast<page_t*>(page);
+		// Return table to pool
+		mem::tables::free(page);
 	}
 
 
 	// Make page directory
 	[[nodiscard]]
 	directory_t* paging::makeDirectory() noexcept {
-		// Allocate page directory
+		// Allocate page directory (already zeroed by pool)
 		const auto dir = static_cast<directory_t*>(paging::allocate());
-		// Zero enties of page directory
-		klib::kmemset(dir, (sizeof(directory_t) >> 2), kflags(FLAGS::CLEAR).value());
 		// Return page directory
 		return dir;
 	}
@@ -199,14 +313,24 @@ namespace igros::i386 {
 	// Make page table
 	[[nodiscard]]
 	table_t* paging::makeTable() noexcept {
-		// Allocate page table
+		// Allocate page table (already zeroed by pool)
 		const auto table = static_cast<table_t*>(paging::allocate());
-		// Zero enties of page table
-		klib::kmemset(table, (sizeof(table_t) >> 2), kflags(FLAGS::CLEAR).value());
 		// Return page table
 		return table;
 	}
 
+	// Destroy page directory (tables are returned to pool, mapped frames are kept)
+	void paging::destroy(directory_t* const dir) noexcept {
+		// Page directory entries
+		const auto table = static_cast<dword_t*>(static_cast<pointer_t>(dir));
+		// Release page tables
+		for (auto i = 0U; i < PAGE_ENTRY_SIZE; i++) {
+			release(table[i]);
+		}
+		// Return page directory to pool
+		paging::deallocate(dir);
+	}
+
 
 	// Check table flags
 	[[nodiscard]]
@@ -218,7 +342,7 @@ namespace igros::i386 {
 			reinterpret_cast<std::size_t>(table)
 		};
 		// Check flags
-		return maskedFlags != (tableFlags & maskedFlags);
+		return maskedFlags == (tableFlags & maskedFlags);
 	}
 
 	// Check page flags
@@ -231,12 +355,42 @@ namespace igros::i386 {
 			reinterpret_cast<std::size_t>(page)
 		};
 		// Check flags
-		return maskedFlags != (pageFlags & maskedFlags);
+		return maskedFlags == (pageFlags & maskedFlags);
 	}
 
 
 	// Map virtual page to physical page (whole page, explicit page directory)
 	void paging::mapTable(directory_t* const dir, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Map 4 Mb range
+		paging::mapRange(dir, phys, virt, 1U << PAGE_DIRECTORY_SHIFT, flags);
+	}
+
+	// Map virtual page to physical page (whole page)
+	void paging::mapTable(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Get pointer to page directory
+		const auto dir = static_cast<directory_t*>(tableVirt(outCR3()));
+		// Map page to curent page directory
+		paging::mapTable(dir, phys, virt, flags);
+	}
+
+
+	// Map virtual page to physical page (explicit page directory)
+	void paging::mapPage(directory_t* const dir, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Map 4 Kb range
+		paging::mapRange(dir, phys, virt, PAGE_SIZE, flags);
+	}
+
+	// Map virtual page to physical page (single page)
+	void paging::mapPage(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Get pointer to page directory
+		const auto dir = static_cast<directory_t*>(tableVirt(outCR3()));
+		// Map page to curent page directory
+		paging::mapPage(dir, phys, virt, flags);
+	}
+
+
+	// Map physical range to virtual range with biggest fitting pages (explicit page directory)
+	bool paging::mapRange(directory_t* const dir, const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending) noexcept {
 
 		// Check alignment
 		if (
@@ -244,102 +398,217 @@ namespace igros::i386 {
 			!klib::kalignCheck(virt, PAGE_SHIFT)
 		) {
 			// Bad align detected
-			return;
+			return false;
 		}
 
-		// Page directory entry index from virtual address
-		const auto dirID = (reinterpret_cast<std::size_t>(virt) >> 22) & 0x3FF;
-
-		// Get page table pointer
-		auto &table = dir->tables[dirID];
-		// Check if page table is present or not
-		if (!paging::checkFlags(table, FLAGS::PRESENT)) {
-			// Create page table
-			table = paging::makeTable();
-		}
+		// Physical and virtual addresses
+		auto physAddr	= reinterpret_cast<dword_t>(phys);
+		auto virtAddr	= reinterpret_cast<dword_t>(virt);
+		// Bytes left to map (whole pages, counted down to survive address space wrap)
+		auto left	= (static_cast<dword_t>(length) + PAGE_MASK) & ~PAGE_MASK;
+
+		// Leaf entries flags (size bit is set per level)
+		const auto leaf	= (flags.value() & (PAGE_MASK & ~ENTRY_HUGE)) | ENTRY_PRESENT;
+		// Tables entries flags (leaf entries restrict access)
+		const auto link	= ENTRY_PRESENT | ENTRY_WRITABLE | (leaf & ENTRY_USER);
+		// 4 Mb pages are only available with PSE enabled
+		const auto large = 0U != (outCR4() & 0x00000010);
+		// Stale translations queue (own one is flushed once on return)
+		batch local;
+		auto &queue	= (nullptr != pending) ? *pending : local;
+
+		// Page table of current position (re-entered on 4 Mb boundaries only)
+		auto table	= static_cast<dword_t*>(nullptr);
+
+		// Map whole range
+		while (0U != left) {
+
+			// Map 4 Mb page if both addresses are aligned and range is big enough
+			if (large && fits(physAddr, virtAddr, left, PAGE_DIRECTORY_SHIFT)) {
+				// Replace page directory entry
+				replace(tableEntry(dir, virtAddr, PAGE_DIRECTORY_SHIFT), physAddr | leaf | ENTRY_HUGE, virtAddr, PAGE_DIRECTORY_SHIFT, queue);
+				// Move to next 4 Mb
+				advance(physAddr, virtAddr, left, PAGE_DIRECTORY_SHIFT);
+				continue;
+			}
+
+			// Enter page table on first step or 4 Mb boundary
+			if ((nullptr == table) || (0U == (virtAddr & entrySpan(PAGE_DIRECTORY_SHIFT)))) {
+				// Get (or make) page table
+				table = descend(tableEntry(dir, virtAddr, PAGE_DIRECTORY_SHIFT), link, queue, virtAddr);
+				if (nullptr == table) {
+					// Out of page tables
+					return false;
+				}
+			}
+
+			// Map 4 Kb page
+			replace(tableEntry(table, virtAddr, PAGE_TABLE_SHIFT), physAddr | leaf, virtAddr, PAGE_TABLE_SHIFT, queue);
+			// Move to next 4 Kb
+			advance(physAddr, virtAddr, left, PAGE_TABLE_SHIFT);
 
-		// Get page pointer and map physical page
-		for (auto i = 0U; i < (sizeof(page_t) >> 2); i++) {
-			// Get phys page ID
-			const auto page	= kflags<FLAGS> {
-				reinterpret_cast<std::size_t>(phys) + (i << PAGE_SHIFT),
-				flags & FLAGS::FLAGS_MASK
-			};
-			// Map page
-			table->pages[i]	= reinterpret_cast<page_t*>(page.value());
 		}
 
-		// Get table flags
-		const auto tableFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(table) & 0x3FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Set new page table flags
-		table = reinterpret_cast<table_t*>(tableFlags.value());
+		// Whole range mapped
+		return true;
 
 	}
 
-	// Map virtual page to physical page (whole page)
-	void paging::mapTable(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+	// Map physical range to virtual range with biggest fitting pages
+	bool paging::mapRange(const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending) noexcept {
 		// Get pointer to page directory
-		const auto dir = reinterpret_cast<directory_t*>(outCR3());
-		// Map page to curent page directory
-		paging::mapTable(dir, phys, virt, flags);
+		const auto dir = static_cast<directory_t*>(tableVirt(outCR3()));
+		// Map range to curent page directory
+		return paging::mapRange(dir, phys, virt, length, flags, pending);
 	}
 
 
-	// Map virtual page to physical page (explicit page directory)
-	void paging::mapPage(directory_t* const dir, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+	// Unmap virtual range (explicit page directory)
+	bool paging::unmapRange(directory_t* const dir, const pointer_t virt, const std::size_t length, batch* const pending) noexcept {
 
 		// Check alignment
-		if (
-			!klib::kalignCheck(phys, PAGE_SHIFT)	||
-			!klib::kalignCheck(virt, PAGE_SHIFT)
-		) {
+		if (!klib::kalignCheck(virt, PAGE_SHIFT)) {
 			// Bad align detected
-			return;
+			return false;
 		}
 
-		// Page directory entry index from virtual address
-		const auto dirID = (reinterpret_cast<std::size_t>(virt) >> PAGE_DIRECTORY_SHIFT) & PAGE_ENTRY_MASK;
-		// Page table entry index from virtual address
-		const auto tabID = (reinterpret_cast<std::size_t>(virt) >> PAGE_TABLE_SHIFT) & PAGE_ENTRY_MASK;
+		// Virtual address
+		auto virtAddr	= reinterpret_cast<dword_t>(virt);
+		// Bytes left to unmap (whole pages)
+		auto left	= (static_cast<dword_t>(length) + PAGE_MASK) & ~PAGE_MASK;
+		// Stale translations queue (own one is flushed once on return)
+		batch local;
+		auto &queue	= (nullptr != pending) ? *pending : local;
+
+		// Unmap whole range
+		while (0U != left) {
+
+			// Get page directory entry
+			auto &dirEntry = tableEntry(dir, virtAddr, PAGE_DIRECTORY_SHIFT);
+			// Nothing mapped - skip whole entry
+			if (0U == (dirEntry & ENTRY_PRESENT)) {
+				skip(virtAddr, left, PAGE_DIRECTORY_SHIFT);
+				continue;
+			}
+			// Drop 4 Mb page covered by range
+			if (
+				(0U != (dirEntry & ENTRY_HUGE))	&&
+				fits(0U, virtAddr, left, PAGE_DIRECTORY_SHIFT)
+			) {
+				dirEntry = 0U;
+				queue.add(reinterpret_cast<pointer_t>(virtAddr));
+				skip(virtAddr, left, PAGE_DIRECTORY_SHIFT);
+				continue;
+			}
+			// Get page table (4 Mb page not covered by range is split)
+			const auto table = descend(dirEntry, ENTRY_PRESENT | ENTRY_WRITABLE, queue, virtAddr);
+			if (nullptr == table) {
+				// Out of page tables
+				return false;
+			}
+			// Drop page
+			auto &entry = tableEntry(table, virtAddr, PAGE_TABLE_SHIFT);
+			if (0U != (entry & ENTRY_PRESENT)) {
+				entry = 0U;
+				queue.add(reinterpret_cast<pointer_t>(virtAddr));
+			}
+			skip(virtAddr, left, PAGE_TABLE_SHIFT);
 
-		// Get page table pointer
-		auto &table = dir->tables[dirID];
-		// Check if page table is present or not
-		if (!paging::checkFlags(table, FLAGS::PRESENT)) {
-			// Create page table
-			table = paging::makeTable();
 		}
 
-		// Get page
-		auto &page = table->pages[tabID];
+		// Whole range unmapped
+		return true;
 
-		// Get table flags
-		const auto tableFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(table) & 0x3FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Get page flags
-		const auto pageFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(page) & 0x3FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
+	}
+
+	// Unmap virtual range
+	bool paging::unmapRange(const pointer_t virt, const std::size_t length, batch* const pending) noexcept {
+		// Get pointer to page directory
+		const auto dir = static_cast<directory_t*>(tableVirt(outCR3()));
+		// Unmap range from curent page directory
+		return paging::unmapRange(dir, virt, length, pending);
+	}
 
-		// Insert page table
-		table	= reinterpret_cast<table_t*>(tableFlags.value());
-		// Insert page pointer
-		page	= reinterpret_cast<page_t*>(pageFlags.value());
 
+	// Invalidate TLB entry of single page
+	void paging::invalidate(const pointer_t virt) noexcept {
+		invalidatePage(virt);
 	}
 
-	// Map virtual page to physical page (single page)
-	void paging::mapPage(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
-		// Get pointer to page directory
-		const auto dir = reinterpret_cast<directory_t*>(outCR3());
-		// Map page to curent page directory
-		paging::mapPage(dir, phys, virt, flags);
+	// Invalidate TLB entries of range (whole TLB is flushed for big ranges)
+	void paging::invalidateRange(const pointer_t virt, const std::size_t length) noexcept {
+		// Queue range (flushed on return)
+		batch pending;
+		pending.add(virt, length);
+	}
+
+	// Flush whole TLB (global entries too if requested)
+	void paging::flushTLB(const bool global) noexcept {
+		// Current CR4 value
+		const auto cr4 = outCR4();
+		// Toggling PGE drops global entries too
+		if (global && (0U != (cr4 & PAGE_CR4_PGE))) {
+			inCR4(cr4 & ~PAGE_CR4_PGE);
+			inCR4(cr4);
+			return;
+		}
+		// Reload CR3 (non-global entries)
+		inCR3(outCR3());
+	}
+
+
+	// D-tor (pending invalidations are flushed)
+	paging::batch::~batch() noexcept {
+		flush();
+	}
+
+	// Queue single TLB entry invalidation
+	void paging::batch::add(const pointer_t virt) noexcept {
+		// Kernel half mappings are global
+		mGlobal = mGlobal || (reinterpret_cast<dword_t>(virt) >= platform::KERNEL_OFFSET());
+		// Whole TLB is flushed anyway
+		if (mFull) {
+			return;
+		}
+		// Too many pages - flush whole TLB
+		if (mCount >= PAGE_INVALIDATE_LIMIT) {
+			mFull = true;
+			return;
+		}
+		// Queue page
+		mPages[mCount++] = virt;
+	}
+
+	// Queue range TLB entries invalidation
+	void paging::batch::add(const pointer_t virt, const std::size_t length) noexcept {
+		// Range pages count
+		const auto count = (static_cast<dword_t>(length) + PAGE_MASK) >> PAGE_SHIFT;
+		// Too many pages - flush whole TLB
+		if (count > (PAGE_INVALIDATE_LIMIT - mCount)) {
+			mGlobal	= mGlobal || ((reinterpret_cast<dword_t>(virt) + length - 1U) >= platform::KERNEL_OFFSET());
+			mFull	= true;
+			return;
+		}
+		// Queue range pages
+		for (auto i = 0U; i < count; i++) {
+			add(static_cast<byte_t*>(virt) + (i << PAGE_SHIFT));
+		}
+	}
+
+	// Flush pending invalidations
+	void paging::batch::flush() noexcept {
+		// Flush whole TLB or single pages
+		if (mFull) {
+			paging::flushTLB(mGlobal);
+		} else {
+			for (auto i = 0U; i < mCount; i++) {
+				paging::invalidate(mPages[i]);
+			}
+		}
+		// Nothing pending
+		mCount	= 0U;
+		mFull	= false;
+		mGlobal	= false;
 	}
 
 
@@ -347,47 +616,85 @@ namespace igros::i386 {
 	[[nodiscard]]
 	pointer_t paging::translate(const pointer_t virt) noexcept {
 
-		// Page directory entry index from virtual address
-		const auto dirID	= (reinterpret_cast<std::size_t>(virt) >> PAGE_DIRECTORY_SHIFT) & PAGE_ENTRY_MASK;
-		// Page table entry index from virtual address
-		const auto tabID	= (reinterpret_cast<std::size_t>(virt) >> PAGE_TABLE_SHIFT) & PAGE_ENTRY_MASK;
-
+		// Virtual address
+		const auto virtAddr	= reinterpret_cast<dword_t>(virt);
 		// Get pointer to page directory
-		const auto dir		= reinterpret_cast<const directory_t*>(outCR3());
+		const auto dir		= tableVirt(outCR3());
 
-		// Get page table pointer
-		const auto table = dir->tables[dirID];
+		// Get page directory entry
+		const auto dirEntry = tableEntry(dir, virtAddr, PAGE_DIRECTORY_SHIFT);
 		// Check if page table is present or not
-		if (!paging::checkFlags(table, FLAGS::PRESENT)) {
+		if (0U == (dirEntry & ENTRY_PRESENT)) {
 			// Page or table is not present
 			return nullptr;
 		}
+		// Check if entry is 4 Mb page
+		if (0U != (dirEntry & ENTRY_HUGE)) {
+			// Page physical address and offset inside page
+			return reinterpret_cast<pointer_t>((dirEntry & ~entrySpan(PAGE_DIRECTORY_SHIFT)) | (virtAddr & entrySpan(PAGE_DIRECTORY_SHIFT)));
+		}
 
-		// Get page pointer
-		const auto page = table->pages[tabID];
-		// Check if page table is present or not
-		if (!paging::checkFlags(page, FLAGS::PRESENT)) {
+		// Get page table entry
+		const auto tabEntry = tableEntry(tableVirt(dirEntry), virtAddr, PAGE_TABLE_SHIFT);
+		// Check if page is present or not
+		if (0U == (tabEntry & ENTRY_PRESENT)) {
 			// Page or table is not present
 			return nullptr;
 		}
 
-		// Get physical address of page from page table (20 MSB)
-		const auto address	= kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(page)
-		};
-		// Get physical offset in psge from virtual address`s (12 LSB)
-		const auto offset	= kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(virt)
-		};
-		// Return physical address
-		return reinterpret_cast<pointer_t>(((address & FLAGS::PHYS_ADDR_MASK) | (offset & FLAGS::FLAGS_MASK)).value());
+		// Page physical address and offset inside page
+		return reinterpret_cast<pointer_t>((tabEntry & PAGE_ENTRY_ADDR_MASK) | (virtAddr & PAGE_MASK));
 
 	}
 
 
+	// Get active page directory
+	[[nodiscard]]
+	directory_t* paging::root() noexcept {
+		// Page directory from CR3
+		return static_cast<directory_t*>(tableVirt(outCR3()));
+	}
+
+
+	// Get 4 Kb page entry of virtual address (explicit page directory, nullptr if not mapped by 4 Kb page)
+	[[nodiscard]]
+	dword_t* paging::leaf(directory_t* const dir, const pointer_t virt) noexcept {
+		// Virtual address
+		const auto virtAddr	= reinterpret_cast<dword_t>(virt);
+		// Get page directory entry
+		const auto dirEntry	= tableEntry(dir, virtAddr, PAGE_DIRECTORY_SHIFT);
+		// Page table is not present or 4 Mb page maps address
+		if (
+			(0U == (dirEntry & ENTRY_PRESENT))	||
+			(0U != (dirEntry & ENTRY_HUGE))
+		) {
+			return nullptr;
+		}
+		// Page table entry (may be not present)
+		return &tableEntry(tableVirt(dirEntry), virtAddr, PAGE_TABLE_SHIFT);
+	}
+
+	// Get 4 Kb page entry of virtual address (nullptr if not mapped by 4 Kb page)
+	[[nodiscard]]
+	dword_t* paging::leaf(const pointer_t virt) noexcept {
+		// Get pointer to page directory
+		const auto dir = static_cast<directory_t*>(tableVirt(outCR3()));
+		// Look up curent page directory
+		return paging::leaf(dir, virt);
+	}
+
+
 	// Page Fault Exception handler
 	void paging::exHandler(const register_t* regs) noexcept {
 
+		// Trace fault (formatted on dump only)
+		klib::ktrace(u8"Page fault at %p (error %x)"_fmt, reinterpret_cast<const pointer_t>(outCR2()), static_cast<dword_t>(regs->param));
+
+		// Resolve demand paging fault (error code: bit 0 - present, bit 1 - write)
+		if (mem::vmm::fault(reinterpret_cast<const pointer_t>(outCR2()), 0U != (regs->param & 0x02), 0U != (regs->param & 0x01))) {
+			return;
+		}
+
 		// Disable IRQ
 		irq::disable();
 
@@ -410,6 +717,9 @@ namespace igros::i386 {
 			((regs->param & 0x01) == 0U) ? u8"PRESENT"		: u8"PRIVILEGED"
 		);
 
+		// Show events before failure
+		klib::ktraceRing::dump();
+
 		// Hang here
 		cpuHalt();
 
@@ -419,7 +729,7 @@ namespace igros::i386 {
 	// Set page directory
 	inline void paging::flush(const directory_t* const dir) noexcept {
 		// Set page directory address to CR3
-		inCR3(reinterpret_cast<std::uintptr_t>(dir) & 0x3FFFFFFF);
+		inCR3(mem::virtToPhys(dir));
 	}
 
 
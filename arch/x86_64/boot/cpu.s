@@ -16,6 +16,9 @@
 .section .text
 .balign 8
 .global cpuHalt			# halt CPU
+.global cpuTimestamp		# read time-stamp counter
+.global cpuIdle			# wait for interrupt
+.global cpuZeroPage		# zero page bypassing cache
 
 
 # Halt CPU
@@ -24,3 +27,31 @@ cpuHalt:
 	hlt
 	jmp 1b;
 
+# Read time-stamp counter
+cpuTimestamp:
+	rdtsc				# EDX:EAX = TSC
+	shlq	$32, %rdx
+	orq	%rdx, %rax		# RAX = EDX:EAX
+	retq
+
+# Enable interrupts and wait for interrupt (sti holds interrupts until hlt)
+cpuIdle:
+	sti
+	hlt
+	retq
+
+# Zero page bypassing cache (non-temporal stores)
+cpuZeroPage:
+	xorl	%eax, %eax		# Zero value
+	movl	$0x80, %ecx		# Page size in 32 byte steps
+1:
+	movnti	%rax, 0x00(%rdi)
+	movnti	%rax, 0x08(%rdi)
+	movnti	%rax, 0x10(%rdi)
+	movnti	%rax, 0x18(%rdi)
+	addq	$0x20, %rdi
+	decl	%ecx
+	jnz	1b
+	sfence				# Order non-temporal stores
+	retq
+
@@ -12,7 +12,7 @@
 
 
 
-.set	CPUID_STACK_SHIFT,	0x00000020	# CPUID stack 32-bit shift for 64-bit push
+.set	CPUID_REG_SHIFT,	0x00000020	# CPUID register 32-bit shift for 64-bit return
 
 
 .code64
@@ -24,14 +24,16 @@
 
 # Execute CPUID with reauired flags
 cpuid:
-	cld					# Clear direction flag
+	pushq	%rbx				# Save RBX (callee-saved, clobbered by CPUID)
 	movl	%edi, %eax			# Put flag to EAX register
+	xorl	%ecx, %ecx			# Use subleaf 0
 	cpuid					# Execute CPUID
-	shlq	$CPUID_STACK_SHIFT, %rax
-	orq	%rbx, %rax
-	pushq	%rax
-	shlq	$CPUID_STACK_SHIFT, %rcx
-	orq	%rdx, %rcx
-	pushq	%rcx
-	retq					# Return structure of CPUID results
+	movl	%eax, %eax			# Zero-extend EAX
+	shlq	$CPUID_REG_SHIFT, %rbx
+	orq	%rbx, %rax			# RAX = EBX:EAX
+	movl	%ecx, %ecx			# Zero-extend ECX
+	shlq	$CPUID_REG_SHIFT, %rdx
+	orq	%rcx, %rdx			# RDX = EDX:ECX
+	popq	%rbx				# Restore RBX
+	retq					# Return structure of CPUID results (RAX:RDX)
 
@@ -23,6 +23,7 @@
 .global inCR0			# Write CR0 register
 .global inCR3			# Write CR3 register
 .global inCR4			# Write CR4 register
+.global invalidatePage		# Invalidate TLB entry of page
 
 
 # Read CR0 register
@@ -68,3 +69,9 @@ inCR4:
 	movq	%rdi, %cr4
 	retq
 
+
+# Invalidate TLB entry of page
+invalidatePage:
+	invlpg	(%rdi)
+	retq
+
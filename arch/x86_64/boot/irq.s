@@ -37,6 +37,8 @@
 
 .global irqEnable			# Interrupts
 .global irqDisable			# No interrupts
+.global irqSave				# Save state and disable interrupts
+.global irqRestore			# Restore interrupts state
 
 
 # IRQ 0
@@ -164,3 +166,16 @@ irqDisable:
 	cli				# Disable interrupts
 	retq
 
+# Save interrupts state and disable interrupts
+irqSave:
+	pushfq				# Save flags
+	popq	%rax			# Return flags
+	cli				# Disable interrupts
+	retq
+
+# Restore interrupts state
+irqRestore:
+	pushq	%rdi			# Saved flags
+	popfq				# Restore flags
+	retq
+
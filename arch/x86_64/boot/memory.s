@@ -0,0 +1,141 @@
+################################################################
+#
+#	Memory fill and copy routines
+#
+#	File:	memory.s
+#	Date:	16 Oct 2026
+#
+#	Copyright (c) 2017 - 2021, Igor Baklykov
+#	All rights reserved.
+#
+#
+
+
+.set	MEMORY_BYTE_BROADCAST,	0x0101010101010101	# Byte to quad broadcast multiplier
+
+
+.code64
+
+.section .text
+.balign 8
+
+.global memorySetRep		# Fill memory with rep stosq
+.global memorySetERMS		# Fill memory with rep stosb
+.global memorySetSSE2		# Fill memory with SSE2 stores
+.global memoryCopyRep		# Copy memory with rep movsq
+.global memoryCopyERMS		# Copy memory with rep movsb
+.global memoryCopySSE2		# Copy memory with SSE2 loads and stores
+.global memoryMoveBack		# Copy memory backwards with std; rep movsq
+
+
+# Fill memory with rep stosq (RDI - destination, RSI - size, DL - value)
+memorySetRep:
+	cld				# Clear direction flag
+	movzbl	%dl, %eax
+	movabsq	$MEMORY_BYTE_BROADCAST, %rdx
+	imulq	%rdx, %rax		# Broadcast byte to quad
+	movq	%rsi, %rcx
+	shrq	$3, %rcx		# Quads count
+	rep	stosq
+	movl	%esi, %ecx
+	andl	$7, %ecx		# Tail bytes count
+	rep	stosb
+	retq
+
+# Fill memory with rep stosb (RDI - destination, RSI - size, DL - value)
+memorySetERMS:
+	cld				# Clear direction flag
+	movl	%edx, %eax
+	movq	%rsi, %rcx
+	rep	stosb
+	retq
+
+# Fill memory with SSE2 stores (RDI - destination, RSI - size (16 bytes at least), DL - value)
+memorySetSSE2:
+	subq	$0x10, %rsp
+	movdqu	%xmm0, (%rsp)		# Save XMM0
+	movzbl	%dl, %eax
+	movabsq	$MEMORY_BYTE_BROADCAST, %rdx
+	imulq	%rdx, %rax		# Broadcast byte to quad
+	movq	%rax, %xmm0
+	punpcklqdq	%xmm0, %xmm0	# Broadcast quad to 16 bytes
+	leaq	-0x10(%rdi, %rsi), %rcx	# Last 16 bytes
+	movdqu	%xmm0, (%rcx)		# Unaligned tail
+	movdqu	%xmm0, (%rdi)		# Unaligned head
+	addq	$0x10, %rdi
+	andq	$-0x10, %rdi		# Aligned body start
+1:
+	cmpq	%rcx, %rdi
+	jae	2f
+	movdqa	%xmm0, (%rdi)
+	addq	$0x10, %rdi
+	jmp	1b
+2:
+	movdqu	(%rsp), %xmm0		# Restore XMM0
+	addq	$0x10, %rsp
+	retq
+
+
+# Copy memory with rep movsq (RDI - destination, RSI - source, RDX - size)
+memoryCopyRep:
+	cld				# Clear direction flag
+	movq	%rdx, %rcx
+	shrq	$3, %rcx		# Quads count
+	rep	movsq
+	movl	%edx, %ecx
+	andl	$7, %ecx		# Tail bytes count
+	rep	movsb
+	retq
+
+# Copy memory with rep movsb (RDI - destination, RSI - source, RDX - size)
+memoryCopyERMS:
+	cld				# Clear direction flag
+	movq	%rdx, %rcx
+	rep	movsb
+	retq
+
+# Copy memory with SSE2 loads and stores (RDI - destination, RSI - source, RDX - size (16 bytes at least))
+memoryCopySSE2:
+	subq	$0x20, %rsp
+	movdqu	%xmm0, 0x00(%rsp)	# Save XMM0
+	movdqu	%xmm1, 0x10(%rsp)	# Save XMM1
+	movdqu	-0x10(%rsi, %rdx), %xmm1	# Unaligned tail
+	movdqu	(%rsi), %xmm0		# Unaligned head
+	leaq	-0x10(%rdi, %rdx), %rcx	# Last 16 bytes
+	movdqu	%xmm1, (%rcx)
+	movdqu	%xmm0, (%rdi)
+	movq	%rdi, %rax
+	addq	$0x10, %rdi
+	andq	$-0x10, %rdi		# Aligned destination body start
+	subq	%rdi, %rax
+	subq	%rax, %rsi		# Source moves along
+1:
+	cmpq	%rcx, %rdi
+	jae	2f
+	movdqu	(%rsi), %xmm0
+	movdqa	%xmm0, (%rdi)
+	addq	$0x10, %rsi
+	addq	$0x10, %rdi
+	jmp	1b
+2:
+	movdqu	0x10(%rsp), %xmm1	# Restore XMM1
+	movdqu	0x00(%rsp), %xmm0	# Restore XMM0
+	addq	$0x20, %rsp
+	retq
+
+
+# Copy memory backwards, safe for destination above overlapping source (RDI - destination, RSI - source, RDX - size)
+memoryMoveBack:
+	leaq	-8(%rsi, %rdx), %rsi	# Last source quad
+	leaq	-8(%rdi, %rdx), %rdi	# Last destination quad
+	movq	%rdx, %rcx
+	shrq	$3, %rcx		# Quads count
+	std				# Set direction flag (move down)
+	rep	movsq
+	addq	$7, %rsi		# Last source byte left
+	addq	$7, %rdi		# Last destination byte left
+	movl	%edx, %ecx
+	andl	$7, %ecx		# Head bytes count
+	rep	movsb
+	cld				# Clear direction flag
+	retq
@@ -17,6 +17,7 @@
 #include <arch/x86_64/cpu.hpp>
 
 #include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
 
 
 // x86_64 platform
@@ -59,6 +60,8 @@ namespace igros::x86_64 {
 		);
 		// Dump registres
 		cpu::dumpRegisters(regs);
+		// Show events before failure
+		klib::ktraceRing::dump();
 		// Hang CPU
 		cpu::halt();
 	}
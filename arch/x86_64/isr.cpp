@@ -19,7 +19,9 @@
 #include <arch/x86_64/io.hpp>
 #include <arch/x86_64/cpu.hpp>
 
+#include <klib/klog.hpp>
 #include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
 
 
 // x86_64 namespace
@@ -58,8 +60,18 @@ extern "C" {
 	void isrHandler(const igros::x86_64::register_t* regs) noexcept {
 		// Check if irq/exception handler installed
 		if (const auto isr = igros::x86_64::isrList[regs->number]; nullptr != isr) {
-			// Handle ISR
-			isr(regs);
+			// IRQ handlers only queue log records (console is drained later)
+			if (regs->number >= igros::x86_64::IRQ_OFFSET) {
+				const igros::klib::klogDefer defer;
+				// Trace IRQ (formatted on dump only)
+				using igros::operator""_fmt;
+				igros::klib::ktrace(u8"IRQ #%d"_fmt, static_cast<igros::dword_t>(regs->number - igros::x86_64::IRQ_OFFSET));
+				// Handle IRQ
+				isr(regs);
+			} else {
+				// Handle ISR
+				isr(regs);
+			}
 		} else {
 			// Disable interrupts
 			igros::x86_64::irq::disable();
@@ -70,6 +82,8 @@ extern "C" {
 				((regs->number >= igros::x86_64::IRQ_OFFSET) ? u8"IRQ" : u8"EXCEPTION"),
 				((regs->number >= igros::x86_64::IRQ_OFFSET) ? (regs->number - igros::x86_64::IRQ_OFFSET) : regs->number)
 			);
+			// Show events before failure
+			igros::klib::ktraceRing::dump();
 			// Hang CPU
 			igros::x86_64::cpu::halt();
 		}
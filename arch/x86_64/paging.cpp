@@ -23,22 +23,25 @@
 #include <arch/x86_64/paging.hpp>
 #include <arch/x86_64/register.hpp>
 #include <arch/x86_64/cpu.hpp>
+#include <arch/x86_64/cpuid.hpp>
+#include <arch/x86_64/pcid.hpp>
 
 #include <klib/kalign.hpp>
 #include <klib/kmemory.hpp>
 #include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
+
+#include <mem/direct.hpp>
+#include <mem/tables.hpp>
+#include <mem/vmm.hpp>
 
 
 // x86_64 namespace
 namespace igros::x86_64 {
 
 
-	// Free pages list
-	table_t* paging::mFreePages = reinterpret_cast<table_t*>(&paging::mFreePages);
-
-
 	// Kernel memory map structure
-	const struct PAGE_MAP_t {
+	struct PAGE_MAP_t {
 		const page_t*	phys;
 		const pointer_t	virt;
 	};
@@ -58,16 +61,168 @@ namespace igros::x86_64 {
 	}};
 
 
+	// Page tables entry index bits per level
+	constexpr auto	PAGE_LEVEL_SHIFT	= 9U;
+	// Kernel half of address space (global mappings)
+	constexpr auto	PAGE_KERNEL_SPACE	= 0xFFFF800000000000ULL;
+	// Page Global Extension bit in CR4
+	constexpr auto	PAGE_CR4_PGE		= 0x0000000000000080ULL;
+
+	// Raw page tables entry flags
+	constexpr auto	ENTRY_PRESENT		= static_cast<quad_t>(paging::FLAGS::PRESENT);
+	constexpr auto	ENTRY_WRITABLE		= static_cast<quad_t>(paging::FLAGS::WRITABLE);
+	constexpr auto	ENTRY_USER		= static_cast<quad_t>(paging::FLAGS::USER_ACCESSIBLE);
+	constexpr auto	ENTRY_HUGE		= static_cast<quad_t>(paging::FLAGS::HUGE);
+	constexpr auto	ENTRY_NX		= static_cast<quad_t>(paging::FLAGS::NON_EXECUTABLE);
+
+
+	// Get offset mask of memory covered by single entry
+	[[nodiscard]]
+	constexpr quad_t entrySpan(const unsigned shift) noexcept {
+		return (1ULL << shift) - 1ULL;
+	}
+
+	// Get raw entry of any level table
+	[[nodiscard]]
+	static inline quad_t& tableEntry(const pointer_t table, const quad_t virt, const unsigned shift) noexcept {
+		return static_cast<quad_t*>(table)[(virt >> shift) & PAGE_ENTRY_MASK];
+	}
+
+	// Get physical address of page table
+	[[nodiscard]]
+	static inline quad_t tablePhys(const pointer_t table) noexcept {
+		return mem::virtToPhys(table);
+	}
+
+	// Get page table entry points to (bootstrap tables are reached via kernel image before direct map exists)
+	[[nodiscard]]
+	static inline pointer_t tableVirt(const quad_t entry) noexcept {
+		// Table physical address
+		const auto phys		= entry & PAGE_ENTRY_ADDR_MASK;
+		// Kernel image physical bounds
+		const auto first	= reinterpret_cast<quad_t>(platform::KERNEL_START()) - platform::KERNEL_OFFSET();
+		const auto last		= reinterpret_cast<quad_t>(platform::KERNEL_END()) - platform::KERNEL_OFFSET();
+		// Kernel image tables or direct map tables
+		return ((phys >= first) && (phys < last)) ? reinterpret_cast<pointer_t>(phys + platform::KERNEL_OFFSET()) : mem::physToVirt(phys);
+	}
+
+	// Check if single entry of given level fits at current range position
+	[[nodiscard]]
+	static inline bool fits(const quad_t phys, const quad_t virt, const quad_t left, const unsigned shift) noexcept {
+		return (0ULL == ((phys | virt) & entrySpan(shift))) && (left > entrySpan(shift));
+	}
+
+	// Move range position to next entry of given level
+	static inline void advance(quad_t &phys, quad_t &virt, quad_t &left, const unsigned shift) noexcept {
+		phys	+= 1ULL << shift;
+		virt	+= 1ULL << shift;
+		left	-= 1ULL << shift;
+	}
+
+	// Move virtual range position to next entry boundary of given level
+	static inline void skip(quad_t &virt, quad_t &left, const unsigned shift) noexcept {
+		// Bytes till next entry
+		const auto step	= (1ULL << shift) - (virt & entrySpan(shift));
+		virt	+= step;
+		left	-= (step < left) ? step : left;
+	}
+
+
+	// Check if CPU supports 1 Gb pages
+	[[nodiscard]]
+	static bool hasGigabytePages() noexcept {
+		// CPUID extended info EDX bit 26 (Page1GB)
+		return 0U != (cpuid(cpuidFlags_t::INFO_EXTENDED).edx & 0x04000000);
+	}
+
+	// Return tables of entry to pool (entry covers 512 entries of given shift)
+	static void release(const quad_t entry, const unsigned shift) noexcept {
+		// Only present tables are released (huge pages map memory)
+		if (
+			(0ULL == (entry & ENTRY_PRESENT))	||
+			(0ULL != (entry & ENTRY_HUGE))
+		) {
+			return;
+		}
+		// Get next level table
+		const auto table = static_cast<quad_t*>(tableVirt(entry));
+		// Release lower level tables (page table entries map memory)
+		if (PAGE_TABLE_SHIFT != shift) {
+			for (auto i = 0ULL; i < PAGE_TABLE_SIZE; i++) {
+				release(table[i], shift - PAGE_LEVEL_SHIFT);
+			}
+		}
+		// Return table to pool
+		paging::deallocate(table);
+	}
+
+	// Get next level table of entry (missing table is made, huge page is split)
+	[[nodiscard]]
+	static pointer_t descend(quad_t &entry, const unsigned shift, const quad_t link, paging::batch &pending, const quad_t virt) noexcept {
+		// Entry already points to next level table
+		if (
+			(0ULL != (entry & ENTRY_PRESENT))	&&
+			(0ULL == (entry & ENTRY_HUGE))
+		) {
+			return tableVirt(entry);
+		}
+		// Make next level table (already zeroed by pool)
+		const auto table = static_cast<quad_t*>(paging::allocate());
+		if (nullptr == table) {
+			return nullptr;
+		}
+		// Split huge page to smaller pages mapping same memory
+		if (0ULL != (entry & ENTRY_PRESENT)) {
+			// Huge page base (low address bits may hold PAT bit)
+			const auto base	= entry & PAGE_ENTRY_ADDR_MASK & ~entrySpan(shift + PAGE_LEVEL_SHIFT);
+			// Huge page flags (page table entries have no size bit)
+			const auto bits	= entry & (PAGE_MASK | ENTRY_NX) & ~((PAGE_TABLE_SHIFT == shift) ? ENTRY_HUGE : 0ULL);
+			// Fill new table
+			for (auto i = 0ULL; i < PAGE_TABLE_SIZE; i++) {
+				table[i] = (base + (i << shift)) | bits;
+			}
+			// Drop huge page translation
+			pending.add(reinterpret_cast<pointer_t>(virt));
+		}
+		// Link table to entry
+		entry = tablePhys(table) | link | (entry & ENTRY_USER);
+		// Return next level table
+		return table;
+	}
+
+	// Replace entry of given level with leaf entry (stale translations are queued)
+	static void replace(quad_t &entry, const quad_t value, const quad_t virt, const unsigned shift, paging::batch &pending) noexcept {
+		// Old entry
+		const auto old = entry;
+		// Set new entry
+		entry = value;
+		// Nothing was mapped
+		if (0ULL == (old & ENTRY_PRESENT)) {
+			return;
+		}
+		// Single page translation
+		if (
+			(PAGE_TABLE_SHIFT == shift)	||
+			(0ULL != (old & ENTRY_HUGE))
+		) {
+			pending.add(reinterpret_cast<pointer_t>(virt));
+			return;
+		}
+		// Tables are returned to pool only after their translations are gone
+		pending.add(reinterpret_cast<pointer_t>(virt), 1ULL << shift);
+		pending.flush();
+		release(old, shift - PAGE_LEVEL_SHIFT);
+	}
+
+
 	// Setup paging
 	void paging::init() noexcept {
 
 		// Install exception handler for page fault
 		except::install(except::NUMBER::PAGE_FAULT, paging::exHandler);
 
-		// Get kernel end address
-		const auto kernelEnd = const_cast<byte_t*>(platform::KERNEL_END());
-		// Initialize pages for page tables
-		paging::heap(kernelEnd, PAGE_SIZE << 6);
+		// Initialize page tables pool
+		mem::tables::init();
 
 		// Create flags
 		constexpr auto flags = kflags<FLAGS> {
@@ -78,8 +233,10 @@ namespace igros::x86_64 {
 		const auto pml4 = paging::makePML4();
 		// Map memory
 		for (const auto &m : PAGE_MAP) {
+			// Kernel half mappings survive address space switch
+			const auto global = reinterpret_cast<quad_t>(m.virt) >= PAGE_KERNEL_SPACE;
 			// Map page tables
-			paging::mapTable(pml4, m.phys, m.virt, flags);
+			paging::mapTable(pml4, m.phys, m.virt, global ? (flags | FLAGS::GLOBAL) : flags);
 		}
 		// Map page directory to itself
 		//paging::mapTable(pml4, reinterpret_cast<page_t*>(pml4), reinterpret_cast<pointer_t>(0xFFFFFFFFFFFFF000), flags);
@@ -91,6 +248,14 @@ namespace igros::x86_64 {
 		paging::enablePAE();
 		// Enable paging
 		paging::enable();
+		// Kernel writes honor read-only pages too (copy-on-write)
+		inCR0(outCR0() | 0x0000000000010000);
+		// Enable global pages if supported (CPUID EDX bit 13)
+		if (0U != (cpuid(cpuidFlags_t::INFO_PROC_VERSION).edx & 0x00002000)) {
+			paging::enablePGE();
+		}
+		// Enable tagged TLB entries if supported
+		pcid::init();
 
 	}
 
@@ -121,70 +286,38 @@ namespace igros::x86_64 {
 	}
 
 
-	// Initialize paging heap
-	void paging::heap(const pointer_t phys, const std::size_t size) noexcept {
-
-		// Temporary data
-		const auto tempPhys = klib::kalignUp(phys, PAGE_SHIFT);
-		const auto tempSize = size - (reinterpret_cast<std::size_t>(tempPhys) - reinterpret_cast<std::size_t>(phys));
-
-		// Get number of pages
-		const auto numOfPages = (tempSize >> PAGE_SHIFT);
-		// Check input
-		if (0ULL == numOfPages) {
-			return;
-		}
-
-		// Convert to page pointer
-		const auto page = static_cast<table_t*>(tempPhys);
-		// Link first page to free pages list
-		page[0ULL].next = paging::mFreePages;
-		// Create linked list of free pages
-		for (auto i = 1ULL; i < numOfPages; i++) {
-			// Link each next page to previous
-			page[i].next = &page[i - 1ULL];
-		}
-		// Make last page new list head
-		paging::mFreePages = &page[numOfPages - 2ULL];
+	// Enable Page Global Extension
+	void paging::enablePGE() noexcept {
+		// Set PGE bit on in CR4
+		inCR4(outCR4() | PAGE_CR4_PGE);
+	}
 
+	// Disable Page Global Extension
+	void paging::disablePGE() noexcept {
+		// Set PGE bit off in CR4 (flushes global pages too)
+		inCR4(outCR4() & ~PAGE_CR4_PGE);
 	}
 
 
 	// Allocate page
 	[[nodiscard]]
 	pointer_t paging::allocate() noexcept {
-		// Check if pages exist
-		if (paging::mFreePages->next != paging::mFreePages) {
-			// Get free page
-			const auto addr		= paging::mFreePages;
-			// Update free pages list
-			paging::mFreePages	= static_cast<table_t*>(addr->next);
-			// Return pointer to free page
-			return reinterpret_cast<page_t*>(addr);
-		}
-		// Nothing to return
-		return nullptr;
+		// Take zeroed table from pool
+		return mem::tables::alloc();
 	}
 
 	// Deallocate page
 	void paging::deallocate(const pointer_t page) noexcept {
-		// Check alignment
-		if (!klib::kalignCheck(page, PAGE_SHIFT)) {
-			return;
-		}
-		// Deallocate page back to heap free list
-		static_cast<table_t*>(page)->next = paging::mFreePages;
-		paging::mFreePages = static_cast<table_t*>(page);
+		// Return table to pool
+		mem::tables::free(page);
 	}
 
 
 	// Make PML4
 	[[nodiscard]]
 	pml4_t* paging::makePML4() noexcept {
-		// Allocate page map level 4
+		// Allocate page map level 4 (already zeroed by pool)
 		const auto pml4 = static_cast<pml4_t*>(paging::allocate());
-		// Zero enties of page map level 4
-		klib::kmemset(pml4, (sizeof(pml4_t) >> 3), kflags(FLAGS::CLEAR).value());
 		// Return page map level 4
 		return pml4;
 	}
@@ -192,10 +325,8 @@ namespace igros::x86_64 {
 	// Make page directory pointer
 	[[nodiscard]]
 	directoryPointer_t* paging::makeDirectoryPointer() noexcept {
-		// Allocate page directory pointer
+		// Allocate page directory pointer (already zeroed by pool)
 		const auto dirPtr = static_cast<directoryPointer_t*>(paging::allocate());
-		// Zero enties of page directory pointer
-		klib::kmemset(dirPtr, (sizeof(directoryPointer_t) >> 3), kflags(FLAGS::CLEAR).value());
 		// Return page directory pointer
 		return dirPtr;
 	}
@@ -203,10 +334,8 @@ namespace igros::x86_64 {
 	// Make page directory
 	[[nodiscard]]
 	directory_t* paging::makeDirectory() noexcept {
-		// Allocate page directory
+		// Allocate page directory (already zeroed by pool)
 		const auto dir = static_cast<directory_t*>(paging::allocate());
-		// Zero enties of page directory
-		klib::kmemset(dir, (sizeof(directory_t) >> 3), kflags(FLAGS::CLEAR).value());
 		// Return page directory
 		return dir;
 	}
@@ -214,14 +343,24 @@ namespace igros::x86_64 {
 	// Make page table
 	[[nodiscard]]
 	table_t* paging::makeTable() noexcept {
-		// Allocate page table
+		// Allocate page table (already zeroed by pool)
 		const auto table = static_cast<table_t*>(paging::allocate());
-		// Zero enties of page table
-		klib::kmemset(table, (sizeof(table_t) >> 3), kflags(FLAGS::CLEAR).value());
 		// Return page table
 		return table;
 	}
 
+	// Destroy PML4 (tables are returned to pool, mapped frames are kept)
+	void paging::destroy(pml4_t* const pml4) noexcept {
+		// Page map level 4 entries
+		const auto table = static_cast<quad_t*>(static_cast<pointer_t>(pml4));
+		// Release lower level tables
+		for (auto i = 0ULL; i < PAGE_TABLE_SIZE; i++) {
+			release(table[i], PAGE_DIRECTORY_POINTER_SHIFT);
+		}
+		// Return page map level 4 to pool
+		paging::deallocate(pml4);
+	}
+
 
 	// Check directory pointer flags
 	[[nodiscard]]
@@ -233,7 +372,7 @@ namespace igros::x86_64 {
 			reinterpret_cast<std::size_t>(dirPtr)
 		};
 		// Check flags
-		return maskedFlags != (dirPtrFlags & maskedFlags);
+		return maskedFlags == (dirPtrFlags & maskedFlags);
 	}
 
 	// Check directory flags
@@ -246,7 +385,7 @@ namespace igros::x86_64 {
 			reinterpret_cast<std::size_t>(dir)
 		};
 		// Check flags
-		return maskedFlags != (dirFlags & maskedFlags);
+		return maskedFlags == (dirFlags & maskedFlags);
 	}
 
 	// Check table flags
@@ -259,7 +398,7 @@ namespace igros::x86_64 {
 			reinterpret_cast<std::size_t>(table)
 		};
 		// Check flags
-		return maskedFlags != (tableFlags & maskedFlags);
+		return maskedFlags == (tableFlags & maskedFlags);
 	}
 
 	// Check page flags
@@ -272,7 +411,7 @@ namespace igros::x86_64 {
 			reinterpret_cast<std::size_t>(page)
 		};
 		// Check flags
-		return maskedFlags != (pageFlags & maskedFlags);
+		return maskedFlags == (pageFlags & maskedFlags);
 	}
 
 
@@ -304,7 +443,7 @@ namespace igros::x86_64 {
 	// Map virtual page to physical page (whole pml4)
 	void paging::mapPML4(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
 		// Get pointer to page map level 4
-		const auto pml4 = reinterpret_cast<pml4_t*>(outCR3());
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
 		// Map page to curent page map level 4
 		paging::mapPML4(pml4, phys, virt, flags);
 	}
@@ -312,52 +451,14 @@ namespace igros::x86_64 {
 
 	// Map virtual page to physical page (single directory pointer, explicit pml4)
 	void paging::mapDirectoryPointer(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
-
-		// Check alignment
-		if (
-			!klib::kalignCheck(phys, PAGE_SHIFT)	||
-			!klib::kalignCheck(virt, PAGE_SHIFT)
-		) {
-			// Bad align detected
-			return;
-		}
-
-		// Page map level 4 table table index from virtual address
-		const auto pml4ID = (reinterpret_cast<std::size_t>(virt) >> 39) & 0x1FF;
-
-		// Get page directory pointer
-		auto &dirPtr = pml4->pointers[pml4ID];
-		// Check if page directory pointer is present or not
-		if (!paging::checkFlags(dirPtr, FLAGS::PRESENT)) {
-			// Allocate page directory pointer
-			dirPtr = paging::makeDirectoryPointer();
-		}
-
-		// Get page pointer and map physical page
-		for (auto i = 0U; i < (sizeof(directoryPointer_t) >> 3); i++) {
-			// Get phys directory ID
-			const auto directory = kflags<FLAGS> {
-				reinterpret_cast<std::size_t>(phys) + (i << PAGE_SHIFT),
-				flags & FLAGS::FLAGS_MASK
-			};
-			// Map page
-			dirPtr->directories[i] = reinterpret_cast<directory_t*>(directory.value());
-		}
-
-		// Directory pointer flags
-		const auto dirPtrFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(dirPtr) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Insert page directory pointer
-		dirPtr = reinterpret_cast<directoryPointer_t*>(dirPtrFlags.value());
-
+		// Map 512 Gb range
+		paging::mapRange(pml4, phys, virt, 1ULL << PAGE_MAP_LEVEL_4_SHIFT, flags);
 	}
 
 	// Map virtual page to physical page (single directory pointer)
 	void paging::mapDirectoryPointer(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
 		// Get pointer to page map level 4
-		const auto pml4 = reinterpret_cast<pml4_t*>(outCR3());
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
 		// Map page to curent page map level 4
 		paging::mapDirectoryPointer(pml4, phys, virt, flags);
 	}
@@ -365,76 +466,51 @@ namespace igros::x86_64 {
 
 	// Map virtual page to physical page (single directory, explicit pml4)
 	void paging::mapDirectory(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Map 1 Gb range
+		paging::mapRange(pml4, phys, virt, 1ULL << PAGE_DIRECTORY_POINTER_SHIFT, flags);
+	}
 
-		// Check alignment
-		if (
-			!klib::kalignCheck(phys, PAGE_SHIFT)	||
-			!klib::kalignCheck(virt, PAGE_SHIFT)
-		) {
-			// Bad align detected
-			return;
-		}
+	// Map virtual page to physical page (single directory)
+	void paging::mapDirectory(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Get pointer to page map level 4
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
+		// Map page to curent page map level 4
+		paging::mapDirectory(pml4, phys, virt, flags);
+	}
 
-		// Page map level 4 table table index from virtual address
-		const auto pml4ID	= (reinterpret_cast<std::size_t>(virt) >> 39) & 0x1FF;
-		// Page directory pointer table index from virtual address
-		const auto dirPtrID	= (reinterpret_cast<std::size_t>(virt) >> 30) & 0x1FF;
-
-		// Get page directory pointer
-		auto &dirPtr = pml4->pointers[pml4ID];
-		// Check if page directory pointer is present or not
-		if (!paging::checkFlags(dirPtr, FLAGS::PRESENT)) {
-			// Allocate page directory pointer
-			dirPtr = paging::makeDirectoryPointer();
-		}
 
-		// Get page directory
-		auto &dir = dirPtr->directories[dirPtrID];
-		// Check if page directory is present or not
-		if (!paging::checkFlags(dir, FLAGS::PRESENT)) {
-			// Allocate page table
-			dir = paging::makeDirectory();
-		}
+	// Map virtual page to physical page (single table, explicit pml4)
+	void paging::mapTable(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Map 2 Mb range
+		paging::mapRange(pml4, phys, virt, 1ULL << PAGE_DIRECTORY_SHIFT, flags);
+	}
 
-		// Get page pointer and map physical page
-		for (auto i = 0U; i < (sizeof(page_t) >> 3); i++) {
-			// Get phys page ID
-			const auto page	= kflags<FLAGS> {
-				reinterpret_cast<std::size_t>(phys) + (i << PAGE_SHIFT),
-				flags & FLAGS::FLAGS_MASK
-			};
-			// Map page
-			dir->tables[i]	= reinterpret_cast<table_t*>(page.value());
-		}
+	// Map virtual page to physical page (single table)
+	void paging::mapTable(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Get pointer to page map level 4
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
+		// Map page to curent page map level 4
+		paging::mapTable(pml4, phys, virt, flags);
+	}
 
-		// Get directory pointer flags
-		const auto dirPtrFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(dirPtr) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Get directory flags
-		const auto dirFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(dir) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Insert page directory pointer
-		dirPtr	= reinterpret_cast<directoryPointer_t*>(dirPtrFlags.value());
-		// Insert page directory
-		dir	= reinterpret_cast<directory_t*>(dirFlags.value());
 
+	// Map virtual page to physical page (single page, explicit page directory)
+	void paging::mapPage(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+		// Map 4 Kb range
+		paging::mapRange(pml4, phys, virt, PAGE_SIZE, flags);
 	}
 
-	// Map virtual page to physical page (single directory)
-	void paging::mapDirectory(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+	// Map virtual page to physical page (single page)
+	void paging::mapPage(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
 		// Get pointer to page map level 4
-		const auto pml4 = reinterpret_cast<pml4_t*>(outCR3());
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
 		// Map page to curent page map level 4
-		paging::mapDirectory(pml4, phys, virt, flags);
+		paging::mapPage(pml4, phys, virt, flags);
 	}
 
 
-	// Map virtual page to physical page (single table, explicit pml4)
-	void paging::mapTable(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+	// Map physical range to virtual range with biggest fitting pages (explicit pml4)
+	bool paging::mapRange(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending) noexcept {
 
 		// Check alignment
 		if (
@@ -442,173 +518,266 @@ namespace igros::x86_64 {
 			!klib::kalignCheck(virt, PAGE_SHIFT)
 		) {
 			// Bad align detected
-			return;
+			return false;
 		}
 
-		// Page map level 4 table table index from virtual address
-		const auto pml4ID	= (reinterpret_cast<std::size_t>(virt) >> 39) & 0x1FF;
-		// Page directory pointer table index from virtual address
-		const auto dirPtrID	= (reinterpret_cast<std::size_t>(virt) >> 30) & 0x1FF;
-		// Page directory table entry index from virtual address
-		const auto dirID	= (reinterpret_cast<std::size_t>(virt) >> 21) & 0x1FF;
-
-		// Get page directory pointer
-		auto &dirPtr = pml4->pointers[pml4ID];
-		// Check if page directory pointer is present or not
-		if (!paging::checkFlags(dirPtr, FLAGS::PRESENT)) {
-			// Allocate page directory pointer
-			dirPtr = paging::makeDirectoryPointer();
-		}
+		// Physical and virtual addresses
+		auto physAddr	= reinterpret_cast<quad_t>(phys);
+		auto virtAddr	= reinterpret_cast<quad_t>(virt);
+		// Bytes left to map (whole pages, counted down to survive address space wrap)
+		auto left	= (static_cast<quad_t>(length) + PAGE_MASK) & ~PAGE_MASK;
+
+		// Leaf entries flags (size bit is set per level)
+		const auto leaf	= (flags.value() & ((PAGE_MASK & ~ENTRY_HUGE) | ENTRY_NX)) | ENTRY_PRESENT;
+		// Tables entries flags (leaf entries restrict access)
+		const auto link	= ENTRY_PRESENT | ENTRY_WRITABLE | (leaf & ENTRY_USER);
+		// Check 1 Gb pages support
+		const auto gigabytes = hasGigabytePages();
+		// Stale translations queue (own one is flushed once on return)
+		batch local;
+		auto &queue	= (nullptr != pending) ? *pending : local;
+
+		// Tables of current position (walked down once, re-entered on boundaries only)
+		auto dirPtr	= static_cast<pointer_t>(nullptr);
+		auto dir	= static_cast<pointer_t>(nullptr);
+		auto table	= static_cast<pointer_t>(nullptr);
+
+		// Map whole range
+		while (0ULL != left) {
+
+			// Enter page directory pointer on first step or 512 Gb boundary
+			if ((nullptr == dirPtr) || (0ULL == (virtAddr & entrySpan(PAGE_MAP_LEVEL_4_SHIFT)))) {
+				// Get (or make) page directory pointer
+				dirPtr = descend(tableEntry(pml4, virtAddr, PAGE_MAP_LEVEL_4_SHIFT), PAGE_DIRECTORY_POINTER_SHIFT, link, queue, virtAddr);
+				if (nullptr == dirPtr) {
+					// Out of page tables
+					return false;
+				}
+			}
+
+			// Map 1 Gb page if both addresses are aligned and range is big enough
+			if (gigabytes && fits(physAddr, virtAddr, left, PAGE_DIRECTORY_POINTER_SHIFT)) {
+				// Replace page directory pointer entry
+				replace(tableEntry(dirPtr, virtAddr, PAGE_DIRECTORY_POINTER_SHIFT), physAddr | leaf | ENTRY_HUGE, virtAddr, PAGE_DIRECTORY_POINTER_SHIFT, queue);
+				// Move to next 1 Gb
+				advance(physAddr, virtAddr, left, PAGE_DIRECTORY_POINTER_SHIFT);
+				continue;
+			}
+
+			// Enter page directory on first step or 1 Gb boundary
+			if ((nullptr == dir) || (0ULL == (virtAddr & entrySpan(PAGE_DIRECTORY_POINTER_SHIFT)))) {
+				// Get (or make) page directory
+				dir = descend(tableEntry(dirPtr, virtAddr, PAGE_DIRECTORY_POINTER_SHIFT), PAGE_DIRECTORY_SHIFT, link, queue, virtAddr);
+				if (nullptr == dir) {
+					// Out of page tables
+					return false;
+				}
+			}
+
+			// Map 2 Mb page if both addresses are aligned and range is big enough
+			if (fits(physAddr, virtAddr, left, PAGE_DIRECTORY_SHIFT)) {
+				// Replace page directory entry
+				replace(tableEntry(dir, virtAddr, PAGE_DIRECTORY_SHIFT), physAddr | leaf | ENTRY_HUGE, virtAddr, PAGE_DIRECTORY_SHIFT, queue);
+				// Move to next 2 Mb
+				advance(physAddr, virtAddr, left, PAGE_DIRECTORY_SHIFT);
+				continue;
+			}
+
+			// Enter page table on first step or 2 Mb boundary
+			if ((nullptr == table) || (0ULL == (virtAddr & entrySpan(PAGE_DIRECTORY_SHIFT)))) {
+				// Get (or make) page table
+				table = descend(tableEntry(dir, virtAddr, PAGE_DIRECTORY_SHIFT), PAGE_TABLE_SHIFT, link, queue, virtAddr);
+				if (nullptr == table) {
+					// Out of page tables
+					return false;
+				}
+			}
+
+			// Map 4 Kb page
+			replace(tableEntry(table, virtAddr, PAGE_TABLE_SHIFT), physAddr | leaf, virtAddr, PAGE_TABLE_SHIFT, queue);
+			// Move to next 4 Kb
+			advance(physAddr, virtAddr, left, PAGE_TABLE_SHIFT);
 
-		// Get page directory
-		auto &dir = dirPtr->directories[dirPtrID];
-		// Check if page directory is present or not
-		if (!paging::checkFlags(dir, FLAGS::PRESENT)) {
-			// Allocate page directory
-			dir = paging::makeDirectory();
 		}
 
-		// Get page table
-		auto &table = dir->tables[dirID];
-		// Check if page directory is present or not
-		if (!paging::checkFlags(table, FLAGS::PRESENT)) {
-			// Allocate page table
-			table = paging::makeTable();
-		}
-
-		// Get page pointer and map physical page
-		for (auto i = 0U; i < (sizeof(page_t) >> 3); i++) {
-			// Get phys page ID
-			auto page = kflags<FLAGS> {
-				reinterpret_cast<std::size_t>(phys) + (i << PAGE_SHIFT),
-				flags & FLAGS::FLAGS_MASK
-			};
-			// Map page
-			table->pages[i] = reinterpret_cast<page_t*>(page.value());
-		}
-
-		// Get directory pointer flags
-		const auto dirPtrFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(dirPtr) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Get directory flags
-		const auto dirFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(dir) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Get table flags
-		const auto tableFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(table) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Insert page directory pointer
-		dirPtr	= reinterpret_cast<directoryPointer_t*>(dirPtrFlags.value());
-		// Insert page directory
-		dir	= reinterpret_cast<directory_t*>(dirFlags.value());
-		// Insert page table
-		table	= reinterpret_cast<table_t*>(tableFlags.value());
-
-		//
-		//klib::kprintf(u8"Table mapped:\t0x%p -> 0x%p [%3d, %3d, %3d, %3c]", phys, virt, pml4ID, dirPtrID, dirID, u8'-');
+		// Whole range mapped
+		return true;
 
 	}
 
-	// Map virtual page to physical page (single table)
-	void paging::mapTable(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+	// Map physical range to virtual range with biggest fitting pages
+	bool paging::mapRange(const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending) noexcept {
 		// Get pointer to page map level 4
-		const auto pml4 = reinterpret_cast<pml4_t*>(outCR3());
-		// Map page to curent page map level 4
-		paging::mapTable(pml4, phys, virt, flags);
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
+		// Map range to curent page map level 4
+		return paging::mapRange(pml4, phys, virt, length, flags, pending);
 	}
 
 
-	// Map virtual page to physical page (single page, explicit page directory)
-	void paging::mapPage(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
+	// Unmap virtual range (explicit pml4)
+	bool paging::unmapRange(pml4_t* const pml4, const pointer_t virt, const std::size_t length, batch* const pending) noexcept {
 
 		// Check alignment
-		if (
-			!klib::kalignCheck(phys, PAGE_SHIFT)	||
-			!klib::kalignCheck(virt, PAGE_SHIFT)
-		) {
+		if (!klib::kalignCheck(virt, PAGE_SHIFT)) {
 			// Bad align detected
-			return;
+			return false;
 		}
 
-		// Page map level 4 table table index from virtual address
-		const auto pml4ID	= (reinterpret_cast<std::size_t>(virt) >> 39) & 0x1FF;
-		// Page directory pointer table index from virtual address
-		const auto dirPtrID	= (reinterpret_cast<std::size_t>(virt) >> 30) & 0x1FF;
-		// Page directory table entry index from virtual address
-		const auto dirID	= (reinterpret_cast<std::size_t>(virt) >> 21) & 0x1FF;
-		// Page table table entry index from virtual address
-		const auto tabID	= (reinterpret_cast<std::size_t>(virt) >> PAGE_SHIFT) & 0x1FF;
-
-		// Get page directory pointer
-		auto &dirPtr = pml4->pointers[pml4ID];
-		// Check if page directory pointer is present or not
-		if (!paging::checkFlags(dirPtr, FLAGS::PRESENT)) {
-			// Allocate page directory pointer
-			dirPtr = paging::makeDirectoryPointer();
+		// Virtual address
+		auto virtAddr	= reinterpret_cast<quad_t>(virt);
+		// Bytes left to unmap (whole pages)
+		auto left	= (static_cast<quad_t>(length) + PAGE_MASK) & ~PAGE_MASK;
+		// Stale translations queue (own one is flushed once on return)
+		batch local;
+		auto &queue	= (nullptr != pending) ? *pending : local;
+
+		// Unmap whole range
+		while (0ULL != left) {
+
+			// Walk down from page map level 4
+			auto table = static_cast<pointer_t>(pml4);
+			auto shift = PAGE_MAP_LEVEL_4_SHIFT;
+			while (true) {
+				// Get entry of current level
+				auto &entry = tableEntry(table, virtAddr, shift);
+				// Nothing mapped - skip whole entry
+				if (0ULL == (entry & ENTRY_PRESENT)) {
+					skip(virtAddr, left, shift);
+					break;
+				}
+				// Go to next level table
+				if (
+					(PAGE_TABLE_SHIFT != shift)	&&
+					((PAGE_MAP_LEVEL_4_SHIFT == shift) || (0ULL == (entry & ENTRY_HUGE)))
+				) {
+					table = tableVirt(entry);
+					shift -= PAGE_LEVEL_SHIFT;
+					continue;
+				}
+				// Split huge page not covered by range
+				if (!fits(0ULL, virtAddr, left, shift)) {
+					table = descend(entry, shift - PAGE_LEVEL_SHIFT, ENTRY_PRESENT | ENTRY_WRITABLE, queue, virtAddr);
+					if (nullptr == table) {
+						// Out of page tables
+						return false;
+					}
+					shift -= PAGE_LEVEL_SHIFT;
+					continue;
+				}
+				// Drop page
+				entry = 0ULL;
+				queue.add(reinterpret_cast<pointer_t>(virtAddr));
+				skip(virtAddr, left, shift);
+				break;
+			}
+
 		}
 
-		// Get page directory
-		auto &dir = dirPtr->directories[dirPtrID];
-		// Check if page directory is present or not
-		if (!paging::checkFlags(dir, FLAGS::PRESENT)) {
-			// Allocate page directory
-			dir = paging::makeDirectory();
+		// Whole range unmapped
+		return true;
+
+	}
+
+	// Unmap virtual range
+	bool paging::unmapRange(const pointer_t virt, const std::size_t length, batch* const pending) noexcept {
+		// Get pointer to page map level 4
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
+		// Unmap range from curent page map level 4
+		return paging::unmapRange(pml4, virt, length, pending);
+	}
+
+
+	// Invalidate TLB entry of single page
+	void paging::invalidate(const pointer_t virt) noexcept {
+		invalidatePage(virt);
+		// Kernel half page is not global - INVLPG drops only current PCID entry
+		if (reinterpret_cast<quad_t>(virt) >= PAGE_KERNEL_SPACE) {
+			pcid::invalidateAll();
 		}
+	}
+
+	// Invalidate TLB entries of range (whole TLB is flushed for big ranges)
+	void paging::invalidateRange(const pointer_t virt, const std::size_t length) noexcept {
+		// Queue range (flushed on return)
+		batch pending;
+		pending.add(virt, length);
+	}
 
-		// Get page table
-		auto &table = dir->tables[dirID];
-		// Check if page directory is present or not
-		if (!paging::checkFlags(table, FLAGS::PRESENT)) {
-			// Allocate page table
-			table = paging::makeTable();
+	// Flush whole TLB (global entries too if requested)
+	void paging::flushTLB(const bool global) noexcept {
+		// Current CR4 value
+		const auto cr4 = outCR4();
+		// Toggling PGE drops global entries too (of all PCIDs)
+		if (global && (0ULL != (cr4 & PAGE_CR4_PGE))) {
+			inCR4(cr4 & ~PAGE_CR4_PGE);
+			inCR4(cr4);
+			return;
 		}
+		// Reload CR3 (non-global entries of current PCID)
+		inCR3(outCR3());
+		// Other PCIDs may still cache kernel half entries
+		if (global) {
+			pcid::invalidateAll();
+		}
+	}
 
-		// Get page
-		auto &page = table->pages[tabID];
 
-		// Get directory pointer flags
-		const auto dirPtrFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(dirPtr) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Get directory flags
-		const auto dirFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(dir) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Get table flags
-		const auto tableFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(table) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
-		// Get page flags
-		const auto pageFlags = kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(page) & 0x7FFFFFFF,
-			flags & FLAGS::FLAGS_MASK
-		};
+	// D-tor (pending invalidations are flushed)
+	paging::batch::~batch() noexcept {
+		flush();
+	}
 
-		// Insert page directory pointer
-		dirPtr	= reinterpret_cast<directoryPointer_t*>(dirPtrFlags.value());
-		// Insert page directory
-		dir	= reinterpret_cast<directory_t*>(dirFlags.value());
-		// Insert page table
-		table	= reinterpret_cast<table_t*>(tableFlags.value());
-		// Insert page pointer
-		page	= reinterpret_cast<page_t*>(pageFlags.value());
+	// Queue single TLB entry invalidation
+	void paging::batch::add(const pointer_t virt) noexcept {
+		// Kernel half mappings are shared by all address spaces (global or cached under other PCIDs)
+		mGlobal = mGlobal || (reinterpret_cast<quad_t>(virt) >= PAGE_KERNEL_SPACE);
+		// Whole TLB is flushed anyway
+		if (mFull) {
+			return;
+		}
+		// Too many pages - flush whole TLB
+		if (mCount >= PAGE_INVALIDATE_LIMIT) {
+			mFull = true;
+			return;
+		}
+		// Queue page
+		mPages[mCount++] = virt;
+	}
 
+	// Queue range TLB entries invalidation
+	void paging::batch::add(const pointer_t virt, const std::size_t length) noexcept {
+		// Range pages count
+		const auto count = (static_cast<quad_t>(length) + PAGE_MASK) >> PAGE_SHIFT;
+		// Too many pages - flush whole TLB
+		if (count > (PAGE_INVALIDATE_LIMIT - mCount)) {
+			mGlobal	= mGlobal || ((reinterpret_cast<quad_t>(virt) + length - 1ULL) >= PAGE_KERNEL_SPACE);
+			mFull	= true;
+			return;
+		}
+		// Queue range pages
+		for (auto i = 0ULL; i < count; i++) {
+			add(static_cast<byte_t*>(virt) + (i << PAGE_SHIFT));
+		}
 	}
 
-	// Map virtual page to physical page (single page)
-	void paging::mapPage(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept {
-		// Get pointer to page map level 4
-		const auto pml4 = reinterpret_cast<pml4_t*>(outCR3());
-		// Map page to curent page map level 4
-		paging::mapPage(pml4, phys, virt, flags);
+	// Flush pending invalidations
+	void paging::batch::flush() noexcept {
+		// Flush whole TLB or single pages
+		if (mFull) {
+			paging::flushTLB(mGlobal);
+		} else {
+			for (auto i = 0ULL; i < mCount; i++) {
+				invalidatePage(mPages[i]);
+			}
+			// Other PCIDs may still cache kernel half entries
+			if (mGlobal) {
+				pcid::invalidateAll();
+			}
+		}
+		// Nothing pending
+		mCount	= 0ULL;
+		mFull	= false;
+		mGlobal	= false;
 	}
 
 
@@ -616,67 +785,93 @@ namespace igros::x86_64 {
 	[[nodiscard]]
 	pointer_t paging::translate(const pointer_t virt) noexcept {
 
-		// Page map level 4 table table index from virtual address
-		const auto pml4ID	= (reinterpret_cast<std::size_t>(virt) >> 39) & 0x1FF;
-		// Page directory pointer table index from virtual address
-		const auto dirPtrID	= (reinterpret_cast<std::size_t>(virt) >> 30) & 0x1FF;
-		// Page directory table entry index from virtual address
-		const auto dirID	= (reinterpret_cast<std::size_t>(virt) >> 21) & 0x1FF;
-		// Page table table entry index from virtual address
-		const auto tabID	= (reinterpret_cast<std::size_t>(virt) >> PAGE_SHIFT) & 0x1FF;
-
+		// Virtual address
+		const auto virtAddr	= reinterpret_cast<quad_t>(virt);
 		// Get pointer to pml4
-		const auto pml4		= reinterpret_cast<const pml4_t*>(outCR3());
-
-		// Get page directory pointer
-		const auto dirPtr = pml4->pointers[pml4ID];
-		// Check if page directory pointer is present or not
-		if (!paging::checkFlags(dirPtr, FLAGS::PRESENT)) {
-			// Page or table is not present
-			return nullptr;
+		auto table		= tableVirt(outCR3());
+
+		// Walk down from page map level 4 to page table
+		for (auto shift = PAGE_MAP_LEVEL_4_SHIFT; ; shift -= PAGE_LEVEL_SHIFT) {
+			// Get entry of current level
+			const auto entry = tableEntry(table, virtAddr, shift);
+			// Check if entry is present or not
+			if (0ULL == (entry & ENTRY_PRESENT)) {
+				// Page or table is not present
+				return nullptr;
+			}
+			// Page table entry or huge page found
+			if (
+				(PAGE_TABLE_SHIFT == shift)	||
+				((PAGE_MAP_LEVEL_4_SHIFT != shift) && (0ULL != (entry & ENTRY_HUGE)))
+			) {
+				// Page physical address and offset inside page
+				return reinterpret_cast<pointer_t>((entry & PAGE_ENTRY_ADDR_MASK & ~entrySpan(shift)) | (virtAddr & entrySpan(shift)));
+			}
+			// Go to next level table
+			table = tableVirt(entry);
 		}
 
-		// Get page directory
-		const auto dir = dirPtr->directories[dirPtrID];
-		// Check if page directory is present or not
-		if (!paging::checkFlags(dir, FLAGS::PRESENT)) {
-			// Page or table is not present
-			return nullptr;
-		}
+	}
 
-		// Get page table pointer
-		const auto table = dir->tables[dirID];
-		// Check if page table is present or not
-		if (!paging::checkFlags(table, FLAGS::PRESENT)) {
-			// Page or table is not present
-			return nullptr;
-		}
 
-		// Get page table pointer
-		const auto page = table->pages[tabID];
-		// Check if page is present or not
-		if (!paging::checkFlags(page, FLAGS::PRESENT)) {
-			// Page or table is not present
-			return nullptr;
+	// Get active page map level 4
+	[[nodiscard]]
+	pml4_t* paging::root() noexcept {
+		// Page map level 4 from CR3
+		return static_cast<pml4_t*>(tableVirt(outCR3()));
+	}
+
+
+	// Get 4 Kb page entry of virtual address (explicit pml4, nullptr if not mapped by 4 Kb page)
+	[[nodiscard]]
+	quad_t* paging::leaf(pml4_t* const pml4, const pointer_t virt) noexcept {
+
+		// Virtual address
+		const auto virtAddr	= reinterpret_cast<quad_t>(virt);
+		// Start from page map level 4
+		auto table		= static_cast<pointer_t>(pml4);
+
+		// Walk down from page map level 4 to page table
+		for (auto shift = PAGE_MAP_LEVEL_4_SHIFT; PAGE_TABLE_SHIFT != shift; shift -= PAGE_LEVEL_SHIFT) {
+			// Get entry of current level
+			const auto entry = tableEntry(table, virtAddr, shift);
+			// Table is not present or huge page maps address
+			if (
+				(0ULL == (entry & ENTRY_PRESENT))	||
+				((PAGE_MAP_LEVEL_4_SHIFT != shift) && (0ULL != (entry & ENTRY_HUGE)))
+			) {
+				return nullptr;
+			}
+			// Go to next level table
+			table = tableVirt(entry);
 		}
 
-		// Get physical address of page from page table (43 MSB)
-		const auto address	= kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(page)
-		};
-		// Get physical offset in psge from virtual address`s (21 LSB)
-		const auto offset	= kflags<FLAGS> {
-			reinterpret_cast<std::size_t>(virt)
-		};
-		// Return physical address
-		return reinterpret_cast<pointer_t>(((address & FLAGS::PHYS_ADDR_MASK) | (offset & FLAGS::FLAGS_MASK)).value());
+		// Page table entry (may be not present)
+		return &tableEntry(table, virtAddr, PAGE_TABLE_SHIFT);
+
+	}
 
+	// Get 4 Kb page entry of virtual address (nullptr if not mapped by 4 Kb page)
+	[[nodiscard]]
+	quad_t* paging::leaf(const pointer_t virt) noexcept {
+		// Get pointer to page map level 4
+		const auto pml4 = static_cast<pml4_t*>(tableVirt(outCR3()));
+		// Look up curent page map level 4
+		return paging::leaf(pml4, virt);
 	}
 
 
 	// Page Fault Exception handler
 	void paging::exHandler(const register_t* regs) noexcept {
 
+		// Trace fault (formatted on dump only)
+		klib::ktrace(u8"Page fault at %p (error %x)"_fmt, reinterpret_cast<const pointer_t>(outCR2()), static_cast<dword_t>(regs->param));
+
+		// Resolve demand paging fault (error code: bit 0 - present, bit 1 - write)
+		if (mem::vmm::fault(reinterpret_cast<const pointer_t>(outCR2()), 0U != (regs->param & 0x02), 0U != (regs->param & 0x01))) {
+			return;
+		}
+
 		// Disable IRQ
 		irq::disable();
 
@@ -697,6 +892,9 @@ namespace igros::x86_64 {
 				reinterpret_cast<const pointer_t>(outCR2()),
 				((regs->param & 0x01) == 0U) ? u8"PRESENT"		: u8"PRIVILEGED");
 
+		// Show events before failure
+		klib::ktraceRing::dump();
+
 		// Hang here
 		cpuHalt();
 
@@ -706,7 +904,7 @@ namespace igros::x86_64 {
 	// Set page directory
 	void paging::flush(const pml4_t* const dir) noexcept {
 		// Set page directory address to CR3
-		inCR3(reinterpret_cast<std::ptrdiff_t>(dir) & 0x7FFFFFFF);
+		inCR3(mem::virtToPhys(dir));
 	}
 
 
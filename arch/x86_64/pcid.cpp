@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////
+//
+//	Process-context identifiers (tagged TLB entries)
+//
+//	File:	pcid.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#include <arch/x86_64/cr.hpp>
+#include <arch/x86_64/cpuid.hpp>
+#include <arch/x86_64/pcid.hpp>
+
+#include <klib/kmemory.hpp>
+#include <klib/kprint.hpp>
+
+#include <mem/direct.hpp>
+#include <mem/vmm.hpp>
+
+
+// x86_64 namespace
+namespace igros::x86_64 {
+
+
+	// PCID support bit in CPUID ECX
+	constexpr auto	PCID_CPUID_BIT		= 0x00020000U;
+	// PCID enable bit in CR4
+	constexpr auto	PCID_CR4_PCIDE		= 0x0000000000020000ULL;
+	// Page Global Extension bit in CR4
+	constexpr auto	PCID_CR4_PGE		= 0x0000000000000080ULL;
+
+
+	// CR4.PCIDE is set
+	bool	pcid::mEnabled		{false};
+	// Current PCIDs generation (0 is never valid)
+	quad_t	pcid::mGeneration	{1ULL};
+	// Next free PCID of current generation
+	quad_t	pcid::mNext		{PCID_FIRST};
+	// Generation changes count
+	quad_t	pcid::mRecycles		{0ULL};
+	// Switches with valid PCID count
+	quad_t	pcid::mHits		{0ULL};
+	// Switches with new PCID count
+	quad_t	pcid::mMisses		{0ULL};
+
+
+	// Drop TLB entries of all PCIDs
+	void pcid::flushAll() noexcept {
+		// Any CR4.PGE change drops all TLB entries (all PCIDs, global ones too)
+		const auto cr4 = outCR4();
+		inCR4(cr4 ^ PCID_CR4_PGE);
+		inCR4(cr4);
+	}
+
+
+	// Detect and enable PCID support
+	void pcid::init() noexcept {
+		// Check CPUID reports PCID (ECX bit 17)
+		if (0U == (cpuid(cpuidFlags_t::INFO_PROC_VERSION).ecx & PCID_CPUID_BIT)) {
+			return;
+		}
+		// CR4.PCIDE may only be set while PCID 0 is current
+		if (0ULL != (outCR3() & PCID_MASK)) {
+			return;
+		}
+		// Enable PCID
+		inCR4(outCR4() | PCID_CR4_PCIDE);
+		mEnabled = true;
+	}
+
+
+	// Check PCID is enabled
+	[[nodiscard]]
+	bool pcid::enabled() noexcept {
+		return mEnabled;
+	}
+
+
+	// Switch to page map level 4 (TLB entries are kept while tag is valid)
+	void pcid::switchTo(const pml4_t* const pml4, tag_t &tag) noexcept {
+		// Page map level 4 physical address
+		const auto phys = static_cast<quad_t>(mem::virtToPhys(pml4));
+		// No PCID - plain CR3 write drops whole non-global TLB
+		if (!mEnabled) {
+			inCR3(phys);
+			return;
+		}
+		// PCID of current generation is still valid - keep its TLB entries
+		if (mGeneration == tag.generation) {
+			++mHits;
+			inCR3(phys | tag.id | PCID_NO_FLUSH);
+			return;
+		}
+		// PCIDs are exhausted - start new generation
+		if (mNext > PCID_MASK) {
+			// Drop TLB entries of old generation PCIDs
+			flushAll();
+			++mGeneration;
+			++mRecycles;
+			mNext = PCID_FIRST;
+		}
+		// Take new PCID
+		++mMisses;
+		tag.generation	= mGeneration;
+		tag.id		= mNext++;
+		// Stale entries of reused PCID are dropped by CR3 write
+		inCR3(phys | tag.id);
+	}
+
+	// Forget address space PCID (next switch takes new one)
+	void pcid::invalidate(tag_t &tag) noexcept {
+		// Old PCID is never reused before next generation flush
+		tag.generation = 0ULL;
+	}
+
+	// Forget PCIDs of all address spaces (kernel half mapping changed, other PCIDs may still cache it)
+	void pcid::invalidateAll() noexcept {
+		// Without PCID every CR3 write drops non-global entries anyway
+		if (!mEnabled) {
+			return;
+		}
+		// Start new generation (reused PCIDs are flushed by CR3 write of next switch)
+		++mGeneration;
+		++mRecycles;
+		mNext = PCID_FIRST;
+	}
+
+
+	// Measure ping-pong between two address spaces with tagged and plain CR3 writes
+	void pcid::benchmark(const std::size_t pages) noexcept {
+		// Switches per measurement
+		constexpr auto rounds = 64ULL;
+		// Working set (kernel heap pages are not global, so CR3 writes drop them)
+		const auto length	= pages << PAGE_SHIFT;
+		const auto set		= static_cast<byte_t*>(mem::vmm::reserve(length));
+		// Second page map level 4 sharing all tables with active one
+		const auto active	= paging::root();
+		const auto other	= static_cast<pml4_t*>(paging::allocate());
+		if (	(nullptr == set)
+			|| (nullptr == other)) {
+			klib::kprintf(u8"PCID:\tping-pong skipped (not enough memory)");
+			paging::deallocate(other);
+			mem::vmm::release(set);
+			return;
+		}
+		klib::kmemcpy(other, active, sizeof(pml4_t));
+		// Map every page of working set
+		klib::kmemset(set, length, byte_t(0x5A));
+		// Touch every page of working set after switch
+		const auto touch = [set, pages]() noexcept {
+			for (auto i = 0ULL; i < pages; i++) {
+				static_cast<void>(static_cast<volatile byte_t*>(set)[i << PAGE_SHIFT]);
+			}
+		};
+		// Nothing else runs on other page map
+		arch::irqGuard guard;
+		// Tagged switches (TLB entries of both spaces are kept)
+		tag_t tags[2] {};
+		const pml4_t* roots[2] {other, active};
+		auto start = arch::cpu::get().timestamp();
+		for (auto round = 0ULL; round < rounds; round++) {
+			for (auto side = 0ULL; side < 2ULL; side++) {
+				pcid::switchTo(roots[side], tags[side]);
+				touch();
+			}
+		}
+		const auto tagged = (arch::cpu::get().timestamp() - start) / (rounds << 1);
+		// Plain switches (PCID 0 entries are dropped by every write)
+		start = arch::cpu::get().timestamp();
+		for (auto round = 0ULL; round < rounds; round++) {
+			for (auto side = 0ULL; side < 2ULL; side++) {
+				inCR3(static_cast<quad_t>(mem::virtToPhys(roots[side])));
+				touch();
+			}
+		}
+		const auto plain = (arch::cpu::get().timestamp() - start) / (rounds << 1);
+		// Back to boot page map with PCID 0 (benchmark PCIDs are never used again)
+		inCR3(static_cast<quad_t>(mem::virtToPhys(active)));
+		pcid::invalidate(tags[0]);
+		pcid::invalidate(tags[1]);
+		paging::deallocate(other);
+		mem::vmm::release(set);
+		// Show results
+		klib::kprintf(
+			u8"PCID:\tswitch and touch %d pages:\t%d cycles tagged, %d cycles plain%s",
+			static_cast<dword_t>(pages),
+			static_cast<dword_t>(tagged),
+			static_cast<dword_t>(plain),
+			mEnabled ? u8"" : u8" (PCID not supported)"
+		);
+	}
+
+
+	// Print PCID allocator state
+	void pcid::print() noexcept {
+		klib::kprintf(
+			u8"PCID:\t%s\r\n"
+			u8"\tGeneration:\t%d (%d recycles)\r\n"
+			u8"\tSwitches:\t%d kept, %d new\r\n",
+			mEnabled ? u8"enabled" : u8"disabled",
+			static_cast<dword_t>(mGeneration),
+			static_cast<dword_t>(mRecycles),
+			static_cast<dword_t>(mHits),
+			static_cast<dword_t>(mMisses)
+		);
+	}
+
+
+}	// namespace igros::x86_64
+
@@ -19,7 +19,7 @@
 #include <drivers/clock/pit.hpp>
 
 #include <klib/kmath.hpp>
-#include <klib/kprint.hpp>
+#include <klib/klog.hpp>
 
 
 // Arch-dependent code zone
@@ -51,8 +51,8 @@ namespace igros::arch {
 		// Save current real frequency value
 		PIT_FREQUENCY	= PIT_MAIN_FREQUENCY / divisor;
 
-		klib::kprintf(
-			u8"REAL frequency set to: %d Hz.",
+		klib::klog<klib::KLOG_LEVEL::INFO>(
+			u8"REAL frequency set to: %d Hz."_fmt,
 			PIT_FREQUENCY
 		);
 
@@ -85,15 +85,15 @@ namespace igros::arch {
 		if (0U == (++PIT_TICKS % PIT_FREQUENCY)) {
 			// Current time to HH:MM:SS.zzz
 			const auto elapsed	= pitGetTicks();
-			const auto res		= klib::kudivmod(elapsed, PIT_MAIN_FREQUENCY);
+			const auto res		= klib::kudivmod<PIT_MAIN_FREQUENCY>(elapsed);
 			const auto nanoseconds	= static_cast<dword_t>(res.reminder);
 			const auto seconds	= static_cast<dword_t>(res.quotient);
 			const auto minutes	= seconds / 60U;
 			const auto hours	= minutes / 60U;
 			// Debug date/time
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::DEBUG>(
 				u8"IRQ #%d\t[PIT]\r\n"
-				u8"Time:\t%02d:%02d:%02d.%03d (~1 sec.)\r\n",
+				u8"Time:\t%02d:%02d:%02d.%03d (~1 sec.)\r\n"_fmt,
 				irq::irq_t::PIT,
 				hours	% 24U,
 				minutes	% 60U,
@@ -118,8 +118,8 @@ namespace igros::arch {
 		irq::get().mask(irq::irq_t::PIT);
 
 		// Print buffer
-		klib::kprintf(
-			"IRQ #%d [PIT] installed\r\n",
+		klib::klog<klib::KLOG_LEVEL::INFO>(
+			"IRQ #%d [PIT] installed\r\n"_fmt,
 			irq::irq_t::PIT
 		);
 
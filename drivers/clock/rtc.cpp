@@ -15,7 +15,7 @@
 
 #include <drivers/clock/rtc.hpp>
 
-#include <klib/kprint.hpp>
+#include <klib/klog.hpp>
 
 
 // Arch-dependent code zone
@@ -155,8 +155,8 @@ namespace igros::arch {
 		// Get current date/time
 		auto dateTime = clockGetCurrentDateTime();
 		// Print result
-		klib::kprintf(
-			u8"RTC date/time:\t%02d.%02d.%04d %02d:%02d:%02d\r\n",
+		klib::klog<klib::KLOG_LEVEL::INFO>(
+			u8"RTC date/time:\t%02d.%02d.%04d %02d:%02d:%02d\r\n"_fmt,
 			dateTime.day,
 			dateTime.month,
 			dateTime.year,
@@ -16,7 +16,7 @@
 #include <arch/irq.hpp>
 #include <arch/register.hpp>
 
-#include <klib/kprint.hpp>
+#include <klib/klog.hpp>
 
 
 // Arch-dependent code zone
@@ -36,10 +36,10 @@ namespace igros::arch {
 		if (keyStatus & 0x01) {
 			// Read keyboard data
 			const auto keyCode = io::get().readPort8(KEYBOARD_DATA);
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::DEBUG>(
 				u8"IRQ #%d\t[Keyboard]\r\n"
 				u8"Key:\t%s\r\n"
-				u8"Code:\t0x%x\r\n",
+				u8"Code:\t0x%x\r\n"_fmt,
 				irq::irq_t::KEYBOARD,
 				(keyCode > 0x80) ? u8"RELEASED" : u8"PRESSED",
 				keyCode
@@ -58,8 +58,8 @@ namespace igros::arch {
 		// Mask Keyboard interrupts
 		irq::get().mask(irq::irq_t::KEYBOARD);
 
-		klib::kprintf(
-			u8"IRQ #%d [Keyboard] installed\r\n",
+		klib::klog<klib::KLOG_LEVEL::INFO>(
+			u8"IRQ #%d [Keyboard] installed\r\n"_fmt,
 			irq::irq_t::KEYBOARD
 		);
 
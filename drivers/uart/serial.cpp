@@ -14,13 +14,10 @@
 #pragma once
 
 
-#include <array>
-
 #include <arch/io.hpp>
 #include <arch/irq.hpp>
 
-#include <klib/kmemory.hpp>
-#include <klib/kprint.hpp>
+#include <klib/klog.hpp>
 #include <klib/kstring.hpp>
 
 #include <drivers/vga/vmem.hpp>
@@ -78,6 +75,106 @@ namespace igros::arch {
 	}
 
 
+	// Line status: received data ready
+	constexpr auto SERIAL_LSR_DATA_READY	= static_cast<byte_t>(0x01);
+	// Line status: transmitter holding register (FIFO) empty
+	constexpr auto SERIAL_LSR_THR_EMPTY	= static_cast<byte_t>(0x20);
+
+	// Interrupt enable: received data available and transmitter holding register empty
+	constexpr auto SERIAL_IER_RX_TX		= static_cast<byte_t>(0x03);
+
+	// Interrupt identification: no interrupt pending
+	constexpr auto SERIAL_IIR_NONE		= static_cast<byte_t>(0x01);
+	// Interrupt identification: interrupt source mask
+	constexpr auto SERIAL_IIR_MASK		= static_cast<byte_t>(0x0E);
+	// Interrupt identification: modem status changed
+	constexpr auto SERIAL_IIR_MODEM		= static_cast<byte_t>(0x00);
+	// Interrupt identification: transmitter holding register empty
+	constexpr auto SERIAL_IIR_THR_EMPTY	= static_cast<byte_t>(0x02);
+	// Interrupt identification: received data available
+	constexpr auto SERIAL_IIR_RX_DATA	= static_cast<byte_t>(0x04);
+	// Interrupt identification: line status changed
+	constexpr auto SERIAL_IIR_LINE		= static_cast<byte_t>(0x06);
+	// Interrupt identification: received data timeout (FIFO is not empty)
+	constexpr auto SERIAL_IIR_RX_TIMEOUT	= static_cast<byte_t>(0x0C);
+
+	// Transmit FIFO size
+	constexpr auto SERIAL_FIFO_SIZE		= 16ULL;
+	// Ring buffer size (power of 2)
+	constexpr auto SERIAL_BUFFER_SIZE	= 4096ULL;
+	// Max interrupt sources handled per IRQ
+	constexpr auto SERIAL_IRQ_LOOPS		= 8ULL;
+
+	// CPU flags interrupt enable bit
+	constexpr auto SERIAL_CPU_FLAGS_IF	= static_cast<std::size_t>(0x0200);
+
+
+	// Serial ring buffer
+	struct serialRing_t final {
+		byte_t		data[SERIAL_BUFFER_SIZE];	// Buffered data
+		dword_t		head;				// Next position to write
+		dword_t		tail;				// Next position to read
+	};
+
+	// Check buffer size
+	static_assert(0ULL == (SERIAL_BUFFER_SIZE & (SERIAL_BUFFER_SIZE - 1ULL)), "Serial buffer size should be power of 2");
+
+
+	// Transmit ring (filled by writers, drained by THR empty interrupt)
+	static serialRing_t	serialTx	{};
+	// Receive ring (filled by data ready interrupt, drained by readers)
+	static serialRing_t	serialRx	{};
+	// Serial port is interrupt-driven
+	static bool		serialAsync	{false};
+
+
+	// Put data to ring (returns stored size)
+	[[nodiscard]]
+	static std::size_t ringPut(serialRing_t &ring, const byte_t* const src, const std::size_t size) noexcept {
+		auto i = 0ULL;
+		for (; (i < size) && ((ring.head - ring.tail) < SERIAL_BUFFER_SIZE); ++i) {
+			ring.data[ring.head++ & (SERIAL_BUFFER_SIZE - 1ULL)] = src[i];
+		}
+		return i;
+	}
+
+	// Get data from ring (returns taken size)
+	[[nodiscard]]
+	static std::size_t ringGet(serialRing_t &ring, byte_t* const dst, const std::size_t size) noexcept {
+		auto i = 0ULL;
+		for (; (i < size) && (ring.head != ring.tail); ++i) {
+			dst[i] = ring.data[ring.tail++ & (SERIAL_BUFFER_SIZE - 1ULL)];
+		}
+		return i;
+	}
+
+
+	// Send next burst from transmit ring (interrupts should be disabled)
+	static void serialTransmit() noexcept {
+		// Transmitter is still busy
+		if (!serialReadyWrite()) {
+			return;
+		}
+		// Fill whole FIFO at once
+		for (auto i = 0ULL; (i < SERIAL_FIFO_SIZE) && (serialTx.head != serialTx.tail); ++i) {
+			io::get().writePort8(SERIAL_PORT_DR(SERIAL_PORT_1), serialTx.data[serialTx.tail++ & (SERIAL_BUFFER_SIZE - 1ULL)]);
+		}
+	}
+
+	// Move received data to receive ring (interrupts should be disabled)
+	[[nodiscard]]
+	static std::size_t serialReceive() noexcept {
+		// Received size
+		auto i = 0ULL;
+		while (serialReadyRead()) {
+			const auto data = io::get().readPort8(SERIAL_PORT_DR(SERIAL_PORT_1));
+			// Data is dropped on full ring
+			i += ringPut(serialRx, &data, 1ULL);
+		}
+		return i;
+	}
+
+
 	// Initialize serial port
 	[[nodiscard]]
 	bool serialInit(const BAUD_RATE baudRate, const DATA_SIZE dataSize, const STOP_BITS stopBits, const PARITY parity) noexcept {
@@ -111,8 +208,8 @@ namespace igros::arch {
 		// Check loopback
 		if (0xA5 != io::get().readPort8(SERIAL_PORT_DR(SERIAL_PORT_1))) {
 			// Debug
-			klib::kprintf(
-				"Serial Port #1:\t ERROR - not functional!\r\n"
+			klib::klog<klib::KLOG_LEVEL::ERROR>(
+				"Serial Port #1:\t ERROR - not functional!\r\n"_fmt
 			);
 			// Could not setup serial port
 			return false;
@@ -122,8 +219,8 @@ namespace igros::arch {
 		io::get().writePort8(SERIAL_PORT_MCR(SERIAL_PORT_1), 0x0F);
 
 		// Debug
-		klib::kprintf(
-			u8"Serial Port #1:\t%d %d%c%d\r\n",
+		klib::klog<klib::KLOG_LEVEL::INFO>(
+			u8"Serial Port #1:\t%d %d%c%d\r\n"_fmt,
 			static_cast<dword_t>(baudRate),
 			static_cast<dword_t>(dataSize) + 5U,
 			(parity == PARITY::NONE) ? u8'N' : u8'?',
@@ -139,27 +236,38 @@ namespace igros::arch {
 	// Is write ready?
 	[[nodiscard]]
 	bool serialReadyWrite() noexcept {
-		return 0x01 == (io::get().readPort8(SERIAL_PORT_LSR(SERIAL_PORT_1)) & 0x01);
+		return 0U != (io::get().readPort8(SERIAL_PORT_LSR(SERIAL_PORT_1)) & SERIAL_LSR_THR_EMPTY);
 	}
 
 	// Is read ready?
 	[[nodiscard]]
 	bool serialReadyRead() noexcept {
-		return 0x20 == (io::get().readPort8(SERIAL_PORT_LSR(SERIAL_PORT_1)) & 0x20);
+		return 0U != (io::get().readPort8(SERIAL_PORT_LSR(SERIAL_PORT_1)) & SERIAL_LSR_DATA_READY);
 	}
 
 
-	// Serial write
+	// Serial write (queued to transmit ring, sent right away when interrupts are unavailable)
 	[[nodiscard]]
 	std::size_t serialWrite(const byte_t* const src, const std::size_t size) noexcept {
-		// Wait for write ready
-		while (!serialReadyWrite()) {};
 		// Writed size
 		auto i = 0ULL;
-		// Write data
-		for (;(i < size) && serialReadyWrite(); ++i) {
-			// One-by-one
-			io::get().writePort8(SERIAL_PORT_DR(SERIAL_PORT_1), src[i]);
+		while (true) {
+			// Disable interrupts
+			const auto flags = irq::get().save();
+			// Queue data
+			i += ringPut(serialTx, src + i, size - i);
+			// Start transmitter (rest of the ring goes from THR empty interrupt)
+			serialTransmit();
+			// Interrupts are not set up or disabled by caller (early boot, exceptions) - whole ring should be sent
+			const auto async	= serialAsync && (0U != (flags & SERIAL_CPU_FLAGS_IF));
+			const auto done		= (i == size) && (async || (serialTx.head == serialTx.tail));
+			// Restore interrupts
+			irq::get().restore(flags);
+			if (done) {
+				break;
+			}
+			// Ring is full or output is synchronous - wait for transmitter
+			while (!serialReadyWrite()) {};
 		}
 		// Return written size
 		return i;
@@ -178,51 +286,75 @@ namespace igros::arch {
 	}
 
 
-	// Serial read
+	// Serial read (takes data from receive ring, never blocks)
 	[[nodiscard]]
 	std::size_t serialRead(byte_t* const src, const std::size_t size) noexcept {
-		// Wait for read ready
-		while (!serialReadyRead()) {};
-		// Readed size
-		auto i = 0ULL;
-		// Read data
-		for (;(i < size) && serialReadyRead(); ++i) {
-			// One-by-one
-			src[i] = io::get().readPort8(SERIAL_PORT_DR(SERIAL_PORT_1));
+		// Disable interrupts
+		arch::irqGuard guard;
+		// Poll port if data ready interrupt is not set up
+		if (!serialAsync) {
+			static_cast<void>(serialReceive());
 		}
 		// Return readed size
-		return i;
+		return ringGet(serialRx, src, size);
 	}
 
 
 	// Serial IRQ handler
 	void serialInterruptHandler(const register_t* const regs) noexcept {
 		// Check IRQ #
-		if (regs->number == static_cast<dword_t>(irq::irq_t::UART2)) {
+		if (regs->number == (IRQ_OFFSET + static_cast<dword_t>(irq::irq_t::UART2))) {
 			// Serial #2 | #4
 			// Debug data
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::DEBUG>(
 				u8"IRQ #%d\t[UART2]\r\n"
-				u8"Read:\tNOTHING!\r\n"
+				u8"Read:\tNOTHING!\r\n"_fmt,
+				irq::irq_t::UART2
 			);
 			// Interrupt done
 			//irq::get().eoi(static_cast<irq::irq_t>(regs->number));
-		} else if (regs->number == static_cast<dword_t>(irq::irq_t::UART1)) {
+		} else if (regs->number == (IRQ_OFFSET + static_cast<dword_t>(irq::irq_t::UART1))) {
 			// Serial #1 | #3
-			std::array<byte_t, 128ULL> data;
-			// Zero out
-			klib::kmemset(data.data(), data.size(), 0x00);
-			// Read from UART1
-			const auto read = serialRead(data.data(), data.size());
+			auto read = 0ULL;
+			// Handle all pending interrupt sources
+			for (auto i = 0ULL; i < SERIAL_IRQ_LOOPS; ++i) {
+				// Interrupt source
+				const auto iir = io::get().readPort8(SERIAL_PORT_IIR(SERIAL_PORT_1));
+				if (0U != (iir & SERIAL_IIR_NONE)) {
+					break;
+				}
+				switch (iir & SERIAL_IIR_MASK) {
+					// Send next burst
+					case SERIAL_IIR_THR_EMPTY:
+						serialTransmit();
+						break;
+					// Read received data
+					case SERIAL_IIR_RX_DATA:
+					case SERIAL_IIR_RX_TIMEOUT:
+						read += serialReceive();
+						break;
+					// Clear line status
+					case SERIAL_IIR_LINE:
+						static_cast<void>(io::get().readPort8(SERIAL_PORT_LSR(SERIAL_PORT_1)));
+						break;
+					// Clear modem status
+					case SERIAL_IIR_MODEM:
+					default:
+						static_cast<void>(io::get().readPort8(SERIAL_PORT_MSR(SERIAL_PORT_1)));
+						break;
+				}
+			}
 			// Debug data
-			klib::kprintf(
-				u8"IRQ #%d\t[UART1]\r\n"
-				u8"Read:\t%05d bytes = %s\r\n",
-				read,
-				reinterpret_cast<const sbyte_t* const>(data.cbegin())
-			);
+			if (0ULL != read) {
+				klib::klog<klib::KLOG_LEVEL::DEBUG>(
+					u8"IRQ #%d\t[UART1]\r\n"
+					u8"Read:\t%05d bytes\r\n"_fmt,
+					irq::irq_t::UART1,
+					static_cast<dword_t>(read)
+				);
+			}
 			// Interrupt done
-			//irq::get().eoi(static_cast<irq::irq_t>(regs->number));
+			irq::get().eoi(static_cast<irq::irq_t>(regs->number));
 		}
 	}
 
@@ -245,10 +377,21 @@ namespace igros::arch {
 		// Mask UART2 interrupts
 		irq::get().mask(irq::irq_t::UART2);
 
+		// Switch to interrupt-driven mode
+		{
+			// Disable interrupts
+			arch::irqGuard guard;
+			// Move already received data to receive ring
+			static_cast<void>(serialReceive());
+			serialAsync = true;
+			// Enable data ready and THR empty interrupts
+			io::get().writePort8(SERIAL_PORT_IER(SERIAL_PORT_1), SERIAL_IER_RX_TX);
+		}
+
 		// Debug
-		klib::kprintf(
+		klib::klog<klib::KLOG_LEVEL::INFO>(
 			u8"IRQ #%d [UART1] installed\r\n"
-			u8"IRQ #%d [UART2] installed\r\n",
+			u8"IRQ #%d [UART2] installed\r\n"_fmt,
 			irq::irq_t::UART1,
 			irq::irq_t::UART2
 		);
@@ -258,10 +401,10 @@ namespace igros::arch {
 		// Error check
 		if (res != klib::kstrlen(u8"Hello World\r\n")) {
 			// Debug
-			klib::kprintf(
-				u8"Serial Port #1:\tERROR - bad write (%d of %d bytes)",
-				res,
-				klib::kstrlen(u8"Hello World\r\n")
+			klib::klog<klib::KLOG_LEVEL::ERROR>(
+				u8"Serial Port #1:\tERROR - bad write (%d of %d bytes)"_fmt,
+				static_cast<dword_t>(res),
+				static_cast<dword_t>(klib::kstrlen(u8"Hello World\r\n"))
 			);
 		}
 
@@ -137,9 +137,7 @@ namespace igros::arch {
 			// Move cursor to the last line
 			cursorPos.y = VIDEO_MEM_HEIGHT - 1U;
 			// Move screen 1 line up
-			for (auto i = VIDEO_MEM_WIDTH; i < VIDEO_MEM_SIZE; ++i) {
-				vmemBase[i - VIDEO_MEM_WIDTH] = vmemBase[i];
-			}
+			klib::kmemmove(vmemBase, &vmemBase[VIDEO_MEM_WIDTH], (VIDEO_MEM_SIZE - VIDEO_MEM_WIDTH) * sizeof(vmemSymbol));
 			// Calculate offset in VGA console
 			const auto pos = cursorPos.y * VIDEO_MEM_WIDTH + cursorPos.x;
 			// Clear bottom line
@@ -49,6 +49,19 @@ namespace igros::arch {
 
 		// Halt CPU
 		void	halt() const noexcept;
+		// Enable interrupts and wait for interrupt (no interrupt is taken in between)
+		void	idle() const noexcept;
+
+		// Get current CPU index
+		[[nodiscard]]
+		std::size_t	index() const noexcept;
+
+		// Read time-stamp counter
+		[[nodiscard]]
+		quad_t		timestamp() const noexcept;
+
+		// Zero page (bypassing cache where possible)
+		void	zeroPage(const pointer_t page) const noexcept;
 
 		// Dump CPU registers
 		void	dumpRegisters(const register_t* const regs) const noexcept;
@@ -63,6 +76,32 @@ namespace igros::arch {
 		T::halt();
 	}
 
+	// Enable interrupts and wait for interrupt (no interrupt is taken in between)
+	template<typename T>
+	inline void cpu_t<T>::idle() const noexcept {
+		T::idle();
+	}
+
+	// Get current CPU index
+	template<typename T>
+	[[nodiscard]]
+	inline std::size_t cpu_t<T>::index() const noexcept {
+		return T::index();
+	}
+
+	// Read time-stamp counter
+	template<typename T>
+	[[nodiscard]]
+	inline quad_t cpu_t<T>::timestamp() const noexcept {
+		return T::timestamp();
+	}
+
+	// Zero page (bypassing cache where possible)
+	template<typename T>
+	inline void cpu_t<T>::zeroPage(const pointer_t page) const noexcept {
+		T::zeroPage(page);
+	}
+
 
 	// Dump CPU registers
 	template<typename T>
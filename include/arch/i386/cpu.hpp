@@ -28,6 +28,13 @@ extern "C" {
 
 	// Halt CPU
 	inline void	cpuHalt() noexcept;
+	// Read time-stamp counter
+	[[nodiscard]]
+	inline igros::quad_t	cpuTimestamp() noexcept;
+	// Enable interrupts and wait for interrupt
+	inline void	cpuIdle() noexcept;
+	// Zero page
+	inline void	cpuZeroPage(igros::pointer_t page) noexcept;
 
 
 #ifdef	__cplusplus
@@ -62,6 +69,19 @@ namespace igros::i386 {
 
 		// Halt CPU
 		static void	halt() noexcept;
+		// Enable interrupts and wait for interrupt (no interrupt is taken in between)
+		static void	idle() noexcept;
+
+		// Get current CPU index
+		[[nodiscard]]
+		static std::size_t	index() noexcept;
+
+		// Read time-stamp counter
+		[[nodiscard]]
+		static quad_t	timestamp() noexcept;
+
+		// Zero page (bypassing cache where possible)
+		static void	zeroPage(const pointer_t page) noexcept;
 
 		// Dump CPU registers
 		static void	dumpRegisters(const register_t* const regs) noexcept;
@@ -75,6 +95,29 @@ namespace igros::i386 {
 		::cpuHalt();
 	}
 
+	// Enable interrupts and wait for interrupt (no interrupt is taken in between)
+	inline void cpu::idle() noexcept {
+		::cpuIdle();
+	}
+
+	// Get current CPU index
+	[[nodiscard]]
+	inline std::size_t cpu::index() noexcept {
+		// Only bootstrap CPU is running for now
+		return 0ULL;
+	}
+
+	// Read time-stamp counter
+	[[nodiscard]]
+	inline quad_t cpu::timestamp() noexcept {
+		return ::cpuTimestamp();
+	}
+
+	// Zero page (bypassing cache where possible)
+	inline void cpu::zeroPage(const pointer_t page) noexcept {
+		::cpuZeroPage(page);
+	}
+
 
 	// Dump CPU registers
 	inline void cpu::dumpRegisters(const register_t* const regs) noexcept {
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////
+//
+//	CPUID detection
+//
+//	File:	cpuid.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <arch/i386/types.hpp>
+
+
+// i386 namespace
+namespace igros::i386 {
+
+
+	// CPUID EAX value (e.g. flag)
+	enum class cpuidFlags_t : dword_t {
+
+		// "Intel" features list
+		FEATURES_INTEL		= 0x00000000,		//
+		INFO_PROC_VERSION	= 0x00000001,		//
+		INFO_CACHE_TLB		= 0x00000002,		//
+		INFO_PENTIUM_III_SERIAL	= 0x00000003,		//
+		INFO_STRUCTURED		= 0x00000007,		// Structured extended features
+
+		// "AMD" features list
+		FEATURES_AMD		= 0x80000000,		//
+		INFO_EXTENDED		= 0x80000001		//
+
+	};
+
+
+	// CPUID registers values holder
+	struct cpuidRegs_t {
+		dword_t		eax;			// EAX register value
+		dword_t		ebx;			// EBX register value
+		dword_t		ecx;			// ECX register value
+		dword_t		edx;			// EDX register value
+	};
+
+
+#ifdef	__cplusplus
+
+	extern "C" {
+
+#endif	// __cplusplus
+
+		// Check if CPUID exists (EFLAGS.ID bit is writable)
+		[[nodiscard]]
+		bool cpuidCheck() noexcept;
+
+		// CPUID instruction call (subleaf 0)
+		[[nodiscard]]
+		cpuidRegs_t cpuid(const cpuidFlags_t flag) noexcept;
+
+#ifdef	__cplusplus
+
+	}	// extern "C"
+
+#endif	// __cplusplus
+
+
+}	// namespace igros::i386
+
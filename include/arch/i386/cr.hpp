@@ -43,6 +43,9 @@ extern "C" {
 	// Write CR4 register
 	inline void volatile	inCR4(const igros::dword_t value) noexcept;
 
+	// Invalidate TLB entry of page
+	inline void volatile	invalidatePage(const void* addr) noexcept;
+
 #ifdef	__cplusplus
 
 }	// extern "C"
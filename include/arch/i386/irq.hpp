@@ -114,6 +114,12 @@ namespace igros::i386 {
 		// Disable interrupts
 		static void disable() noexcept;
 
+		// Save interrupts state and disable interrupts
+		[[nodiscard]]
+		static std::size_t	save() noexcept;
+		// Restore interrupts state
+		static void		restore(const std::size_t flags) noexcept;
+
 		// Mask interrupt
 		static void mask(const irq_t number) noexcept;
 		// Unmask interrupt
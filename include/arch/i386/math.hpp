@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel math routines
+//
+//	File:	math.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <arch/i386/types.hpp>
+
+
+#ifdef	__cplusplus
+
+extern "C" {
+
+#endif	// __cplusplus
+
+
+	// Divide 64-bit integer by 32-bit integer with two divl (high then low dword)
+	[[nodiscard]]
+	igros::quad_t	mathDivide64(const igros::quad_t dividend, const igros::dword_t divisor, igros::dword_t* reminder) noexcept;
+
+
+#ifdef	__cplusplus
+
+}	// extern "C"
+
+#endif	// __cplusplus
+
@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////
+//
+//	Memory fill and copy routines
+//
+//	File:	memory.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <arch/i386/types.hpp>
+
+
+#ifdef	__cplusplus
+
+extern "C" {
+
+#endif	// __cplusplus
+
+
+	// Fill memory with rep stosl
+	void	memorySetRep(igros::pointer_t dst, const std::size_t size, const igros::byte_t val) noexcept;
+	// Fill memory with rep stosb (fast with ERMS)
+	void	memorySetERMS(igros::pointer_t dst, const std::size_t size, const igros::byte_t val) noexcept;
+
+	// Copy memory with rep movsl
+	void	memoryCopyRep(igros::pointer_t dst, const igros::pointer_t src, const std::size_t size) noexcept;
+	// Copy memory with rep movsb (fast with ERMS)
+	void	memoryCopyERMS(igros::pointer_t dst, const igros::pointer_t src, const std::size_t size) noexcept;
+	// Copy memory backwards with std; rep movsl (destination above overlapping source)
+	void	memoryMoveBack(igros::pointer_t dst, const igros::pointer_t src, const std::size_t size) noexcept;
+
+
+#ifdef	__cplusplus
+
+}	// extern "C"
+
+#endif	// __cplusplus
+
@@ -42,6 +42,11 @@ namespace igros::i386 {
 	constexpr auto	PAGE_DIRECTORY_SHIFT	= PAGE_SHIFT + PAGE_ENTRY_SHIFT;
 	// Page table ID shift
 	constexpr auto	PAGE_TABLE_SHIFT	= PAGE_SHIFT;
+	// Page directory/table entry physical address mask
+	constexpr auto	PAGE_ENTRY_ADDR_MASK	= ~PAGE_MASK;
+
+	// Pages invalidated one by one (whole TLB is flushed above this count)
+	constexpr auto	PAGE_INVALIDATE_LIMIT	= 32U;
 
 
 #pragma push(pack, 1)
@@ -73,8 +78,6 @@ namespace igros::i386 {
 	// Paging structure
 	class paging final {
 
-		static page_t*	mFreePages;				// Free pages list
-
 		// Copy c-tor
 		paging(const paging &other) = delete;
 		// Copy assignment
@@ -100,11 +103,46 @@ namespace igros::i386 {
 			DIRTY			= 0x00000040,
 			HUGE			= 0x00000080,
 			GLOBAL			= 0x00000100,
+			COPY_ON_WRITE		= 0x00000200,
 			USER_DEFINED		= 0x00000E00,
 			FLAGS_MASK		= PAGE_MASK,
 			PHYS_ADDR_MASK		= ~PAGE_MASK
 		};
 
+
+		// Pending TLB invalidations (flushed once at the end of multi-page update)
+		class batch final {
+
+			pointer_t	mPages[PAGE_INVALIDATE_LIMIT];	// Pending pages
+			std::size_t	mCount;				// Pending pages count
+			bool		mFull;				// Whole TLB flush required
+			bool		mGlobal;			// Global (kernel) mappings changed
+
+
+		public:
+
+			// Default c-tor
+			constexpr batch() noexcept;
+			// D-tor (pending invalidations are flushed)
+			~batch() noexcept;
+
+			// Copy c-tor
+			batch(const batch &other) = delete;
+			// Copy assignment
+			batch& operator=(const batch &other) = delete;
+
+			// Queue single TLB entry invalidation
+			void	add(const pointer_t virt) noexcept;
+			// Queue range TLB entries invalidation
+			void	add(const pointer_t virt, const std::size_t length) noexcept;
+
+			// Flush pending invalidations
+			void	flush() noexcept;
+
+
+		};
+
+
 		// Default c-tor
 		paging() = default;
 
@@ -126,8 +164,10 @@ namespace igros::i386 {
 		// Disable Page Size Extension
 		static void	disablePSE() noexcept;
 
-		// Initialize paging memory
-		static void	heap(const pointer_t phys, const std::size_t size) noexcept;
+		// Enable Page Global Extension
+		static void	enablePGE() noexcept;
+		// Disable Page Global Extension
+		static void	disablePGE() noexcept;
 
 		// Allocate page
 		[[nodiscard]]
@@ -141,6 +181,8 @@ namespace igros::i386 {
 		// Make page table
 		[[nodiscard]]
 		static table_t*		makeTable() noexcept;
+		// Destroy page directory (tables are returned to pool, mapped frames are kept)
+		static void		destroy(directory_t* const dir) noexcept;
 
 		// Check table flags
 		[[nodiscard]]
@@ -159,10 +201,38 @@ namespace igros::i386 {
 		// Map virtual page to physical page (single page)
 		static void	mapPage(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept;
 
+		// Map physical range to virtual range with biggest fitting pages (explicit page directory, false if out of page tables)
+		static bool	mapRange(directory_t* const dir, const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending = nullptr) noexcept;
+		// Map physical range to virtual range with biggest fitting pages (false if out of page tables)
+		static bool	mapRange(const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending = nullptr) noexcept;
+
+		// Unmap virtual range (explicit page directory, false if out of page tables for 4 Mb page split)
+		static bool	unmapRange(directory_t* const dir, const pointer_t virt, const std::size_t length, batch* const pending = nullptr) noexcept;
+		// Unmap virtual range (false if out of page tables for 4 Mb page split)
+		static bool	unmapRange(const pointer_t virt, const std::size_t length, batch* const pending = nullptr) noexcept;
+
+		// Invalidate TLB entry of single page
+		static void	invalidate(const pointer_t virt) noexcept;
+		// Invalidate TLB entries of range (whole TLB is flushed for big ranges)
+		static void	invalidateRange(const pointer_t virt, const std::size_t length) noexcept;
+		// Flush whole TLB (global entries too if requested)
+		static void	flushTLB(const bool global) noexcept;
+
 		// Convert virtual address to physical address
 		[[nodiscard]]
 		static pointer_t	translate(const pointer_t addr) noexcept;
 
+		// Get active page directory
+		[[nodiscard]]
+		static directory_t*	root() noexcept;
+
+		// Get 4 Kb page entry of virtual address (explicit page directory, nullptr if not mapped by 4 Kb page)
+		[[nodiscard]]
+		static dword_t*		leaf(directory_t* const dir, const pointer_t virt) noexcept;
+		// Get 4 Kb page entry of virtual address (nullptr if not mapped by 4 Kb page)
+		[[nodiscard]]
+		static dword_t*		leaf(const pointer_t virt) noexcept;
+
 		// Page Fault Exception handler
 		static void	exHandler(const register_t* regs) noexcept;
 
@@ -173,5 +243,13 @@ namespace igros::i386 {
 	};
 
 
+	// Default c-tor
+	constexpr paging::batch::batch() noexcept :
+		mPages{},
+		mCount(0U),
+		mFull(false),
+		mGlobal(false) {}
+
+
 }	// namespace igros::i386
 
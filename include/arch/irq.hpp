@@ -60,6 +60,12 @@ namespace igros::arch {
 		// Disable interrupts
 		void disable() const noexcept;
 
+		// Save interrupts state and disable interrupts
+		[[nodiscard]]
+		std::size_t	save() const noexcept;
+		// Restore interrupts state
+		void		restore(const std::size_t flags) const noexcept;
+
 		// Mask interrupt
 		void mask(const irq_t number) const noexcept;
 		// Unmask interrupt
@@ -95,6 +101,19 @@ namespace igros::arch {
 		T::disable();
 	}
 
+	// Save interrupts state and disable interrupts
+	template<typename T, typename T2>
+	[[nodiscard]]
+	inline std::size_t interrupts_t<T, T2>::save() const noexcept {
+		return T::save();
+	}
+
+	// Restore interrupts state
+	template<typename T, typename T2>
+	inline void interrupts_t<T, T2>::restore(const std::size_t flags) const noexcept {
+		T::restore(flags);
+	}
+
 
 	// Mask interrupt
 	template<typename T, typename T2>
@@ -146,15 +165,53 @@ namespace igros::arch {
 #if	defined (IGROS_ARCH_i386)
 	// IRQ type
 	using irq	= interrupts_t<i386::irq, i386::irq_t>;
+	// IRQ offset in ISR list (handlers get ISR number, not IRQ number)
+	constexpr auto IRQ_OFFSET	= i386::IRQ_OFFSET;
 #elif	defined (IGROS_ARCH_x86_64)
 	// IRQ type
 	using irq	= interrupts_t<x86_64::irq, x86_64::irq_t>;
+	// IRQ offset in ISR list (handlers get ISR number, not IRQ number)
+	constexpr auto IRQ_OFFSET	= x86_64::IRQ_OFFSET;
 #else
 	// IRQ type
 	using irq	= interrupts_t<void, void>;
+	// IRQ offset in ISR list
+	constexpr auto IRQ_OFFSET	= 0U;
 	static_assert(false, u8"Unknown architecture!!!");
 #endif
 
 
+	// Interrupts guard (disables interrupts until end of scope)
+	class irqGuard final {
+
+		std::size_t	mFlags;		// Saved interrupts state
+
+		// No copy construction
+		irqGuard(const irqGuard &other) noexcept = delete;
+		// No copy assignment
+		irqGuard& operator=(const irqGuard &other) noexcept = delete;
+
+
+	public:
+
+		// C-tor (save interrupts state and disable interrupts)
+		irqGuard() noexcept;
+		// D-tor (restore interrupts state)
+		~irqGuard() noexcept;
+
+
+	};
+
+
+	// C-tor (save interrupts state and disable interrupts)
+	inline irqGuard::irqGuard() noexcept :
+		mFlags(irq::get().save()) {}
+
+	// D-tor (restore interrupts state)
+	inline irqGuard::~irqGuard() noexcept {
+		irq::get().restore(mFlags);
+	}
+
+
 }	// namespace igros::arch
 
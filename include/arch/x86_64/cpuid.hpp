@@ -29,9 +29,11 @@ namespace igros::x86_64 {
 		INFO_PROC_VERSION	= 0x00000001,		//
 		INFO_CACHE_TLB		= 0x00000002,		//
 		INFO_PENTIUM_III_SERIAL	= 0x00000003,		//
+		INFO_STRUCTURED		= 0x00000007,		// Structured extended features
 
 		// "AMD" features list
-		FEATURES_AMD		= 0x80000000		//
+		FEATURES_AMD		= 0x80000000,		//
+		INFO_EXTENDED		= 0x80000001		//
 
 	};
 
@@ -49,9 +51,21 @@ namespace igros::x86_64 {
 	[[nodiscard]]
 	bool cpuidCheck() noexcept;
 
-	// CPUID instruction call
-	[[nodiscard]]
-	cpuidRegs_t cpuid(const cpuidFlags_t flag) noexcept;
+#ifdef	__cplusplus
+
+	extern "C" {
+
+#endif	// __cplusplus
+
+		// CPUID instruction call (subleaf 0)
+		[[nodiscard]]
+		cpuidRegs_t cpuid(const cpuidFlags_t flag) noexcept;
+
+#ifdef	__cplusplus
+
+	}	// extern "C"
+
+#endif	// __cplusplus
 
 
 }	// namespace igros::x86_64
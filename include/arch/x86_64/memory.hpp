@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////
+//
+//	Memory fill and copy routines
+//
+//	File:	memory.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <arch/x86_64/types.hpp>
+
+
+#ifdef	__cplusplus
+
+extern "C" {
+
+#endif	// __cplusplus
+
+
+	// Fill memory with rep stosq
+	void	memorySetRep(igros::pointer_t dst, const std::size_t size, const igros::byte_t val) noexcept;
+	// Fill memory with rep stosb (fast with ERMS)
+	void	memorySetERMS(igros::pointer_t dst, const std::size_t size, const igros::byte_t val) noexcept;
+	// Fill memory with SSE2 stores (16 bytes at least)
+	void	memorySetSSE2(igros::pointer_t dst, const std::size_t size, const igros::byte_t val) noexcept;
+
+	// Copy memory with rep movsq
+	void	memoryCopyRep(igros::pointer_t dst, const igros::pointer_t src, const std::size_t size) noexcept;
+	// Copy memory with rep movsb (fast with ERMS)
+	void	memoryCopyERMS(igros::pointer_t dst, const igros::pointer_t src, const std::size_t size) noexcept;
+	// Copy memory with SSE2 loads and stores (16 bytes at least)
+	void	memoryCopySSE2(igros::pointer_t dst, const igros::pointer_t src, const std::size_t size) noexcept;
+	// Copy memory backwards with std; rep movsq (destination above overlapping source)
+	void	memoryMoveBack(igros::pointer_t dst, const igros::pointer_t src, const std::size_t size) noexcept;
+
+
+#ifdef	__cplusplus
+
+}	// extern "C"
+
+#endif	// __cplusplus
+
@@ -42,6 +42,22 @@ namespace igros::x86_64 {
 	// Page mask
 	constexpr auto	PAGE_MASK			= PAGE_SIZE - 1ULL;
 
+	// Page Map Level 4 entry shift (512 Gb per entry)
+	constexpr auto	PAGE_MAP_LEVEL_4_SHIFT		= 39U;
+	// Page Directory Pointer entry shift (1 Gb per entry)
+	constexpr auto	PAGE_DIRECTORY_POINTER_SHIFT	= 30U;
+	// Page Directory entry shift (2 Mb per entry)
+	constexpr auto	PAGE_DIRECTORY_SHIFT		= 21U;
+	// Page Table entry shift (4 Kb per entry)
+	constexpr auto	PAGE_TABLE_SHIFT		= PAGE_SHIFT;
+	// Page tables entry index mask
+	constexpr auto	PAGE_ENTRY_MASK			= PAGE_TABLE_SIZE - 1ULL;
+	// Page tables entry physical address mask ([12 .. 51] bits)
+	constexpr auto	PAGE_ENTRY_ADDR_MASK		= 0x000FFFFFFFFFF000ULL;
+
+	// Pages invalidated one by one (whole TLB is flushed above this count)
+	constexpr auto	PAGE_INVALIDATE_LIMIT		= 32ULL;
+
 
 #pragma push(pack, 1)
 
@@ -86,9 +102,6 @@ namespace igros::x86_64 {
 	// Paging structure
 	class paging final {
 
-
-		static table_t*	mFreePages;		// Free pages list
-
 		// Copy c-tor
 		paging(const paging &other) = delete;
 		// Copy assignment
@@ -114,12 +127,47 @@ namespace igros::x86_64 {
 			DIRTY			= 0x0000000000000040,
 			HUGE			= 0x0000000000000080,
 			GLOBAL			= 0x0000000000000100,
+			COPY_ON_WRITE		= 0x0000000000000200,
 			USER_DEFINED		= 0x0000000000000E00,
 			NON_EXECUTABLE		= 0x8000000000000000,
 			FLAGS_MASK		= PAGE_MASK,
 			PHYS_ADDR_MASK		= ~PAGE_MASK
 		};
 
+
+		// Pending TLB invalidations (flushed once at the end of multi-page update)
+		class batch final {
+
+			pointer_t	mPages[PAGE_INVALIDATE_LIMIT];	// Pending pages
+			std::size_t	mCount;				// Pending pages count
+			bool		mFull;				// Whole TLB flush required
+			bool		mGlobal;			// Global (kernel) mappings changed
+
+
+		public:
+
+			// Default c-tor
+			constexpr batch() noexcept;
+			// D-tor (pending invalidations are flushed)
+			~batch() noexcept;
+
+			// Copy c-tor
+			batch(const batch &other) = delete;
+			// Copy assignment
+			batch& operator=(const batch &other) = delete;
+
+			// Queue single TLB entry invalidation
+			void	add(const pointer_t virt) noexcept;
+			// Queue range TLB entries invalidation
+			void	add(const pointer_t virt, const std::size_t length) noexcept;
+
+			// Flush pending invalidations
+			void	flush() noexcept;
+
+
+		};
+
+
 		// Default c-tor
 		paging() noexcept = default;
 
@@ -136,8 +184,10 @@ namespace igros::x86_64 {
 		// Disable Physical Address Extension
 		static void disablePAE() noexcept;
 
-		// Initialize paging heap
-		static void heap(const pointer_t phys, const std::size_t size) noexcept;
+		// Enable Page Global Extension
+		static void enablePGE() noexcept;
+		// Disable Page Global Extension
+		static void disablePGE() noexcept;
 
 		// Allocate page
 		[[nodiscard]]
@@ -157,6 +207,8 @@ namespace igros::x86_64 {
 		// Make page table
 		[[nodiscard]]
 		static table_t*			makeTable() noexcept;
+		// Destroy PML4 (tables are returned to pool, mapped frames are kept)
+		static void			destroy(pml4_t* const pml4) noexcept;
 
 		// Check directory pointer flags
 		[[nodiscard]]
@@ -196,10 +248,38 @@ namespace igros::x86_64 {
 		// Map virtual page to physical page (single page)
 		static void mapPage(const page_t* phys, const pointer_t virt, const kflags<FLAGS> flags) noexcept;
 
+		// Map physical range to virtual range with biggest fitting pages (explicit pml4, false if out of page tables)
+		static bool mapRange(pml4_t* const pml4, const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending = nullptr) noexcept;
+		// Map physical range to virtual range with biggest fitting pages (false if out of page tables)
+		static bool mapRange(const page_t* phys, const pointer_t virt, const std::size_t length, const kflags<FLAGS> flags, batch* const pending = nullptr) noexcept;
+
+		// Unmap virtual range (explicit pml4, false if out of page tables for huge page split)
+		static bool unmapRange(pml4_t* const pml4, const pointer_t virt, const std::size_t length, batch* const pending = nullptr) noexcept;
+		// Unmap virtual range (false if out of page tables for huge page split)
+		static bool unmapRange(const pointer_t virt, const std::size_t length, batch* const pending = nullptr) noexcept;
+
+		// Invalidate TLB entry of single page
+		static void invalidate(const pointer_t virt) noexcept;
+		// Invalidate TLB entries of range (whole TLB is flushed for big ranges)
+		static void invalidateRange(const pointer_t virt, const std::size_t length) noexcept;
+		// Flush whole TLB (global entries too if requested)
+		static void flushTLB(const bool global) noexcept;
+
 		// Convert virtual address to physical address
 		[[nodiscard]]
 		static pointer_t	translate(const pointer_t addr) noexcept;
 
+		// Get active page map level 4
+		[[nodiscard]]
+		static pml4_t*		root() noexcept;
+
+		// Get 4 Kb page entry of virtual address (explicit pml4, nullptr if not mapped by 4 Kb page)
+		[[nodiscard]]
+		static quad_t*		leaf(pml4_t* const pml4, const pointer_t virt) noexcept;
+		// Get 4 Kb page entry of virtual address (nullptr if not mapped by 4 Kb page)
+		[[nodiscard]]
+		static quad_t*		leaf(const pointer_t virt) noexcept;
+
 		// Page Fault Exception handler
 		static void exHandler(const register_t* regs) noexcept;
 
@@ -210,5 +290,13 @@ namespace igros::x86_64 {
 	};
 
 
+	// Default c-tor
+	constexpr paging::batch::batch() noexcept :
+		mPages{},
+		mCount(0ULL),
+		mFull(false),
+		mGlobal(false) {}
+
+
 }	// namespace igros::x86_64
 
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////
+//
+//	Process-context identifiers (tagged TLB entries)
+//
+//	File:	pcid.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <arch/x86_64/types.hpp>
+#include <arch/x86_64/paging.hpp>
+
+
+// x86_64 namespace
+namespace igros::x86_64 {
+
+
+	// PCID bits in CR3 ([0 .. 11] bits)
+	constexpr auto	PCID_MASK		= 0x0000000000000FFFULL;
+	// CR3 write keeps TLB entries of PCID (bit 63)
+	constexpr auto	PCID_NO_FLUSH		= 0x8000000000000000ULL;
+	// PCID 0 is kept for boot page map and non-PCID mode
+	constexpr auto	PCID_FIRST		= 1ULL;
+
+
+	// Process-context identifiers allocator
+	class pcid final {
+
+		static bool	mEnabled;		// CR4.PCIDE is set
+		static quad_t	mGeneration;		// Current PCIDs generation
+		static quad_t	mNext;			// Next free PCID of current generation
+		static quad_t	mRecycles;		// Generation changes count
+		static quad_t	mHits;			// Switches with valid PCID count
+		static quad_t	mMisses;		// Switches with new PCID count
+
+		// Drop TLB entries of all PCIDs
+		static void	flushAll() noexcept;
+
+
+	public:
+
+		// Address space tag (kept by address space owner)
+		struct tag_t final {
+			quad_t	generation	{0ULL};	// Generation PCID belongs to (0 - no PCID)
+			quad_t	id		{0ULL};	// PCID value
+		};
+
+		// Detect and enable PCID support
+		static void	init() noexcept;
+
+		// Check PCID is enabled
+		[[nodiscard]]
+		static bool	enabled() noexcept;
+
+		// Switch to page map level 4 (TLB entries are kept while tag is valid)
+		static void	switchTo(const pml4_t* const pml4, tag_t &tag) noexcept;
+		// Forget address space PCID (mappings changed while not current, next switch takes new one)
+		static void	invalidate(tag_t &tag) noexcept;
+		// Forget PCIDs of all address spaces (kernel half mapping changed, other PCIDs may still cache it)
+		static void	invalidateAll() noexcept;
+
+		// Measure ping-pong between two address spaces with tagged and plain CR3 writes (boot runs it with IGROS_BENCHMARKS only)
+		static void	benchmark(const std::size_t pages) noexcept;
+
+		// Print PCID allocator state
+		static void	print() noexcept;
+
+
+	};
+
+
+}	// namespace igros::x86_64
+
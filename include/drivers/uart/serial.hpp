@@ -73,7 +73,7 @@ namespace igros::arch {
 	[[nodiscard]]
 	bool		serialReadyRead() noexcept;
 
-	// Serial write
+	// Serial write (queued to transmit ring, sent right away when interrupts are unavailable)
 	[[nodiscard]]
 	std::size_t	serialWrite(const byte_t* const src, const std::size_t size) noexcept;
 	// Serial write
@@ -82,7 +82,7 @@ namespace igros::arch {
 	// Serial write
 	[[nodiscard]]
 	std::size_t	serialWrite(const sbyte_t* const src) noexcept;
-	// Serial read
+	// Serial read (takes data from receive ring, never blocks)
 	[[nodiscard]]
 	std::size_t	serialRead(byte_t* const src, const std::size_t size) noexcept;
 
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////
+//
+//	Compile-time format strings
+//
+//	File:	kformat.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <array>
+#include <type_traits>
+
+#include <arch/types.hpp>
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Precomputed format specifier (literal text goes before conversion)
+	struct kformatSpec_t final {
+		word_t		offset;		// Literal text offset
+		word_t		length;		// Literal text length
+		sbyte_t		type;		// Conversion symbol (u8'\0' - end of format, u8'?' - bad specifier)
+		sbyte_t		fill;		// Fill symbol
+		byte_t		width;		// Fill width
+		byte_t		size;		// Argument size in bytes (0 - no argument)
+	};
+
+
+	// Parse format string to specifiers (same syntax as kvsnprintf)
+	// Returns specifiers count with end of format specifier
+	[[nodiscard]]
+	constexpr std::size_t kformatParse(const sbyte_t* text, kformatSpec_t* specs = nullptr) noexcept {
+		// Specifiers count
+		auto count	= 0ULL;
+		// Literal text start
+		auto start	= 0ULL;
+		auto i		= 0ULL;
+		while (u8'\0' != text[i]) {
+			// Literal text
+			if (u8'%' != text[i++]) {
+				continue;
+			}
+			// Specifier defaults
+			auto spec = kformatSpec_t {static_cast<word_t>(start), static_cast<word_t>(i - 1ULL - start), u8'?', u8' ', 0U, 4U};
+			// Fill char
+			if (u8'0' == text[i]) {
+				spec.fill = u8'0';
+				++i;
+			}
+			// Fill width
+			if (	(u8'1' <= text[i])
+				&& (u8'9' >= text[i])) {
+				spec.width = static_cast<byte_t>(text[i++] - u8'0');
+			}
+			// Argument size
+			if (	(u8'l' == text[i])
+				&& (u8'l' == text[i + 1ULL])) {
+				spec.size = 8U;
+				i += 2ULL;
+			} else if (u8'h' == text[i]) {
+				if (u8'h' == text[i + 1ULL]) {
+					spec.size = 1U;
+					i += 2ULL;
+				} else {
+					spec.size = 2U;
+					++i;
+				}
+			}
+			// Conversion
+			switch (text[i]) {
+				case u8'%':
+					spec.type = text[i++];
+					spec.size = 0U;
+					break;
+				case u8'c':
+				case u8'b':
+				case u8'o':
+				case u8'd':
+				case u8'i':
+				case u8'u':
+				case u8'x':
+					spec.type = text[i++];
+					break;
+				case u8'p':
+				case u8's':
+					spec.type = text[i++];
+					spec.size = sizeof(pointer_t);
+					break;
+				case u8'z':
+					spec.type = text[i++];
+					spec.size = sizeof(std::size_t);
+					break;
+				// Bad specifier (format end is not consumed)
+				default:
+					if (u8'\0' != text[i]) {
+						++i;
+					}
+					spec.size = 0U;
+					break;
+			}
+			// Save specifier
+			if (nullptr != specs) {
+				specs[count] = spec;
+			}
+			++count;
+			start = i;
+		}
+		// End of format with trailing literal text
+		if (nullptr != specs) {
+			specs[count] = {static_cast<word_t>(start), static_cast<word_t>(i - start), u8'\0', u8' ', 0U, 0U};
+		}
+		return count + 1ULL;
+	}
+
+
+	// Check argument type matches specifier
+	template<typename T>
+	[[nodiscard]]
+	constexpr bool kformatMatch(const kformatSpec_t &spec) noexcept {
+		switch (spec.type) {
+			// Strings
+			case u8's':
+				return std::is_pointer_v<T> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, sbyte_t>;
+			// Pointers
+			case u8'p':
+				return std::is_pointer_v<T> || std::is_null_pointer_v<T>;
+			// Integers should fit specifier size
+			case u8'c':
+			case u8'b':
+			case u8'o':
+			case u8'd':
+			case u8'i':
+			case u8'u':
+			case u8'x':
+			case u8'z':
+				return (std::is_integral_v<T> || std::is_enum_v<T>) && (sizeof(T) <= spec.size);
+			// Bad specifier
+			default:
+				return false;
+		}
+	}
+
+
+	// Format string literal type
+	template<sbyte_t ...Symbols>
+	struct kformat_t final {
+
+		// Format text
+		static constexpr sbyte_t	TEXT[]		{Symbols..., u8'\0'};
+
+		// Specifiers
+		static constexpr auto		SPECS		= []() constexpr noexcept {
+			std::array<kformatSpec_t, kformatParse(TEXT)> specs {};
+			static_cast<void>(kformatParse(TEXT, specs.data()));
+			return specs;
+		}();
+
+		// Arguments count
+		static constexpr auto		ARGS		= []() constexpr noexcept {
+			auto count = 0ULL;
+			for (const auto &spec : SPECS) {
+				count += (0U != spec.size) ? 1ULL : 0ULL;
+			}
+			return count;
+		}();
+
+		// Specifier of each argument
+		static constexpr auto		ARGS_SPECS	= []() constexpr noexcept {
+			std::array<std::size_t, ARGS + 1ULL> index {};
+			auto count = 0ULL;
+			for (auto i = 0ULL; i < SPECS.size(); i++) {
+				if (0U != SPECS[i].size) {
+					index[count++] = i;
+				}
+			}
+			return index;
+		}();
+
+		// Check format is valid and arguments types match it
+		template<typename ...Args>
+		[[nodiscard]]
+		static constexpr bool check() noexcept {
+			// Bad specifiers
+			for (const auto &spec : SPECS) {
+				if (u8'?' == spec.type) {
+					return false;
+				}
+			}
+			// Arguments count
+			if (ARGS != sizeof...(Args)) {
+				return false;
+			}
+			// Arguments types
+			auto arg = 0ULL;
+			return (true && ... && kformatMatch<Args>(SPECS[ARGS_SPECS[arg++]]));
+		}
+
+	};
+
+
+	// Convert argument to formatter word
+	template<typename T>
+	[[nodiscard]]
+	inline quad_t kformatArg(const T value) noexcept {
+		if constexpr (std::is_pointer_v<T>) {
+			return reinterpret_cast<std::size_t>(value);
+		} else if constexpr (std::is_null_pointer_v<T>) {
+			return 0ULL;
+		} else if constexpr (std::is_enum_v<T>) {
+			return static_cast<quad_t>(static_cast<std::underlying_type_t<T>>(value));
+		} else {
+			return static_cast<quad_t>(value);
+		}
+	}
+
+
+	// Format with precomputed specifiers (no format parsing at runtime, output is clipped to size with null terminator)
+	void kvformat(sbyte_t* buffer, const std::size_t size, const sbyte_t* text, const kformatSpec_t* specs, const quad_t* args) noexcept;
+
+
+}	// namespace igros::klib
+
+
+// OS namespace
+namespace igros {
+
+
+	// Format string literal (u8"..."_fmt, visible from every kernel namespace)
+	template<typename T, T ...Symbols>
+	[[nodiscard]]
+	constexpr klib::kformat_t<Symbols...> operator""_fmt() noexcept {
+		return {};
+	}
+
+
+}	// namespace igros
+
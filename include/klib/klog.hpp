@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel log ring buffer
+//
+//	File:	klog.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <cstdarg>
+
+#include <arch/types.hpp>
+
+#include <klib/kformat.hpp>
+
+
+// Lowest log level compiled in (0 - debug, 1 - info, 2 - warning, 3 - error)
+#if	!defined (IGROS_LOG_LEVEL)
+#define	IGROS_LOG_LEVEL	1
+#endif
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Log records count (power of 2)
+	constexpr auto KLOG_RECORDS		= 32ULL;
+	// Log record message size
+	constexpr auto KLOG_MESSAGE_SIZE	= 1024ULL;
+
+
+	// Log levels
+	enum class KLOG_LEVEL : byte_t {
+		DEBUG	= 0x00,			// Debug information
+		INFO	= 0x01,			// Normal messages
+		WARNING	= 0x02,			// Something went wrong
+		ERROR	= 0x03			// Something failed
+	};
+
+	// Lowest log level compiled in
+	constexpr auto KLOG_MIN_LEVEL		= static_cast<KLOG_LEVEL>(IGROS_LOG_LEVEL);
+
+
+	// Log record
+	struct klogRecord_t final {
+		dword_t		sequence;			// Slot state (position when free, position + 1 when published)
+		byte_t		cpu;				// CPU index
+		KLOG_LEVEL	level;				// Log level
+		word_t		length;				// Message length
+		quad_t		timestamp;			// CPU timestamp
+		sbyte_t		message[KLOG_MESSAGE_SIZE];	// Message text
+	};
+
+
+	// Kernel log ring buffer (multiple producers, single consumer)
+	class klogRing final {
+
+		static klogRecord_t	mRecords[KLOG_RECORDS];		// Log records
+		static dword_t		mHead;				// Next position to write
+		static dword_t		mTail;				// Next position to drain
+		static dword_t		mDropped;			// Records dropped on full ring
+		static dword_t		mDeferred;			// Interrupt handlers nesting depth
+		static bool		mDraining;			// Consumer is busy
+
+		// Reserve record slot (false if ring is full)
+		[[nodiscard]]
+		static bool	reserve(dword_t &position) noexcept;
+
+		// Take record and fill its header (nullptr if ring is full)
+		[[nodiscard]]
+		static klogRecord_t*	begin(const KLOG_LEVEL level, dword_t &position) noexcept;
+		// Publish record
+		static void		end(klogRecord_t &record, const dword_t position) noexcept;
+
+
+	public:
+
+		// Format and publish log record (never blocks, false if dropped)
+		static bool	write(const KLOG_LEVEL level, const sbyte_t* format, va_list list) noexcept;
+		// Format with precomputed specifiers and publish log record (never blocks, false if dropped)
+		static bool	write(const KLOG_LEVEL level, const sbyte_t* text, const kformatSpec_t* specs, const quad_t* args) noexcept;
+		// Publish log record and output it right away unless interrupt handler is running
+		static void	print(const KLOG_LEVEL level, const sbyte_t* text, const kformatSpec_t* specs, const quad_t* args) noexcept;
+
+		// Output published records to console (false if nothing was written)
+		static bool	drain() noexcept;
+		// Check if published record waits for output
+		[[nodiscard]]
+		static bool	pending() noexcept;
+
+		// Check if console output is deferred (interrupt handler is running)
+		[[nodiscard]]
+		static bool	deferred() noexcept;
+		// Enter interrupt handler
+		static void	enter() noexcept;
+		// Leave interrupt handler
+		static void	leave() noexcept;
+
+		// Get dropped records count
+		[[nodiscard]]
+		static dword_t	dropped() noexcept;
+
+
+	};
+
+
+	// Deferred console output guard (log records are only queued until end of scope)
+	class klogDefer final {
+
+		// No copy construction
+		klogDefer(const klogDefer &other) noexcept = delete;
+		// No copy assignment
+		klogDefer& operator=(const klogDefer &other) noexcept = delete;
+
+
+	public:
+
+		// C-tor (enter deferred output)
+		klogDefer() noexcept;
+		// D-tor (leave deferred output)
+		~klogDefer() noexcept;
+
+
+	};
+
+
+	// C-tor (enter deferred output)
+	inline klogDefer::klogDefer() noexcept {
+		klogRing::enter();
+	}
+
+	// D-tor (leave deferred output)
+	inline klogDefer::~klogDefer() noexcept {
+		klogRing::leave();
+	}
+
+
+	// Kernel leveled log (format is checked at compile time, levels below KLOG_MIN_LEVEL compile to nothing)
+	template<KLOG_LEVEL LEVEL, sbyte_t ...Symbols, typename ...Args>
+	inline void klog([[maybe_unused]] const kformat_t<Symbols...> format, [[maybe_unused]] const Args ...args) noexcept {
+		// Check format
+		static_assert(kformat_t<Symbols...>::template check<Args...>(), "Log format does not match arguments");
+		// Check level
+		if constexpr (static_cast<byte_t>(LEVEL) >= static_cast<byte_t>(KLOG_MIN_LEVEL)) {
+			// Arguments as formatter words
+			const quad_t words[] {kformatArg(args)..., 0ULL};
+			// Queue and output record
+			klogRing::print(LEVEL, kformat_t<Symbols...>::TEXT, kformat_t<Symbols...>::SPECS.data(), words);
+		}
+	}
+
+
+}	// namespace igros::klib
+
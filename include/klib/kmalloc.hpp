@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel-space memory allocation
+//
+//	File:	kmalloc.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <arch/types.hpp>
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Smallest size class shift (8 bytes)
+	constexpr auto KMALLOC_MIN_SHIFT	= 3ULL;
+	// Biggest size class shift (2048 bytes)
+	constexpr auto KMALLOC_MAX_SHIFT	= 11ULL;
+	// Size classes count
+	constexpr auto KMALLOC_CLASSES		= KMALLOC_MAX_SHIFT - KMALLOC_MIN_SHIFT + 1ULL;
+	// Biggest page block shift (64 Kb, bigger allocations are reserved in kernel heap)
+	constexpr auto KMALLOC_BLOCK_SHIFT	= 16ULL;
+
+
+	// Allocate kernel memory
+	[[nodiscard]]
+	pointer_t	kmalloc(const std::size_t size, const std::size_t align = sizeof(pointer_t)) noexcept;
+	// Free kernel memory
+	void		kfree(const pointer_t ptr) noexcept;
+
+
+}	// namespace igros::klib
+
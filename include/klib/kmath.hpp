@@ -46,5 +46,44 @@ namespace igros::klib {
 	divmod_t	kdivmod(squad_t dividend, sdword_t divisor) noexcept;
 
 
+	// Divide 64-bit integer by constant 32-bit integer
+	// Returns 64-bit quotient and 64-bit reminder
+	template<dword_t D>
+	[[nodiscard]]
+	constexpr udivmod_t	kudivmod(const quad_t dividend) noexcept {
+		// Check divisor
+		static_assert(0U != D, "Division by zero");
+#if	defined (IGROS_ARCH_i386)
+		// Power of 2 divisor is shift and mask
+		if constexpr (0U == (D & (D - 1U))) {
+			return {
+				dividend >> __builtin_ctz(D),
+				dividend & (D - 1U)
+			};
+		// 16-bit divisor is done in 16-bit steps which keep every partial dividend 32-bit
+		// (constant 32-bit division is compiled to reciprocal multiplication)
+		} else if constexpr (D <= 0x0000FFFFU) {
+			const auto high	= static_cast<dword_t>(dividend >> 32);
+			const auto low	= static_cast<dword_t>(dividend);
+			const auto mid	= ((high % D) << 16) | (low >> 16);
+			const auto last	= ((mid % D) << 16) | (low & 0x0000FFFFU);
+			return {
+				(quad_t(high / D) << 32) | (quad_t(mid / D) << 16) | quad_t(last / D),
+				last % D
+			};
+		// Otherwise hardware division
+		} else {
+			return kudivmod(dividend, D);
+		}
+#elif	defined (IGROS_ARCH_x86_64)
+		// Constant 64-bit division is compiled to reciprocal multiplication
+		return {
+			dividend / D,
+			dividend % D
+		};
+#endif
+	}
+
+
 }	// namespace igros::klib
 
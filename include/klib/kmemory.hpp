@@ -28,6 +28,26 @@
 namespace igros::klib {
 
 
+	// Machine word allowed to alias any data (word-at-a-time routines)
+	using kword_t [[gnu::may_alias]]	= std::size_t;
+	// Machine word bytes mask
+	constexpr auto KWORD_MASK		= sizeof(kword_t) - 1ULL;
+	// Machine word with each byte set to 1
+	constexpr auto KWORD_ONES		= ~kword_t(0ULL) / 0xFFU;
+	// Machine word with each byte high bit set
+	constexpr auto KWORD_HIGHS		= KWORD_ONES << 7;
+
+	// Check if machine word has zero byte
+	[[nodiscard]]
+	constexpr bool kwordZero(const kword_t word) noexcept {
+		return 0ULL != ((word - KWORD_ONES) & ~word & KWORD_HIGHS);
+	}
+
+
+	// Select memory routines by CPU features (plain loops are used before)
+	void		kmemoryInit() noexcept;
+
+
 	// Set required memory with specified byte
 	[[maybe_unused]]
 	pointer_t	kmemset8(byte_t* const dst, const std::size_t size, const byte_t val) noexcept;
@@ -107,6 +127,58 @@ namespace igros::klib {
 	[[maybe_unused]]
 	pointer_t kmemcpy(pointer_t dst, const pointer_t src, const std::size_t size) noexcept;
 
+	// Move memory (ranges may overlap)
+	[[maybe_unused]]
+	pointer_t	kmemmove(pointer_t dst, const pointer_t src, const std::size_t size) noexcept;
+
+
+	// Compare memory
+	[[nodiscard]]
+	sdword_t	kmemcmp(const pointer_t lhs, const pointer_t rhs, const std::size_t size) noexcept;
+
+	// Find byte in memory (nullptr if not found)
+	[[nodiscard]]
+	pointer_t	kmemchr(const pointer_t src, const byte_t val, const std::size_t size) noexcept;
+
+	// Find byte in memory (end of memory if not found)
+	[[nodiscard]]
+	pointer_t	kmemscan(const pointer_t src, const byte_t val, const std::size_t size) noexcept;
+
+
+	// Compare memory (byte loop at compile time, word-at-a-time version at run time)
+	template<typename T, typename = std::enable_if_t<1ULL == sizeof(T)>>
+	[[nodiscard]]
+	constexpr sdword_t kmemcmp(const T* const lhs, const T* const rhs, const std::size_t size) noexcept {
+		// Run time call
+		if (!__builtin_is_constant_evaluated()) {
+			return kmemcmp(const_cast<pointer_t>(static_cast<const void*>(lhs)), const_cast<pointer_t>(static_cast<const void*>(rhs)), size);
+		}
+		// Compare byte by byte
+		for (auto i = 0ULL; i < size; i++) {
+			if (lhs[i] != rhs[i]) {
+				return static_cast<sdword_t>(static_cast<byte_t>(lhs[i])) - static_cast<sdword_t>(static_cast<byte_t>(rhs[i]));
+			}
+		}
+		return 0;
+	}
+
+	// Find byte in memory (byte loop at compile time, word-at-a-time version at run time)
+	template<typename T, typename = std::enable_if_t<1ULL == sizeof(T)>>
+	[[nodiscard]]
+	constexpr const T* kmemchr(const T* const src, const T val, const std::size_t size) noexcept {
+		// Run time call
+		if (!__builtin_is_constant_evaluated()) {
+			return static_cast<const T*>(kmemchr(const_cast<pointer_t>(static_cast<const void*>(src)), static_cast<byte_t>(val), size));
+		}
+		// Search byte by byte
+		for (auto i = 0ULL; i < size; i++) {
+			if (val == src[i]) {
+				return &src[i];
+			}
+		}
+		return nullptr;
+	}
+
 
 }	// namespace igros::klib
 
@@ -33,6 +33,9 @@ namespace igros::klib {
 	// Calculate string length
 	[[nodiscard]]
 	std::size_t	kstrlen(const sbyte_t* src) noexcept;
+	// Calculate string length (size symbols at most)
+	[[nodiscard]]
+	std::size_t	kstrnlen(const sbyte_t* src, const std::size_t size) noexcept;
 
 	// Copy string from one to other
 	[[maybe_unused]]
@@ -40,12 +43,15 @@ namespace igros::klib {
 	// Copy string from one to other (const version)
 	[[maybe_unused]]
 	const sbyte_t*	kstrcpy(const sbyte_t* src, sbyte_t* dst, std::size_t size) noexcept;
+	// Copy string from one to other (rest of dst is filled with null terminators)
+	[[maybe_unused]]
+	sbyte_t*	kstrncpy(const sbyte_t* src, sbyte_t* dst, std::size_t size) noexcept;
 
 	// Compare strings
 	[[nodiscard]]
 	sdword_t	kstrcmp(const sbyte_t* src1, const sbyte_t* src2, std::size_t size) noexcept;
 
-	// Concatenate string
+	// Concatenate string (size is whole dst buffer size, result is always null-terminated)
 	[[maybe_unused]]
 	sbyte_t*	kstrcat(const sbyte_t* src, sbyte_t* dst, std::size_t size) noexcept;
 
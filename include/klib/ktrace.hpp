@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel binary trace log
+//
+//	File:	ktrace.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <arch/types.hpp>
+#include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#include <klib/kformat.hpp>
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Max CPUs count with trace ring
+	constexpr auto KTRACE_CPUS	= 8ULL;
+	// Trace events count per CPU (power of 2)
+	constexpr auto KTRACE_EVENTS	= 128ULL;
+	// Max arguments per event
+	constexpr auto KTRACE_ARGS	= 6ULL;
+
+
+	// Trace event
+	struct ktraceEvent_t final {
+		const sbyte_t*		text;			// Format text (formatted on dump only)
+		const kformatSpec_t*	specs;			// Precomputed format specifiers
+		quad_t			timestamp;		// CPU timestamp
+		quad_t			args[KTRACE_ARGS];	// Arguments as formatter words
+		dword_t			sequence;		// Event position + 1 (0 - event was never written)
+		dword_t			count;			// Arguments count
+	};
+
+
+	// Kernel binary trace rings (one per CPU, oldest events are overwritten)
+	class ktraceRing final {
+
+		static ktraceEvent_t	mEvents[KTRACE_CPUS][KTRACE_EVENTS];	// Trace events
+		static dword_t		mHead[KTRACE_CPUS];			// Next position to write
+
+		// Loop through published events of CPU from the oldest one
+		template<typename F>
+		static void	forEach(const std::size_t cpu, F &&func) noexcept;
+
+
+	public:
+
+		// Reserve event slot on current CPU
+		[[nodiscard]]
+		static ktraceEvent_t&	reserve(dword_t &position) noexcept;
+		// Publish event
+		static void		commit(ktraceEvent_t &event, const dword_t position) noexcept;
+
+		// Print formatted events of all CPUs
+		static void	dump() noexcept;
+		// Print raw events of all CPUs (format pointers are resolved from kernel ELF by tests/ktrace-decode)
+		static void	dumpRaw() noexcept;
+
+
+	};
+
+
+	// Reserve event slot on current CPU
+	[[nodiscard]]
+	inline ktraceEvent_t& ktraceRing::reserve(dword_t &position) noexcept {
+		// Current CPU ring
+		const auto cpu = arch::cpu::get().index() & (KTRACE_CPUS - 1ULL);
+#if	defined (IGROS_ARCH_i386)
+		// i386 has no xadd (i486+), masking interrupts is enough for CPU-local ring
+		{
+			arch::irqGuard guard;
+			position = ktraceRing::mHead[cpu]++;
+		}
+#elif	defined (IGROS_ARCH_x86_64)
+		// Ring is CPU-local: single xadd can't be split by interrupt, so bus lock (about 20 cycles) is not needed
+		position = 1U;
+		asm volatile("xaddl %0, %1" : "+r"(position), "+m"(ktraceRing::mHead[cpu]));
+#endif
+		// Event slot
+		auto &event	= ktraceRing::mEvents[cpu][position & (KTRACE_EVENTS - 1ULL)];
+		// Mark slot as being written
+		__atomic_store_n(&event.sequence, 0U, __ATOMIC_RELAXED);
+		return event;
+	}
+
+	// Publish event
+	inline void ktraceRing::commit(ktraceEvent_t &event, const dword_t position) noexcept {
+		__atomic_store_n(&event.sequence, position + 1U, __ATOMIC_RELEASE);
+	}
+
+
+	// Kernel trace event (format is checked at compile time, only format, timestamp and argument words are recorded)
+	template<sbyte_t ...Symbols, typename ...Args>
+	inline void ktrace([[maybe_unused]] const kformat_t<Symbols...> format, const Args ...args) noexcept {
+		// Check format
+		static_assert(kformat_t<Symbols...>::template check<Args...>(), "Trace format does not match arguments");
+		// Check arguments fit event
+		static_assert(sizeof...(Args) <= KTRACE_ARGS, "Too many trace arguments");
+		// Take event slot
+		auto position	= 0U;
+		auto &event	= ktraceRing::reserve(position);
+		// Fill event
+		event.text	= kformat_t<Symbols...>::TEXT;
+		event.specs	= kformat_t<Symbols...>::SPECS.data();
+		event.timestamp	= arch::cpu::get().timestamp();
+		event.count	= static_cast<dword_t>(sizeof...(Args));
+		[[maybe_unused]] auto i = 0ULL;
+		((event.args[i++] = kformatArg(args)), ...);
+		// Publish event
+		ktraceRing::commit(event, position);
+	}
+
+
+}	// namespace igros::klib
+
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////
+//
+//	Bitmap physical memory allocator
+//
+//	File:	bitmap.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <mem/frame.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Bitmap word bits count
+	constexpr auto BITMAP_WORD_BITS	= sizeof(std::size_t) << 3;
+
+
+	// Bitmap physical memory allocator (1 bit per frame, set bit means free frame)
+	class bitmap final {
+
+		std::size_t*	mBits		{nullptr};	// Frames bitmap
+		std::size_t*	mSummary	{nullptr};	// Summary bitmap (1 bit per frames bitmap word with free frames)
+		std::size_t	mFirst		{0ULL};		// First frame number
+		std::size_t	mCount		{0ULL};		// Frames count
+		std::size_t	mWords		{0ULL};		// Frames bitmap words count
+		std::size_t	mFree		{0ULL};		// Free frames count
+
+		// Find first free frame starting from position
+		[[nodiscard]]
+		std::size_t	findSet(const std::size_t pos) const noexcept;
+		// Find first allocated frame in [pos, end)
+		[[nodiscard]]
+		std::size_t	findClear(const std::size_t pos, const std::size_t end) const noexcept;
+
+		// Mark frames range as free
+		void		set(const std::size_t pos, const std::size_t count) noexcept;
+		// Mark frames range as allocated
+		void		clear(const std::size_t pos, const std::size_t count) noexcept;
+
+
+	public:
+
+		// Default c-tor
+		bitmap() noexcept = default;
+
+		// Get allocator metadata size for frames span
+		[[nodiscard]]
+		static constexpr std::size_t	metadata(const range_t &span) noexcept;
+
+		// Initialize allocator
+		void	init(const range_t &span, const pointer_t storage) noexcept;
+		// Add free memory region
+		void	addRegion(const range_t &range) noexcept;
+
+		// Allocate 2^order frames
+		[[nodiscard]]
+		pointer_t	alloc(const std::size_t order) noexcept;
+		// Free 2^order frames
+		void		free(const pointer_t page, const std::size_t order) noexcept;
+
+		// Allocate contiguous frames range
+		[[nodiscard]]
+		pointer_t	allocRange(const std::size_t count, const std::size_t alignment) noexcept;
+		// Free contiguous frames range
+		void		freeRange(const pointer_t page, const std::size_t count) noexcept;
+
+		// Get free pages count
+		[[nodiscard]]
+		std::size_t	freePages() const noexcept;
+
+		// Print allocator state
+		void		print() const noexcept;
+
+
+	};
+
+
+	// Get allocator metadata size for frames span
+	[[nodiscard]]
+	constexpr std::size_t bitmap::metadata(const range_t &span) noexcept {
+		// Frames bitmap words count
+		const auto words = (span.last - span.first + BITMAP_WORD_BITS - 1ULL) / BITMAP_WORD_BITS;
+		// Frames bitmap and summary bitmap size (in bytes)
+		return (words + (words + BITMAP_WORD_BITS - 1ULL) / BITMAP_WORD_BITS) * sizeof(std::size_t);
+	}
+
+
+}	// namespace igros::mem
+
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////
+//
+//	Buddy physical memory allocator
+//
+//	File:	buddy.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <mem/frame.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Buddy physical memory allocator
+	class buddy final {
+
+		// Free block list node (placed inside free block itself)
+		struct block_t final {
+			block_t*	next;		// Next free block of the same order
+			block_t*	prev;		// Previous free block of the same order
+		};
+
+		block_t*	mFreeLists[PHYS_ORDERS]		{};		// Free blocks lists
+		std::size_t	mFreeCount[PHYS_ORDERS]		{};		// Free blocks count
+		range_t		mRegions[PHYS_MAX_REGIONS]	{};		// Not yet carved memory regions
+		std::size_t	mRegionsFirst[PHYS_MAX_REGIONS]	{};		// Memory regions first frames (before carving)
+		std::size_t	mRegionsCount			{0ULL};		// Memory regions count
+		std::size_t	mRegionsNext			{0ULL};		// Current memory region
+		std::size_t	mRegionsPages			{0ULL};		// Not yet carved pages count
+
+		// Get block by frame number
+		[[nodiscard]]
+		static block_t*	block(const std::size_t pfn) noexcept;
+
+		// Add block to free list
+		void	push(const std::size_t pfn, const std::size_t order) noexcept;
+		// Remove block from free list
+		void	remove(const std::size_t pfn, const std::size_t order) noexcept;
+
+		// Check frames range lies in allocator memory regions (frames of other zones and nodes are not touched)
+		[[nodiscard]]
+		bool	owns(std::size_t first, const std::size_t last) const noexcept;
+
+		// Release block (with buddies merge)
+		void	release(std::size_t pfn, std::size_t order) noexcept;
+		// Release frames range as naturally aligned blocks
+		void	releaseRange(std::size_t pfn, const std::size_t last) noexcept;
+		// Find run of free max order blocks (nullptr if there is none)
+		[[nodiscard]]
+		block_t*	findRun(const std::size_t blocks, const std::size_t alignment) const noexcept;
+		// Carve next free block from memory regions
+		[[nodiscard]]
+		bool	carve() noexcept;
+
+
+	public:
+
+		// Default c-tor
+		buddy() noexcept = default;
+
+		// Get allocator metadata size for frames span
+		[[nodiscard]]
+		static constexpr std::size_t	metadata(const range_t &span) noexcept;
+
+		// Initialize allocator
+		void	init(const range_t &span, const pointer_t storage) noexcept;
+		// Add free memory region (pages are carved on demand)
+		void	addRegion(const range_t &range) noexcept;
+
+		// Allocate 2^order frames
+		[[nodiscard]]
+		pointer_t	alloc(const std::size_t order) noexcept;
+		// Free 2^order frames
+		void		free(const pointer_t page, const std::size_t order) noexcept;
+
+		// Allocate exactly count contiguous frames (ranges above max order are built from free max order blocks)
+		[[nodiscard]]
+		pointer_t	allocRange(const std::size_t count, const std::size_t alignment) noexcept;
+		// Free exactly count contiguous frames
+		void		freeRange(const pointer_t page, const std::size_t count) noexcept;
+
+		// Get free pages count
+		[[nodiscard]]
+		std::size_t	freePages() const noexcept;
+
+		// Print allocator state
+		void		print() const noexcept;
+
+
+	};
+
+
+	// Get allocator metadata size for frames span
+	[[nodiscard]]
+	constexpr std::size_t buddy::metadata(const range_t&) noexcept {
+		// Buddy allocator keeps everything inside frame descriptors and free blocks
+		return 0ULL;
+	}
+
+
+}	// namespace igros::mem
+
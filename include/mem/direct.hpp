@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////
+//
+//	Physical memory direct map
+//
+//	File:	direct.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <platform.hpp>
+#include <multiboot.hpp>
+
+#include <arch/types.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Get direct map virtual address of physical address
+	[[nodiscard]]
+	inline pointer_t physToVirt(const std::size_t phys) noexcept {
+		return reinterpret_cast<pointer_t>(phys + platform::DIRECT_MAP_OFFSET());
+	}
+
+	// Get physical address of direct map (or kernel image) virtual address
+	[[nodiscard]]
+	inline std::size_t virtToPhys(const void* virt) noexcept {
+		// Virtual address
+		const auto addr = reinterpret_cast<std::size_t>(virt);
+		// Kernel image window lies above direct map
+		return addr - ((addr >= platform::KERNEL_OFFSET()) ? platform::KERNEL_OFFSET() : platform::DIRECT_MAP_OFFSET());
+	}
+
+
+	// Physical memory direct map
+	class direct final {
+
+		static std::size_t	mEnd;			// Mapped physical memory end
+		static std::size_t	mLimit;			// Physical memory end to be mapped
+
+
+	public:
+
+		// Map physical memory reported by multiboot (calling again maps what was left by lack of page tables)
+		static void	init(const multiboot::memoryMapEntry* map, const std::size_t size) noexcept;
+
+		// Get mapped physical memory end
+		[[nodiscard]]
+		static std::size_t	end() noexcept;
+		// Get physical memory end to be mapped
+		[[nodiscard]]
+		static std::size_t	limit() noexcept;
+
+		// Print direct map state
+		static void		print() noexcept;
+
+
+	};
+
+
+}	// namespace igros::mem
+
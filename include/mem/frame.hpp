@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////
+//
+//	Physical memory frames
+//
+//	File:	frame.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <arch/types.hpp>
+
+#include <mem/direct.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Default page size constant
+	constexpr auto DEFAULT_PAGE_SIZE	= 0x1000;
+	// Default page shift constant
+	constexpr auto DEFAULT_PAGE_SHIFT	= 12U;
+
+	// Max block order (2^PHYS_MAX_ORDER pages)
+	constexpr auto PHYS_MAX_ORDER		= 10ULL;
+	// Orders count
+	constexpr auto PHYS_ORDERS		= PHYS_MAX_ORDER + 1ULL;
+	// Max memory regions count
+	constexpr auto PHYS_MAX_REGIONS		= 64ULL;
+
+
+	// Physical frame state flags
+	enum class FRAME_FLAGS : word_t {
+		NONE		= 0x0000,		// Frame is not managed (reserved or absent)
+		FREE		= 0x0001,		// Frame is head of free block
+		ALLOCATED	= 0x0002,		// Frame is head of allocated block
+		CACHED		= 0x0004		// Frame is free page cached in per-CPU magazine
+	};
+
+
+	// Physical frame descriptor
+	struct frame_t final {
+		FRAME_FLAGS	flags;			// Frame state flags
+		word_t		order;			// Order of block this frame is head of
+		dword_t		refs;			// Extra mappings sharing this frame (0 - single owner)
+		pointer_t	owner;			// Frame owner (slab this frame belongs to)
+	};
+
+
+	// Frames range
+	struct range_t final {
+		std::size_t	first;			// First frame number
+		std::size_t	last;			// Frame number past the end of range
+	};
+
+
+	// Get frame number from direct map (or kernel image) address
+	[[nodiscard]]
+	inline std::size_t frameNumber(const pointer_t addr) noexcept {
+		return virtToPhys(addr) >> DEFAULT_PAGE_SHIFT;
+	}
+
+	// Get frame direct map address from frame number
+	[[nodiscard]]
+	inline pointer_t frameAddress(const std::size_t pfn) noexcept {
+		return physToVirt(pfn << DEFAULT_PAGE_SHIFT);
+	}
+
+	// Get order of the smallest block holding count frames
+	[[nodiscard]]
+	constexpr std::size_t frameOrder(const std::size_t count) noexcept {
+		// Block order
+		auto order = 0ULL;
+		// Find smallest fitting order
+		while ((1ULL << order) < count) {
+			++order;
+		}
+		// Return order
+		return order;
+	}
+
+
+}	// namespace igros::mem
+
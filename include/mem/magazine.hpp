@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////
+//
+//	Per-CPU magazine (LIFO cache of free objects)
+//
+//	File:	magazine.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <arch/types.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Max CPUs count with own magazines
+	constexpr auto MAGAZINE_CPUS		= 8ULL;
+	// Magazine capacity
+	constexpr auto MAGAZINE_SIZE		= 16ULL;
+	// Objects moved from/to global pool at once
+	constexpr auto MAGAZINE_BATCH		= MAGAZINE_SIZE >> 1;
+
+
+	// Per-CPU LIFO cache of free objects (cache line aligned to avoid false sharing)
+	class alignas(64) magazine final {
+
+		pointer_t	mItems[MAGAZINE_SIZE]	{};		// Cached objects
+		std::size_t	mCount			{0ULL};		// Cached objects count
+		std::size_t	mHits			{0ULL};		// Requests served by magazine
+		std::size_t	mMisses			{0ULL};		// Requests that touched global pool
+
+
+	public:
+
+		// Default c-tor
+		constexpr magazine() noexcept = default;
+
+		// Check if magazine is empty
+		[[nodiscard]]
+		bool		empty() const noexcept;
+		// Check if magazine is full
+		[[nodiscard]]
+		bool		full() const noexcept;
+		// Get cached objects count
+		[[nodiscard]]
+		std::size_t	count() const noexcept;
+		// Get cached object by index (index must be below count)
+		[[nodiscard]]
+		pointer_t	at(const std::size_t index) const noexcept;
+
+		// Take object
+		[[nodiscard]]
+		pointer_t	pop() noexcept;
+		// Put object
+		void		push(const pointer_t item) noexcept;
+
+		// Count request served by magazine
+		void		hit() noexcept;
+		// Count request that touched global pool
+		void		miss() noexcept;
+
+		// Get served requests count
+		[[nodiscard]]
+		std::size_t	hits() const noexcept;
+		// Get global pool requests count
+		[[nodiscard]]
+		std::size_t	misses() const noexcept;
+
+
+	};
+
+
+	// Check if magazine is empty
+	[[nodiscard]]
+	inline bool magazine::empty() const noexcept {
+		return 0ULL == mCount;
+	}
+
+	// Check if magazine is full
+	[[nodiscard]]
+	inline bool magazine::full() const noexcept {
+		return MAGAZINE_SIZE == mCount;
+	}
+
+	// Get cached objects count
+	[[nodiscard]]
+	inline std::size_t magazine::count() const noexcept {
+		return mCount;
+	}
+
+	// Get cached object by index (index must be below count)
+	[[nodiscard]]
+	inline pointer_t magazine::at(const std::size_t index) const noexcept {
+		return mItems[index];
+	}
+
+
+	// Take object
+	[[nodiscard]]
+	inline pointer_t magazine::pop() noexcept {
+		return (0ULL != mCount) ? mItems[--mCount] : nullptr;
+	}
+
+	// Put object
+	inline void magazine::push(const pointer_t item) noexcept {
+		mItems[mCount++] = item;
+	}
+
+
+	// Count request served by magazine
+	inline void magazine::hit() noexcept {
+		++mHits;
+	}
+
+	// Count request that touched global pool
+	inline void magazine::miss() noexcept {
+		++mMisses;
+	}
+
+
+	// Get served requests count
+	[[nodiscard]]
+	inline std::size_t magazine::hits() const noexcept {
+		return mHits;
+	}
+
+	// Get global pool requests count
+	[[nodiscard]]
+	inline std::size_t magazine::misses() const noexcept {
+		return mMisses;
+	}
+
+
+}	// namespace igros::mem
+
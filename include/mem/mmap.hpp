@@ -18,31 +18,152 @@
 
 #include <multiboot.hpp>
 
+#include <mem/frame.hpp>
+#include <mem/buddy.hpp>
+#include <mem/bitmap.hpp>
+#include <mem/magazine.hpp>
+#include <mem/numa.hpp>
+
 
 // Memory code zone
 namespace igros::mem {
 
 
-	// Default page size constant
-	constexpr auto DEFAULT_PAGE_SIZE = 0x1000;
+	// Physical memory allocator backend
+#if	defined (IGROS_PHYS_BITMAP)
+	using physAllocator_t = bitmap;
+#else
+	using physAllocator_t = buddy;
+#endif
+
+	// Pre-zeroed pages kept by idle time zeroing
+	constexpr auto PHYS_ZERO_POOL		= 64ULL;
+
+
+	// Physical memory zones (allocation may fall back to lower zones only)
+	enum class ZONE : dword_t {
+		DMA		= 0x00000000,		// ISA DMA memory (below 16 Mb)
+		DMA32		= 0x00000001,		// 32-bit DMA memory (below 4 Gb)
+		NORMAL		= 0x00000002		// Any memory
+	};
+
+	// Zones count
+	constexpr auto PHYS_ZONES		= 3ULL;
+	// DMA zone end frame (16 Mb)
+	constexpr auto PHYS_ZONE_DMA_END	= 0x1000000ULL >> DEFAULT_PAGE_SHIFT;
+	// DMA32 zone end frame (4 Gb)
+	constexpr auto PHYS_ZONE_DMA32_END	= 0x100000000ULL >> DEFAULT_PAGE_SHIFT;
+	// Low watermark is 1/2^PHYS_WATERMARK_SHIFT of zone pages (high watermark is twice as much)
+	constexpr auto PHYS_WATERMARK_SHIFT	= 7U;
+
+
+	// Physical memory zone of single node
+	struct zone_t final {
+		physAllocator_t	allocator	{};		// Allocator backend
+		std::size_t	pages		{0ULL};		// Managed pages count
+		std::size_t	low		{0ULL};		// Free pages kept for own zone requests
+		std::size_t	high		{0ULL};		// Free pages kept from higher zones requests
+		std::size_t	fallbacks	{0ULL};		// Higher zones requests served
+	};
 
 
 	// Phyical memory structure
 	class phys final {
 
-		// Free pages pointer
-		static pointer_t freePageList;
+		static frame_t*		mFrames;			// Frames descriptors
+		static std::size_t*	mChunks;			// Initialized frames descriptors chunks bitmap
+		static std::size_t	mFramesFirst;			// First managed frame number
+		static std::size_t	mFramesCount;			// Managed frames count
+		static std::size_t	mMapped;			// Frame past the last memory passed to allocators
+		static zone_t		mZones[NUMA_MAX_NODES][PHYS_ZONES];	// Per-node memory zones
+		static std::size_t	mFailures[PHYS_ZONES];		// Failed allocations per requested zone
+		static magazine		mPages[MAGAZINE_CPUS];		// Per-CPU free pages magazines
+		static pointer_t	mZeroed;			// Pre-zeroed pages list (linked through first word)
+		static std::size_t	mZeroedCount;			// Pre-zeroed pages count
+		static std::size_t	mZeroHits;			// Zeroed allocations served by pool
+		static std::size_t	mZeroMisses;			// Zeroed allocations zeroed in place
+		static std::size_t	mZeroPages;			// Pages zeroed in idle time
+		static std::size_t	mZeroCycles;			// Idle time zeroing TSC cycles
+
+		// Add memory region except reserved ranges
+		static void	addRegion(const range_t &range, const range_t* reserved, const std::size_t count) noexcept;
+		// Setup zones watermarks
+		static void	watermarks() noexcept;
+
+		// Get zone owning frame
+		[[nodiscard]]
+		static zone_t&		owner(const std::size_t pfn) noexcept;
+		// Allocate pages from nearest node zones allowed by watermarks
+		template<typename F>
+		[[nodiscard]]
+		static pointer_t	allocNear(const std::size_t pages, const ZONE zone, const bool reserve, F &&func) noexcept;
+
+		// Allocate single page via current CPU magazine
+		[[nodiscard]]
+		static pointer_t	allocPage() noexcept;
+		// Free single page via current CPU magazine
+		static void		freePage(const pointer_t page) noexcept;
+		// Return current CPU magazine pages to allocator
+		static void		drain() noexcept;
+		// Take page from pre-zeroed pool (nullptr if empty)
+		[[nodiscard]]
+		static pointer_t	takeZeroed() noexcept;
+		// Get node pages kept in magazines and pre-zeroed pool
+		[[nodiscard]]
+		static std::size_t	cachedPages(const std::size_t node) noexcept;
 
 
 	public:
 
-		// Initialize physical memory
+		// Initialize physical memory (only direct mapped memory is managed)
 		static void init(const multiboot::memoryMapEntry* map, const std::size_t size) noexcept;
-
-		// Allcoate physical page
-   		[[nodiscard]] static pointer_t	alloc() noexcept;
-		// Free physical page
-		static void			free(pointer_t &page) noexcept;
+		// Manage memory direct mapped after initialization
+		static void extend(const multiboot::memoryMapEntry* map, const std::size_t size) noexcept;
+
+		// Allcoate 2^order physical pages from zone (or lower ones)
+   		[[nodiscard]] static pointer_t	alloc(const std::size_t order = 0ULL, const ZONE zone = ZONE::NORMAL) noexcept;
+		// Free 2^order physical pages
+		static void			free(pointer_t &page, const std::size_t order = 0ULL) noexcept;
+
+		// Allocate zeroed physical page (pre-zeroed pool first)
+		[[nodiscard]]
+		static pointer_t	allocZeroed() noexcept;
+		// Zero single page for pool in idle time (false if nothing to do)
+		static bool		zeroIdle() noexcept;
+
+		// Allocate contiguous physical pages range
+		[[nodiscard]]
+		static pointer_t	allocRange(const std::size_t count, const std::size_t alignment = 1ULL, const ZONE zone = ZONE::NORMAL) noexcept;
+		// Free contiguous physical pages range
+		static void		freeRange(pointer_t &page, const std::size_t count) noexcept;
+
+		// Get frame descriptor by frame number (nullptr if not managed or not initialized)
+		[[nodiscard]]
+		static frame_t*		frame(const std::size_t pfn) noexcept;
+		// Initialize frames descriptors of range on first touch
+		static void		prepare(const range_t &range) noexcept;
+
+		// Take extra frame reference (frame is shared by one more mapping)
+		static void		ref(const pointer_t page) noexcept;
+		// Drop frame reference (true if caller was the last owner)
+		[[nodiscard]]
+		static bool		unref(const pointer_t page) noexcept;
+
+		// Get free pages count (pages cached in magazines and pre-zeroed pool are counted)
+		[[nodiscard]]
+		static std::size_t	freePages() noexcept;
+		// Get node free pages count (pages cached in magazines and pre-zeroed pool are not counted)
+		[[nodiscard]]
+		static std::size_t	freePages(const std::size_t node) noexcept;
+		// Get node zone free pages count
+		[[nodiscard]]
+		static std::size_t	freePages(const std::size_t node, const ZONE zone) noexcept;
+		// Get node used pages count (pages cached in magazines and pre-zeroed pool are not used)
+		[[nodiscard]]
+		static std::size_t	usedPages(const std::size_t node) noexcept;
+
+		// Print physical memory state
+		static void		print() noexcept;
 
 
 	};
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////
+//
+//	NUMA nodes topology
+//
+//	File:	numa.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <arch/types.hpp>
+
+#include <mem/magazine.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Max supported NUMA nodes count
+	constexpr auto NUMA_MAX_NODES		= 4ULL;
+	// Max memory affinity ranges count
+	constexpr auto NUMA_MAX_RANGES		= 16ULL;
+	// Distance to local node (ACPI SLIT convention)
+	constexpr auto NUMA_LOCAL_DISTANCE	= 10U;
+	// Distance to remote node when SLIT is absent
+	constexpr auto NUMA_REMOTE_DISTANCE	= 20U;
+
+
+	// Memory affinity range
+	struct numaRange_t final {
+		std::size_t	first;		// First frame number
+		std::size_t	last;		// Frame number after the last one
+		std::size_t	node;		// Node index
+	};
+
+
+	// NUMA nodes topology
+	class numa final {
+
+		static std::size_t	mNodes;						// Nodes count
+		static dword_t		mDomains[NUMA_MAX_NODES];			// Proximity domain of each node
+		static numaRange_t	mRanges[NUMA_MAX_RANGES];			// Memory ranges (sorted by address)
+		static std::size_t	mRangesCount;					// Memory ranges count
+		static byte_t		mDistance[NUMA_MAX_NODES][NUMA_MAX_NODES];	// Nodes distances
+		static std::size_t	mOrder[NUMA_MAX_NODES][NUMA_MAX_NODES];		// Nodes fallback order (nearest first)
+		static std::size_t	mCPUs[MAGAZINE_CPUS];				// Node of each CPU
+
+		// Get node index of proximity domain (new node is added if possible)
+		[[nodiscard]]
+		static std::size_t	node(const dword_t domain) noexcept;
+
+		// Parse System Resource Affinity Table
+		static void	parseSRAT() noexcept;
+		// Parse System Locality Information Table
+		static void	parseSLIT() noexcept;
+
+
+	public:
+
+		// Detect nodes (single node if ACPI has no affinity information)
+		static void	init() noexcept;
+
+		// Get nodes count
+		[[nodiscard]]
+		static std::size_t	nodes() noexcept;
+		// Get node of frame (end of the same node frames run is stored if requested)
+		[[nodiscard]]
+		static std::size_t	nodeOf(const std::size_t pfn, std::size_t* end = nullptr) noexcept;
+		// Get current CPU node
+		[[nodiscard]]
+		static std::size_t	local() noexcept;
+		// Get node to try at given fallback step (step 0 is the node itself)
+		[[nodiscard]]
+		static std::size_t	fallback(const std::size_t node, const std::size_t step) noexcept;
+		// Get distance between nodes
+		[[nodiscard]]
+		static std::size_t	distance(const std::size_t from, const std::size_t to) noexcept;
+
+		// Print nodes topology
+		static void	print() noexcept;
+
+
+	};
+
+
+}	// namespace igros::mem
+
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////////
+//
+//	Slab object cache allocator
+//
+//	File:	slab.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include <arch/types.hpp>
+
+#include <mem/frame.hpp>
+#include <mem/magazine.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Cache line size (slab coloring step)
+	constexpr auto SLAB_CACHE_LINE		= 64ULL;
+	// Max slab order (2^SLAB_MAX_ORDER pages)
+	constexpr auto SLAB_MAX_ORDER		= 3ULL;
+	// Empty slabs kept per cache before returning pages
+	constexpr auto SLAB_EMPTY_LIMIT		= 1ULL;
+
+
+	// Slab object cache
+	class cache {
+
+	public:
+
+		// Object constructor/destructor hook (objects are constructed once per slab lifetime)
+		using hook_t = void (*)(pointer_t) noexcept;
+
+
+	private:
+
+		// Slab header (placed at the start of slab pages)
+		struct slab_t final {
+			slab_t*		next;			// Next slab in list
+			slab_t*		prev;			// Previous slab in list
+			cache*		owner;			// Cache slab belongs to
+			pointer_t	freeList;		// Free objects list
+			std::size_t	inUse;			// Allocated objects count
+		};
+
+		const sbyte_t*	mName;				// Cache name
+		std::size_t	mObjectSize;			// Requested object size
+		std::size_t	mAlign;				// Object alignment
+		std::size_t	mLink;				// Free list link offset (past object data if object is constructed)
+		std::size_t	mSize;				// Object stride
+		std::size_t	mOrder;				// Slab order
+		std::size_t	mOffset;			// First object offset (after slab header)
+		std::size_t	mObjects;			// Objects per slab
+		std::size_t	mColorStep;			// Slab coloring step
+		std::size_t	mColors;			// Slab colors count
+		std::size_t	mColorNext;			// Next slab color
+		hook_t		mCtor;				// Object constructor hook
+		hook_t		mDtor;				// Object destructor hook
+		slab_t*		mPartial;			// Partially used slabs
+		slab_t*		mFull;				// Fully used slabs
+		slab_t*		mEmpty;				// Empty slabs
+		std::size_t	mSlabs;				// Slabs count
+		std::size_t	mEmptyCount;			// Empty slabs count
+		std::size_t	mInUse;				// Allocated objects count
+		cache*		mNext;				// Next registered cache
+		bool		mRegistered;			// Cache is in caches list
+		magazine	mMagazines[MAGAZINE_CPUS];	// Per-CPU free objects magazines
+
+		static cache*	mCaches;			// Registered caches list
+
+		// Align value up to power of 2
+		[[nodiscard]]
+		static constexpr std::size_t	alignUp(const std::size_t value, const std::size_t align) noexcept;
+		// Get slab order for object stride
+		[[nodiscard]]
+		static constexpr std::size_t	slabOrder(const std::size_t size, const std::size_t align) noexcept;
+		// Get slab size in bytes
+		[[nodiscard]]
+		static constexpr std::size_t	slabSize(const std::size_t order) noexcept;
+
+		// Get list slab belongs to by its usage
+		[[nodiscard]]
+		slab_t*&	list(const slab_t* slab) noexcept;
+		// Link slab to list
+		static void	link(slab_t* &head, slab_t* slab) noexcept;
+		// Unlink slab from list
+		static void	unlink(slab_t* &head, slab_t* slab) noexcept;
+
+		// Allocate new slab
+		[[nodiscard]]
+		slab_t*		grow() noexcept;
+		// Return slab pages
+		void		release(slab_t* slab) noexcept;
+
+		// Get free object list link
+		[[nodiscard]]
+		pointer_t&	next(const pointer_t object) const noexcept;
+
+		// Take object from slabs
+		[[nodiscard]]
+		pointer_t	take() noexcept;
+		// Return object to its slab
+		void		put(const pointer_t object) noexcept;
+		// Return magazine objects to slabs
+		void		drain(magazine &objects) noexcept;
+
+
+	public:
+
+		// C-tor
+		constexpr cache(const sbyte_t* name, const std::size_t size, const std::size_t align = sizeof(pointer_t), const hook_t ctor = nullptr, const hook_t dtor = nullptr) noexcept;
+
+		// Copy c-tor
+		cache(const cache &other) = delete;
+		// Copy assignment
+		cache& operator=(const cache &other) = delete;
+
+		// Allocate object
+		[[nodiscard]]
+		pointer_t	alloc() noexcept;
+		// Free object
+		void		free(const pointer_t object) noexcept;
+
+		// Return all CPUs cached objects to slabs and empty slabs pages
+		void		shrink() noexcept;
+
+		// Get object size
+		[[nodiscard]]
+		std::size_t	size() const noexcept;
+		// Get allocated objects count
+		[[nodiscard]]
+		std::size_t	inUse() const noexcept;
+
+		// Get cache object belongs to (nullptr if not a slab object)
+		[[nodiscard]]
+		static cache*	owner(const pointer_t object) noexcept;
+
+		// Print cache statistics
+		void		print() const noexcept;
+		// Print all caches statistics
+		static void	printAll() noexcept;
+
+
+	};
+
+
+	// Align value up to power of 2
+	[[nodiscard]]
+	constexpr std::size_t cache::alignUp(const std::size_t value, const std::size_t align) noexcept {
+		return (value + align - 1ULL) & ~(align - 1ULL);
+	}
+
+	// Get slab size in bytes
+	[[nodiscard]]
+	constexpr std::size_t cache::slabSize(const std::size_t order) noexcept {
+		return std::size_t(DEFAULT_PAGE_SIZE) << order;
+	}
+
+	// Get slab order for object stride
+	[[nodiscard]]
+	constexpr std::size_t cache::slabOrder(const std::size_t size, const std::size_t align) noexcept {
+		// First object offset
+		const auto offset = alignUp(sizeof(slab_t), align);
+		// Find smallest order with at most 1/8 of slab wasted
+		for (auto order = std::size_t(0ULL); order < SLAB_MAX_ORDER; order++) {
+			// Check at least one object fits
+			if (slabSize(order) < (offset + size)) {
+				continue;
+			}
+			// Slab space left after objects
+			const auto waste = (slabSize(order) - offset) % size;
+			if ((waste << 3) <= slabSize(order)) {
+				return order;
+			}
+		}
+		// Biggest slab
+		return SLAB_MAX_ORDER;
+	}
+
+
+	// C-tor
+	constexpr cache::cache(const sbyte_t* name, const std::size_t size, const std::size_t align, const hook_t ctor, const hook_t dtor) noexcept :
+		mName(name),
+		mObjectSize(size),
+		mAlign((align < sizeof(pointer_t)) ? sizeof(pointer_t) : align),
+		mLink(((nullptr != ctor) || (nullptr != dtor)) ? alignUp(size, sizeof(pointer_t)) : 0ULL),
+		mSize(alignUp((size < (mLink + sizeof(pointer_t))) ? (mLink + sizeof(pointer_t)) : size, mAlign)),
+		mOrder(slabOrder(mSize, mAlign)),
+		mOffset(alignUp(sizeof(slab_t), mAlign)),
+		mObjects((slabSize(mOrder) - mOffset) / mSize),
+		mColorStep((mAlign > SLAB_CACHE_LINE) ? mAlign : SLAB_CACHE_LINE),
+		mColors(((slabSize(mOrder) - mOffset) % mSize) / mColorStep + 1ULL),
+		mColorNext(0ULL),
+		mCtor(ctor),
+		mDtor(dtor),
+		mPartial(nullptr),
+		mFull(nullptr),
+		mEmpty(nullptr),
+		mSlabs(0ULL),
+		mEmptyCount(0ULL),
+		mInUse(0ULL),
+		mNext(nullptr),
+		mRegistered(false),
+		mMagazines{} {}
+
+
+	// Typed slab object cache
+	template<typename T>
+	class kcache final : public cache {
+
+		// Construct object in place
+		static void	construct(pointer_t object) noexcept;
+		// Destroy object in place
+		static void	destroy(pointer_t object) noexcept;
+
+
+	public:
+
+		// C-tor (T's default c-tor/d-tor are used as hooks)
+		constexpr explicit kcache(const sbyte_t* name) noexcept;
+		// C-tor (custom hooks)
+		constexpr kcache(const sbyte_t* name, const hook_t ctor, const hook_t dtor) noexcept;
+
+		// Allocate object
+		[[nodiscard]]
+		T*	alloc() noexcept;
+		// Free object
+		void	free(T* object) noexcept;
+
+
+	};
+
+
+	// Construct object in place
+	template<typename T>
+	void kcache<T>::construct(pointer_t object) noexcept {
+		::new (object) T();
+	}
+
+	// Destroy object in place
+	template<typename T>
+	void kcache<T>::destroy(pointer_t object) noexcept {
+		static_cast<T*>(object)->~T();
+	}
+
+
+	// C-tor (T's default c-tor/d-tor are used as hooks)
+	template<typename T>
+	constexpr kcache<T>::kcache(const sbyte_t* name) noexcept :
+		cache(
+			name,
+			sizeof(T),
+			alignof(T),
+			std::is_trivially_default_constructible_v<T> ? nullptr : &kcache<T>::construct,
+			std::is_trivially_destructible_v<T> ? nullptr : &kcache<T>::destroy
+		) {}
+
+	// C-tor (custom hooks)
+	template<typename T>
+	constexpr kcache<T>::kcache(const sbyte_t* name, const hook_t ctor, const hook_t dtor) noexcept :
+		cache(name, sizeof(T), alignof(T), ctor, dtor) {}
+
+
+	// Allocate object
+	template<typename T>
+	[[nodiscard]]
+	T* kcache<T>::alloc() noexcept {
+		return static_cast<T*>(cache::alloc());
+	}
+
+	// Free object
+	template<typename T>
+	void kcache<T>::free(T* object) noexcept {
+		cache::free(object);
+	}
+
+
+}	// namespace igros::mem
+
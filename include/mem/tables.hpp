@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////
+//
+//	Page tables pool
+//
+//	File:	tables.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <arch/types.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Page tables built into kernel image (used before physical memory is ready)
+	constexpr auto TABLES_BOOTSTRAP		= 16ULL;
+	// Pool is refilled when free tables count drops below this mark
+	constexpr auto TABLES_LOW_WATER		= 8ULL;
+	// Tables count taken from physical memory per refill
+	constexpr auto TABLES_BATCH		= 16ULL;
+
+
+	// Pre-zeroed page tables pool
+	class tables final {
+
+		// Free table list node (placed inside free table itself)
+		struct node_t final {
+			node_t*		next;			// Next free table
+		};
+
+		static node_t*		mFree;			// Free tables list
+		static std::size_t	mFreeCount;		// Free tables count
+		static std::size_t	mUsed;			// Allocated tables count
+		static std::size_t	mLowest;		// Lowest free tables count seen
+		static std::size_t	mRefills;		// Refills from physical memory count
+		static std::size_t	mFailures;		// Failed allocations count
+
+		// Put zeroed table to free list
+		static void	push(const pointer_t table) noexcept;
+		// Refill pool from physical memory
+		static void	refill() noexcept;
+
+
+	public:
+
+		// Initialize pool with bootstrap tables
+		static void	init() noexcept;
+
+		// Allocate zeroed table
+		[[nodiscard]]
+		static pointer_t	alloc() noexcept;
+		// Free table
+		static void		free(const pointer_t table) noexcept;
+
+		// Get free tables count
+		[[nodiscard]]
+		static std::size_t	freeTables() noexcept;
+
+		// Print pool state
+		static void		print() noexcept;
+
+
+	};
+
+
+}	// namespace igros::mem
+
@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////
+//
+//	Virtual memory areas and page fault handling
+//
+//	File:	vmm.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <flags.hpp>
+
+#include <arch/types.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Virtual memory area flags
+	enum class AREA_FLAGS : dword_t {
+		NONE		= 0x00000000,		// Nothing
+		WRITABLE	= 0x00000001,		// Area may be written
+		USER		= 0x00000002,		// Area is user accessible
+		ZERO		= 0x00000004		// Anonymous memory (zeroed frame is mapped on first touch)
+	};
+
+
+	// Virtual memory area
+	struct area_t final {
+		std::size_t		start;		// First address
+		std::size_t		end;		// Address after the last one
+		kflags<AREA_FLAGS>	flags;		// Area flags
+		area_t*			next;		// Next area (sorted by address)
+	};
+
+
+	// Address space (page tables root and its virtual memory areas list)
+	class space final {
+
+		pointer_t	mRoot	{nullptr};	// Page tables root (nullptr - active one)
+		area_t*		mAreas	{nullptr};	// Areas list (sorted by address)
+		std::size_t	mCount	{0ULL};		// Areas count
+
+
+	public:
+
+		// Default c-tor (active page tables root)
+		constexpr space() noexcept = default;
+		// Explicit page tables root c-tor
+		explicit constexpr space(const pointer_t root) noexcept : mRoot {root} {}
+
+		// Copy c-tor
+		space(const space &other) = delete;
+		// Copy assignment
+		space& operator=(const space &other) = delete;
+
+		// Get page tables root
+		[[nodiscard]]
+		pointer_t	root() const noexcept;
+		// Get areas list
+		[[nodiscard]]
+		const area_t*	areas() const noexcept;
+
+		// Find area containing address
+		[[nodiscard]]
+		const area_t*	find(const std::size_t addr) const noexcept;
+		// Find free range of given length inside [from, to) (0 if none)
+		[[nodiscard]]
+		std::size_t	gap(const std::size_t from, const std::size_t to, const std::size_t length) const noexcept;
+
+		// Add area (false if it overlaps existing one or out of memory)
+		[[nodiscard]]
+		bool		insert(const std::size_t start, const std::size_t length, const kflags<AREA_FLAGS> flags) noexcept;
+		// Remove area starting at address (returns its length, 0 if not found)
+		std::size_t	remove(const std::size_t start) noexcept;
+
+		// Print areas
+		void		print() const noexcept;
+
+
+	};
+
+
+	// Virtual memory manager
+	class vmm final {
+
+		static space		mKernel;		// Kernel address space
+		static std::size_t	mMinorFaults;		// Resolved faults count
+		static std::size_t	mFailedFaults;		// Unresolved faults count
+		static std::size_t	mSharedFaults;		// Copy-on-write faults count
+		static std::size_t	mCopiedFaults;		// Copy-on-write faults that copied frame count
+		static std::size_t	mFaultCycles;		// Resolved faults total TSC cycles
+		static std::size_t	mFaultCyclesMax;	// Slowest resolved fault TSC cycles
+
+
+		// Resolve copy-on-write fault of present page
+		[[nodiscard]]
+		static bool	copyOnWrite(const std::size_t virt) noexcept;
+		// Map zeroed frame on first touch of anonymous area
+		[[nodiscard]]
+		static bool	demandZero(const std::size_t virt, const bool write) noexcept;
+
+		// Unmap range of address space (touched frames lose reference)
+		static void	drop(const space &target, const std::size_t start, const std::size_t length) noexcept;
+		// Copy address space areas frame by frame (false if out of memory)
+		[[nodiscard]]
+		static bool	duplicate(space &dst, const space &src) noexcept;
+
+
+	public:
+
+		// Get kernel address space
+		[[nodiscard]]
+		static space&	kernel() noexcept;
+
+		// Handle page fault (false if fault can't be resolved)
+		[[nodiscard]]
+		static bool	fault(const pointer_t addr, const bool write, const bool present) noexcept;
+
+		// Reserve kernel heap range (frames are allocated on first touch)
+		[[nodiscard]]
+		static pointer_t	reserve(const std::size_t length) noexcept;
+		// Release kernel heap range (touched frames are freed)
+		static void		release(const pointer_t addr) noexcept;
+
+		// Share range between page tables roots copy-on-write (false if out of page tables)
+		[[nodiscard]]
+		static bool		share(const pointer_t dst, const pointer_t src, const std::size_t start, const std::size_t length) noexcept;
+		// Clone address space areas copy-on-write (false if out of memory)
+		[[nodiscard]]
+		static bool		clone(space &dst, const space &src) noexcept;
+		// Drop all areas of address space (page tables root stays with owner)
+		static void		destroy(space &target) noexcept;
+
+		// Compare copy-on-write clone of kernel heap range with full copy (boot runs it with IGROS_BENCHMARKS only, range stays copy-on-write)
+		static void		benchmark(const std::size_t length) noexcept;
+		// Compare batched TLB invalidation of remapped pages with whole TLB flush after every page (boot runs it with IGROS_BENCHMARKS only)
+		static void		benchmarkRemap(const std::size_t pages) noexcept;
+
+		// Check if address belongs to kernel heap
+		[[nodiscard]]
+		static bool		heap(const pointer_t addr) noexcept;
+
+		// Print page faults statistics
+		static void	print() noexcept;
+
+
+	};
+
+
+}	// namespace igros::mem
+
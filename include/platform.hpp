@@ -47,6 +47,81 @@ namespace igros::platform {
 		return (KERNEL_END() - KERNEL_START());
 	}
 
+	// Get kernel virtual memory offset
+	[[nodiscard]]
+	constexpr std::size_t KERNEL_OFFSET() noexcept {
+#if	defined (IGROS_ARCH_i386)
+		// 3Gb
+		return 0xC0000000;
+#elif	defined (IGROS_ARCH_x86_64)
+		// MAX - 2Gb
+		return 0xFFFFFFFF80000000;
+#else
+		// Unknown platform
+		return 0;
+#endif
+	}
+
+	// Get physical memory direct map virtual offset
+	[[nodiscard]]
+	constexpr std::size_t DIRECT_MAP_OFFSET() noexcept {
+#if	defined (IGROS_ARCH_i386)
+		// 3Gb (shared with kernel image)
+		return 0xC0000000;
+#elif	defined (IGROS_ARCH_x86_64)
+		// 128Tb (start of higher half)
+		return 0xFFFF800000000000;
+#else
+		// Unknown platform
+		return 0;
+#endif
+	}
+
+	// Get physical memory direct map size limit
+	[[nodiscard]]
+	constexpr std::size_t DIRECT_MAP_LIMIT() noexcept {
+#if	defined (IGROS_ARCH_i386)
+		// 896Mb (rest of kernel space is left for other mappings)
+		return 0x38000000;
+#elif	defined (IGROS_ARCH_x86_64)
+		// 64Tb
+		return 0x0000400000000000;
+#else
+		// Unknown platform
+		return 0;
+#endif
+	}
+
+	// Get kernel heap (allocate-on-fault) virtual offset
+	[[nodiscard]]
+	constexpr std::size_t HEAP_OFFSET() noexcept {
+#if	defined (IGROS_ARCH_i386)
+		// 3Gb + 896Mb (right after direct map)
+		return 0xF8000000;
+#elif	defined (IGROS_ARCH_x86_64)
+		// 192Tb (right after direct map)
+		return 0xFFFFC00000000000;
+#else
+		// Unknown platform
+		return 0;
+#endif
+	}
+
+	// Get kernel heap size limit
+	[[nodiscard]]
+	constexpr std::size_t HEAP_LIMIT() noexcept {
+#if	defined (IGROS_ARCH_i386)
+		// 124Mb (last 4Mb are left for page directory self-map)
+		return 0x07C00000;
+#elif	defined (IGROS_ARCH_x86_64)
+		// 1Tb
+		return 0x0000010000000000;
+#else
+		// Unknown platform
+		return 0;
+#endif
+	}
+
 
 	// Platform desciption structure
 	class description_t final {
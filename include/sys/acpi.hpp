@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////
+//
+//	ACPI tables lookup
+//
+//	File:	acpi.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <cstdint>
+
+#include <arch/types.hpp>
+
+
+// System code zone
+namespace igros::sys {
+
+
+#pragma pack(push, 1)
+
+
+	// Root System Description Pointer
+	struct acpiRSDP_t final {
+		sbyte_t		signature[8];		// "RSD PTR "
+		byte_t		checksum;		// ACPI 1.0 part checksum
+		sbyte_t		oemID[6];		// OEM ID
+		byte_t		revision;		// Revision (0 - ACPI 1.0, 2 - ACPI 2.0+)
+		dword_t		rsdtAddress;		// RSDT physical address
+		dword_t		length;			// Whole structure length (ACPI 2.0+)
+		quad_t		xsdtAddress;		// XSDT physical address (ACPI 2.0+)
+		byte_t		extChecksum;		// Whole structure checksum (ACPI 2.0+)
+		byte_t		reserved[3];		// Reserved
+	};
+
+	// System Description Table header
+	struct acpiHeader_t final {
+		sbyte_t		signature[4];		// Table signature
+		dword_t		length;			// Table length (with header)
+		byte_t		revision;		// Table revision
+		byte_t		checksum;		// Table checksum
+		sbyte_t		oemID[6];		// OEM ID
+		sbyte_t		oemTableID[8];		// OEM table ID
+		dword_t		oemRevision;		// OEM revision
+		dword_t		creatorID;		// Creator ID
+		dword_t		creatorRevision;	// Creator revision
+	};
+
+	// System Resource Affinity Table entry header
+	struct acpiSRATEntry_t final {
+		byte_t		type;			// Entry type
+		byte_t		length;			// Entry length
+	};
+
+	// SRAT processor local APIC affinity entry (type 0)
+	struct acpiSRATCpu_t final {
+		acpiSRATEntry_t	header;			// Entry header
+		byte_t		proximityLow;		// Proximity domain [0 .. 7] bits
+		byte_t		apicID;			// Local APIC ID
+		dword_t		flags;			// Flags (bit 0 - enabled)
+		byte_t		sapicEID;		// Local SAPIC EID
+		byte_t		proximityHigh[3];	// Proximity domain [8 .. 31] bits
+		dword_t		clockDomain;		// Clock domain
+	};
+
+	// SRAT memory affinity entry (type 1)
+	struct acpiSRATMemory_t final {
+		acpiSRATEntry_t	header;			// Entry header
+		dword_t		proximity;		// Proximity domain
+		word_t		reserved0;		// Reserved
+		quad_t		base;			// Range base address
+		quad_t		length;			// Range length
+		dword_t		reserved1;		// Reserved
+		dword_t		flags;			// Flags (bit 0 - enabled, bit 1 - hot pluggable)
+		quad_t		reserved2;		// Reserved
+	};
+
+	// SRAT processor local x2APIC affinity entry (type 2)
+	struct acpiSRATCpu2_t final {
+		acpiSRATEntry_t	header;			// Entry header
+		word_t		reserved0;		// Reserved
+		dword_t		proximity;		// Proximity domain
+		dword_t		x2apicID;		// Local x2APIC ID
+		dword_t		flags;			// Flags (bit 0 - enabled)
+		dword_t		clockDomain;		// Clock domain
+		dword_t		reserved1;		// Reserved
+	};
+
+	// System Resource Affinity Table
+	struct acpiSRAT_t final {
+		acpiHeader_t	header;			// Table header
+		dword_t		reserved0;		// Reserved (must be 1)
+		quad_t		reserved1;		// Reserved
+	};
+
+	// System Locality Information Table
+	struct acpiSLIT_t final {
+		acpiHeader_t	header;			// Table header
+		quad_t		localities;		// Localities count (followed by localities x localities distances matrix)
+	};
+
+
+#pragma pack(pop)
+
+
+	// SRAT entry types
+	enum class ACPI_SRAT_TYPE : byte_t {
+		CPU		= 0x00,			// Processor local APIC affinity
+		MEMORY		= 0x01,			// Memory affinity
+		CPU_X2APIC	= 0x02			// Processor local x2APIC affinity
+	};
+
+
+	// ACPI tables lookup
+	class acpi final {
+
+		static const acpiRSDP_t*	mRSDP;		// Root System Description Pointer
+		static const acpiHeader_t*	mRoot;		// Root table (RSDT or XSDT)
+		static bool			mExtended;	// Root table is XSDT (64-bit entries)
+
+		// Get table by physical address (nullptr if not mapped or broken)
+		[[nodiscard]]
+		static const acpiHeader_t*	map(const quad_t address) noexcept;
+		// Find RSDP in physical memory range
+		[[nodiscard]]
+		static const acpiRSDP_t*	scan(const std::size_t first, const std::size_t last) noexcept;
+
+
+	public:
+
+		// Find root tables
+		static void	init() noexcept;
+
+		// Find table by signature (nullptr if not found)
+		[[nodiscard]]
+		static const acpiHeader_t*	table(const sbyte_t* signature) noexcept;
+
+		// Print ACPI tables
+		static void	print() noexcept;
+
+
+	};
+
+
+}	// namespace igros::sys
+
@@ -0,0 +1,230 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel log ring buffer
+//
+//	File:	klog.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#include <drivers/vga/vmem.hpp>
+#include <drivers/uart/serial.hpp>
+
+#include <klib/kformat.hpp>
+#include <klib/klog.hpp>
+#include <klib/kprint.hpp>
+#include <klib/kstring.hpp>
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Record index mask
+	constexpr auto KLOG_RECORDS_MASK = static_cast<dword_t>(KLOG_RECORDS - 1ULL);
+	// Check records count
+	static_assert(0ULL == (KLOG_RECORDS & KLOG_RECORDS_MASK), "Log records count should be power of 2");
+
+
+	// Get record slot sequence
+	// (stored relative to slot index, so zeroed slot N is free for position N)
+	[[nodiscard]]
+	static dword_t sequenceGet(const klogRecord_t &record, const dword_t index) noexcept {
+		return __atomic_load_n(&record.sequence, __ATOMIC_ACQUIRE) + index;
+	}
+
+	// Set record slot sequence
+	static void sequenceSet(klogRecord_t &record, const dword_t index, const dword_t sequence) noexcept {
+		__atomic_store_n(&record.sequence, sequence - index, __ATOMIC_RELEASE);
+	}
+
+
+	// Log records
+	klogRecord_t	klogRing::mRecords[KLOG_RECORDS]	{};
+	// Next position to write
+	dword_t		klogRing::mHead				{0U};
+	// Next position to drain
+	dword_t		klogRing::mTail				{0U};
+	// Records dropped on full ring
+	dword_t		klogRing::mDropped			{0U};
+	// Interrupt handlers nesting depth
+	dword_t		klogRing::mDeferred			{0U};
+	// Consumer is busy
+	bool		klogRing::mDraining			{false};
+
+
+	// Reserve record slot (false if ring is full)
+	[[nodiscard]]
+	bool klogRing::reserve(dword_t &position) noexcept {
+#if	defined (IGROS_ARCH_i386)
+		// i386 has no xadd/cmpxchg (i486+), masking interrupts on the only CPU is enough
+		arch::irqGuard guard;
+		position = klogRing::mHead;
+		// Slot is not drained yet
+		if (position != sequenceGet(klogRing::mRecords[position & KLOG_RECORDS_MASK], position & KLOG_RECORDS_MASK)) {
+			++klogRing::mDropped;
+			return false;
+		}
+		++klogRing::mHead;
+		return true;
+#elif	defined (IGROS_ARCH_x86_64)
+		position = __atomic_load_n(&klogRing::mHead, __ATOMIC_RELAXED);
+		while (true) {
+			const auto index	= position & KLOG_RECORDS_MASK;
+			const auto diff		= static_cast<sdword_t>(sequenceGet(klogRing::mRecords[index], index) - position);
+			// Slot is free - try to take position
+			if (0 == diff) {
+				if (__atomic_compare_exchange_n(&klogRing::mHead, &position, position + 1U, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+					return true;
+				}
+			// Slot is not drained yet
+			} else if (diff < 0) {
+				__atomic_fetch_add(&klogRing::mDropped, 1U, __ATOMIC_RELAXED);
+				return false;
+			// Other producer took position
+			} else {
+				position = __atomic_load_n(&klogRing::mHead, __ATOMIC_RELAXED);
+			}
+		}
+#endif
+	}
+
+
+	// Take record and fill its header (nullptr if ring is full)
+	[[nodiscard]]
+	klogRecord_t* klogRing::begin(const KLOG_LEVEL level, dword_t &position) noexcept {
+		if (!klogRing::reserve(position)) {
+			// Interrupt handlers just drop record, others make room first
+			if (	klogRing::deferred()
+				|| !klogRing::drain()
+				|| !klogRing::reserve(position)) {
+				return nullptr;
+			}
+		}
+		// Fill record right in its slot
+		auto &record		= klogRing::mRecords[position & KLOG_RECORDS_MASK];
+		record.cpu		= static_cast<byte_t>(arch::cpu::get().index());
+		record.level		= level;
+		record.timestamp	= arch::cpu::get().timestamp();
+		return &record;
+	}
+
+	// Publish record
+	void klogRing::end(klogRecord_t &record, const dword_t position) noexcept {
+		record.length = static_cast<word_t>(kstrlen(record.message));
+		sequenceSet(record, position & KLOG_RECORDS_MASK, position + 1U);
+	}
+
+
+	// Format and publish log record (never blocks, false if dropped)
+	bool klogRing::write(const KLOG_LEVEL level, const sbyte_t* format, va_list list) noexcept {
+		// Record position
+		auto position		= 0U;
+		const auto record	= klogRing::begin(level, position);
+		if (nullptr == record) {
+			return false;
+		}
+		// Format message
+		kvsnprintf(record->message, KLOG_MESSAGE_SIZE, format, list);
+		klogRing::end(*record, position);
+		return true;
+	}
+
+	// Format with precomputed specifiers and publish log record (never blocks, false if dropped)
+	bool klogRing::write(const KLOG_LEVEL level, const sbyte_t* text, const kformatSpec_t* specs, const quad_t* args) noexcept {
+		// Record position
+		auto position		= 0U;
+		const auto record	= klogRing::begin(level, position);
+		if (nullptr == record) {
+			return false;
+		}
+		// Format message
+		kvformat(record->message, KLOG_MESSAGE_SIZE, text, specs, args);
+		klogRing::end(*record, position);
+		return true;
+	}
+
+
+	// Publish log record and output it right away unless interrupt handler is running
+	void klogRing::print(const KLOG_LEVEL level, const sbyte_t* text, const kformatSpec_t* specs, const quad_t* args) noexcept {
+		// Queue record
+		klogRing::write(level, text, specs, args);
+		// Output right away unless interrupt handler is running
+		if (!klogRing::deferred()) {
+			klogRing::drain();
+		}
+	}
+
+
+	// Output published records to console (false if nothing was written)
+	bool klogRing::drain() noexcept {
+		// Only one consumer at a time
+		if (__atomic_exchange_n(&klogRing::mDraining, true, __ATOMIC_ACQUIRE)) {
+			return false;
+		}
+		// Loop through published records in order
+		auto written = false;
+		while (true) {
+			const auto index	= klogRing::mTail & KLOG_RECORDS_MASK;
+			auto &record		= klogRing::mRecords[index];
+			// Record is not published yet
+			if ((klogRing::mTail + 1U) != sequenceGet(record, index)) {
+				break;
+			}
+			// Output record
+			arch::vmemWrite(record.message);
+			arch::vmemWrite(u8"\r\n");
+			arch::serialWrite(record.message);
+			arch::serialWrite(u8"\r\n");
+			// Free slot for next lap
+			sequenceSet(record, index, klogRing::mTail + static_cast<dword_t>(KLOG_RECORDS));
+			++klogRing::mTail;
+			written = true;
+		}
+		// Release consumer
+		__atomic_store_n(&klogRing::mDraining, false, __ATOMIC_RELEASE);
+		return written;
+	}
+
+
+	// Check if published record waits for output
+	[[nodiscard]]
+	bool klogRing::pending() noexcept {
+		const auto index = klogRing::mTail & KLOG_RECORDS_MASK;
+		return (klogRing::mTail + 1U) == sequenceGet(klogRing::mRecords[index], index);
+	}
+
+
+	// Check if console output is deferred (interrupt handler is running)
+	[[nodiscard]]
+	bool klogRing::deferred() noexcept {
+		return 0U != klogRing::mDeferred;
+	}
+
+	// Enter interrupt handler
+	void klogRing::enter() noexcept {
+		++klogRing::mDeferred;
+	}
+
+	// Leave interrupt handler
+	void klogRing::leave() noexcept {
+		--klogRing::mDeferred;
+	}
+
+
+	// Get dropped records count
+	[[nodiscard]]
+	dword_t klogRing::dropped() noexcept {
+		return __atomic_load_n(&klogRing::mDropped, __ATOMIC_RELAXED);
+	}
+
+
+}	// namespace igros::klib
+
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel-space memory allocation
+//
+//	File:	kmalloc.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <klib/kmalloc.hpp>
+
+#include <mem/mmap.hpp>
+#include <mem/slab.hpp>
+#include <mem/vmm.hpp>
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Size classes caches (small classes are naturally aligned, bigger ones - to cache line)
+	static mem::cache kmallocCaches[KMALLOC_CLASSES] {
+		{u8"kmalloc-8",		8ULL,		8ULL},
+		{u8"kmalloc-16",	16ULL,		16ULL},
+		{u8"kmalloc-32",	32ULL,		32ULL},
+		{u8"kmalloc-64",	64ULL,		64ULL},
+		{u8"kmalloc-128",	128ULL,		mem::SLAB_CACHE_LINE},
+		{u8"kmalloc-256",	256ULL,		mem::SLAB_CACHE_LINE},
+		{u8"kmalloc-512",	512ULL,		mem::SLAB_CACHE_LINE},
+		{u8"kmalloc-1024",	1024ULL,	mem::SLAB_CACHE_LINE},
+		{u8"kmalloc-2048",	2048ULL,	mem::SLAB_CACHE_LINE}
+	};
+
+
+	// Allocate kernel memory
+	[[nodiscard]]
+	pointer_t kmalloc(const std::size_t size, const std::size_t align) noexcept {
+		// Error check
+		if (0ULL == size) {
+			return nullptr;
+		}
+		// Size class must satisfy both size and alignment
+		const auto needed = (size > align) ? size : align;
+		// Small allocations go to size classes caches
+		if (	(align <= mem::SLAB_CACHE_LINE)
+			&& (needed <= (1ULL << KMALLOC_MAX_SHIFT))) {
+			// Size class order
+			const auto order = mem::frameOrder(needed);
+			// Allocate from size class cache
+			return kmallocCaches[(order > KMALLOC_MIN_SHIFT) ? (order - KMALLOC_MIN_SHIFT) : 0ULL].alloc();
+		}
+		// Huge allocations are reserved in kernel heap (frames are taken on first touch)
+		if (	(align <= mem::DEFAULT_PAGE_SIZE)
+			&& (needed > (1ULL << KMALLOC_BLOCK_SHIFT))) {
+			return mem::vmm::reserve(needed);
+		}
+		// Big allocations are served by naturally aligned page blocks
+		return mem::phys::alloc(mem::frameOrder((needed + mem::DEFAULT_PAGE_SIZE - 1ULL) >> mem::DEFAULT_PAGE_SHIFT));
+	}
+
+	// Free kernel memory
+	void kfree(const pointer_t ptr) noexcept {
+		// Error check
+		if (nullptr == ptr) {
+			return;
+		}
+		// Kernel heap range goes back to virtual memory manager
+		if (mem::vmm::heap(ptr)) {
+			mem::vmm::release(ptr);
+			return;
+		}
+		// Slab object goes back to its cache
+		const auto owner = mem::cache::owner(ptr);
+		if (nullptr != owner) {
+			owner->free(ptr);
+			return;
+		}
+		// Page block order is kept in its head frame
+		const auto frame = mem::phys::frame(mem::frameNumber(ptr));
+		if (nullptr == frame) {
+			return;
+		}
+		// Return page block
+		auto page = ptr;
+		mem::phys::free(page, frame->order);
+	}
+
+
+}	// namespace igros::klib
+
@@ -13,6 +13,10 @@
 
 #include <klib/kmath.hpp>
 
+#if	defined (IGROS_ARCH_i386)
+#include <arch/i386/math.hpp>
+#endif
+
 
 // Kernel library code zone
 namespace igros::klib {
@@ -24,71 +28,34 @@ namespace igros::klib {
 	// Returns 64-bit quotient and 64-bit reminder
 	[[nodiscard]]
 	udivmod_t kudivmod(quad_t dividend, dword_t divisor) noexcept {
-
-		// Division result
-		udivmod_t	res	= {0ULL, dividend};
-		// Quotient bit
-		quad_t		qbit	= 1ULL;
-
-		// Division by 0
-		if (0 == divisor) {
-			res.quotient = (1 / divisor);
-			res.reminder = 0ULL;
-			return res;
-		}
-
-		while (0 <= static_cast<sdword_t>(divisor)) {
-			divisor <<= 1ULL;
-			qbit	<<= 1ULL;
-		}
-
-		while (qbit) {
-			if (res.reminder >= divisor) {
-				res.reminder -= divisor;
-				res.quotient |= qbit;
-			}
-			divisor	>>= 1ULL;
-			qbit	>>= 1ULL;
-		}
-
-		return res;
-
+		// Division reminder
+		auto reminder		= 0U;
+		// Hardware division of high then low dword (#DE on zero divisor)
+		const auto quotient	= ::mathDivide64(dividend, divisor, &reminder);
+		return {
+			quotient,
+			reminder
+		};
 	}
 
 
         // Divide 64-bit integer by 32-bit integer
 	// Returns 64-bit quotient and 64-bit reminder
 	[[nodiscard]]
-	divmod_t kdivmod(squad_t dividend, dword_t divisor) noexcept {
-
-		// Division result
-		divmod_t	res	= {0LL, dividend};
-		// Quotient bit
-		squad_t		qbit	= 1LL;
-
-		// Division by 0
-		if (0 == divisor) {
-			res.quotient = (1 / divisor);
-			res.reminder = 0LL;
-			return res;
-		}
-
-		while (0 <= divisor) {
-			divisor <<= 1LL;
-			qbit	<<= 1LL;
-		}
-
-		while (qbit) {
-			if (res.reminder >= divisor) {
-				res.reminder -= divisor;
-				res.quotient |= qbit;
-			}
-			divisor	>>= 1LL;
-			qbit	>>= 1LL;
-		}
-
-		return res;
-
+	divmod_t kdivmod(squad_t dividend, sdword_t divisor) noexcept {
+		// Signs of operands
+		const auto negativeDividend	= (dividend < 0);
+		const auto negativeDivisor	= (divisor < 0);
+		// Divide absolute values (unsigned negation works for the smallest values too)
+		const auto res = kudivmod(
+			negativeDividend	? (~static_cast<quad_t>(dividend) + 1ULL)	: static_cast<quad_t>(dividend),
+			negativeDivisor		? (~static_cast<dword_t>(divisor) + 1U)		: static_cast<dword_t>(divisor)
+		);
+		// Quotient is truncated toward zero and reminder has dividend sign
+		return {
+			static_cast<squad_t>((negativeDividend != negativeDivisor)	? (~res.quotient + 1ULL) : res.quotient),
+			static_cast<squad_t>(negativeDividend				? (~res.reminder + 1ULL) : res.reminder)
+		};
 	}
 
 
@@ -13,11 +13,109 @@
 
 #include <klib/kmemory.hpp>
 
+#if	defined (IGROS_ARCH_i386)
+#include <arch/i386/cpuid.hpp>
+#include <arch/i386/memory.hpp>
+#elif	defined (IGROS_ARCH_x86_64)
+#include <arch/x86_64/cpuid.hpp>
+#include <arch/x86_64/cr.hpp>
+#include <arch/x86_64/memory.hpp>
+#endif
+
 
 // Kernel library code zone
 namespace igros::klib {
 
 
+	// Blocks smaller than this are handled by plain loops
+	constexpr auto KMEMORY_TINY		= 16ULL;
+	// Blocks of this size and bigger are handled by string instructions
+	constexpr auto KMEMORY_LARGE		= 1024ULL;
+
+	// CPUID leaf 7 EBX enhanced rep movsb/stosb bit
+	constexpr auto KMEMORY_CPUID_ERMS	= 0x00000200U;
+	// CPUID leaf 7 EDX fast short rep movsb bit
+	constexpr auto KMEMORY_CPUID_FSRM	= 0x00000010U;
+
+#if	defined (IGROS_ARCH_x86_64)
+	// CR0 FPU emulation bit
+	constexpr auto KMEMORY_CR0_EM		= 0x0000000000000004ULL;
+	// CR0 monitor coprocessor bit
+	constexpr auto KMEMORY_CR0_MP		= 0x0000000000000002ULL;
+	// CR4 OSFXSR and OSXMMEXCPT bits
+	constexpr auto KMEMORY_CR4_SSE		= 0x0000000000000600ULL;
+#endif
+
+
+	// Memory fill routine
+	using kmemsetFunc_t = void (*)(pointer_t, const std::size_t, const byte_t) noexcept;
+	// Memory copy routine
+	using kmemcpyFunc_t = void (*)(pointer_t, const pointer_t, const std::size_t) noexcept;
+
+
+	// Fill memory byte by byte
+	static void kmemsetLoop(pointer_t dst, const std::size_t size, const byte_t val) noexcept {
+		for (auto i = 0ULL; i < size; i++) {
+			static_cast<byte_t*>(dst)[i] = val;
+		}
+	}
+
+	// Copy memory byte by byte
+	static void kmemcpyLoop(pointer_t dst, const pointer_t src, const std::size_t size) noexcept {
+		for (auto i = 0ULL; i < size; i++) {
+			static_cast<byte_t*>(dst)[i] = static_cast<const byte_t*>(src)[i];
+		}
+	}
+
+
+	// Memory routines for small and large blocks (plain loops until kmemoryInit)
+	static kmemsetFunc_t	kmemsetSmall	{kmemsetLoop};
+	static kmemsetFunc_t	kmemsetLarge	{kmemsetLoop};
+	static kmemcpyFunc_t	kmemcpySmall	{kmemcpyLoop};
+	static kmemcpyFunc_t	kmemcpyLarge	{kmemcpyLoop};
+
+
+	// Select memory routines by CPU features
+	void kmemoryInit() noexcept {
+#if	defined (IGROS_ARCH_i386)
+		// String instructions are always there
+		kmemsetSmall	= memorySetRep;
+		kmemsetLarge	= memorySetRep;
+		kmemcpySmall	= memoryCopyRep;
+		kmemcpyLarge	= memoryCopyRep;
+		// Structured extended features need CPUID leaf 7
+		if (	!i386::cpuidCheck()
+			|| (i386::cpuid(i386::cpuidFlags_t::FEATURES_INTEL).eax < static_cast<dword_t>(i386::cpuidFlags_t::INFO_STRUCTURED))) {
+			return;
+		}
+		const auto features = i386::cpuid(i386::cpuidFlags_t::INFO_STRUCTURED);
+#elif	defined (IGROS_ARCH_x86_64)
+		// SSE2 is always there (kernel code is built without SSE, so only these routines touch XMM registers)
+		// Allow SSE instructions (no FPU emulation, FXSAVE/FXRSTOR and SIMD exceptions support)
+		inCR0((outCR0() & ~KMEMORY_CR0_EM) | KMEMORY_CR0_MP);
+		inCR4(outCR4() | KMEMORY_CR4_SSE);
+		kmemsetSmall	= memorySetSSE2;
+		kmemsetLarge	= memorySetRep;
+		kmemcpySmall	= memoryCopySSE2;
+		kmemcpyLarge	= memoryCopyRep;
+		// Structured extended features need CPUID leaf 7
+		if (x86_64::cpuid(x86_64::cpuidFlags_t::FEATURES_INTEL).eax < static_cast<dword_t>(x86_64::cpuidFlags_t::INFO_STRUCTURED)) {
+			return;
+		}
+		const auto features = x86_64::cpuid(x86_64::cpuidFlags_t::INFO_STRUCTURED);
+#endif
+		// Enhanced rep movsb/stosb beat wide string instructions on large blocks
+		if (0U != (features.ebx & KMEMORY_CPUID_ERMS)) {
+			kmemsetLarge	= memorySetERMS;
+			kmemcpyLarge	= memoryCopyERMS;
+		}
+		// Fast short rep movsb beats everything on small copies
+		if (0U != (features.edx & KMEMORY_CPUID_FSRM)) {
+			kmemcpySmall	= memoryCopyERMS;
+		}
+	}
+
+
 	// Set required memory with specified byte
 	[[maybe_unused]]
 	pointer_t kmemset8(byte_t* dst, const std::size_t size, const byte_t val) noexcept {
@@ -25,9 +123,13 @@ namespace igros::klib {
 		if (nullptr == dst || 0ULL == size) {
 			return nullptr;
 		}
-		// Do actual memset
-		for (auto i = 0ULL; i < size; i++) {
-			dst[i] = val;
+		// Do actual memset with routine fitting size
+		if (size < KMEMORY_TINY) {
+			kmemsetLoop(dst, size, val);
+		} else if (size < KMEMORY_LARGE) {
+			kmemsetSmall(dst, size, val);
+		} else {
+			kmemsetLarge(dst, size, val);
 		}
 		// Return pointer to dst
 		return dst;
@@ -42,6 +144,11 @@ namespace igros::klib {
 			return nullptr;
 		}
 
+		// Uniform pattern is a byte fill
+		if (val == static_cast<word_t>((val & 0xFF) * 0x0101U)) {
+			return kmemset8(reinterpret_cast<byte_t*>(dst), size << 1, static_cast<byte_t>(val));
+		}
+
 		// Get pointer and size
 		auto mDest = dst;
 		auto mSize = size;
@@ -79,6 +186,11 @@ namespace igros::klib {
 			return nullptr;
 		}
 
+		// Uniform pattern is a byte fill
+		if (val == (val & 0xFFU) * 0x01010101U) {
+			return kmemset8(reinterpret_cast<byte_t*>(dst), size << 2, static_cast<byte_t>(val));
+		}
+
 		// Get pointer and size
 		auto mDest = dst;
 		auto mSize = size;
@@ -162,6 +274,11 @@ namespace igros::klib {
 			return nullptr;
 		}
 
+		// Uniform pattern is a byte fill
+		if (val == (val & 0xFFULL) * 0x0101010101010101ULL) {
+			return kmemset8(reinterpret_cast<byte_t*>(dst), size << 3, static_cast<byte_t>(val));
+		}
+
 		// Get pointer and size
 		auto mDest = dst;
 		auto mSize = size;
@@ -189,14 +306,120 @@ namespace igros::klib {
 		) {
 			return nullptr;
 		}
-		// Do actual memcpy
-		for (auto i = 0ULL; i < size; i++) {
-			static_cast<byte_t*>(dst)[i] = static_cast<byte_t*>(src)[i];
+		// Do actual memcpy with routine fitting size
+		if (size < KMEMORY_TINY) {
+			kmemcpyLoop(dst, src, size);
+		} else if (size < KMEMORY_LARGE) {
+			kmemcpySmall(dst, src, size);
+		} else {
+			kmemcpyLarge(dst, src, size);
 		}
 		// Return pointer to dst
 		return dst;
 	}
 
 
-}	// namespace igros::klib
+	// Move memory (ranges may overlap)
+	[[maybe_unused]]
+	pointer_t kmemmove(pointer_t dst, const pointer_t src, const std::size_t size) noexcept {
+		// Check arguments
+		if (
+			(nullptr == dst)	||
+			(nullptr == src)	||
+			(dst	 == src)	||
+			(0ULL	 == size)
+		) {
+			return nullptr;
+		}
+		// Ranges addresses
+		const auto to	= reinterpret_cast<std::size_t>(dst);
+		const auto from	= reinterpret_cast<std::size_t>(src);
+		if (((to + size) <= from) || ((from + size) <= to)) {
+			// No overlap - plain copy
+			kmemcpy(dst, src, size);
+		} else if (to < from) {
+			// Destination below source - forward string copy never reads overwritten bytes
+			memoryCopyRep(dst, src, size);
+		} else {
+			// Destination above source - copy backwards
+			memoryMoveBack(dst, src, size);
+		}
+		// Return pointer to dst
+		return dst;
+	}
+
+
+	// Compare memory
+	[[nodiscard]]
+	sdword_t kmemcmp(const pointer_t lhs, const pointer_t rhs, const std::size_t size) noexcept {
+		// Check arguments
+		if (
+			(nullptr == lhs)	||
+			(nullptr == rhs)	||
+			(lhs	 == rhs)
+		) {
+			return 0;
+		}
+		// Bytes iterators
+		auto left	= static_cast<const byte_t*>(lhs);
+		auto right	= static_cast<const byte_t*>(rhs);
+		auto count	= size;
+		// Words are compared only when both blocks share alignment
+		if (0ULL == ((reinterpret_cast<std::size_t>(left) ^ reinterpret_cast<std::size_t>(right)) & KWORD_MASK)) {
+			// Compare unaligned head
+			for (; (0ULL != (reinterpret_cast<std::size_t>(left) & KWORD_MASK)) && (0ULL != count); ++left, ++right, --count) {
+				if (*left != *right) {
+					return static_cast<sdword_t>(*left) - static_cast<sdword_t>(*right);
+				}
+			}
+			// Skip equal words
+			for (; (count >= sizeof(kword_t)) && (*reinterpret_cast<const kword_t*>(left) == *reinterpret_cast<const kword_t*>(right)); left += sizeof(kword_t), right += sizeof(kword_t), count -= sizeof(kword_t)) {}
+		}
+		// Compare the rest (differing word included) byte by byte
+		for (; 0ULL != count; ++left, ++right, --count) {
+			if (*left != *right) {
+				return static_cast<sdword_t>(*left) - static_cast<sdword_t>(*right);
+			}
+		}
+		return 0;
+	}
 
+
+	// Find byte in memory (nullptr if not found)
+	[[nodiscard]]
+	pointer_t kmemchr(const pointer_t src, const byte_t val, const std::size_t size) noexcept {
+		// Check arguments
+		if (nullptr == src) {
+			return nullptr;
+		}
+		// Bytes iterator
+		auto data	= static_cast<const byte_t*>(src);
+		auto count	= size;
+		// Search unaligned head
+		for (; (0ULL != (reinterpret_cast<std::size_t>(data) & KWORD_MASK)) && (0ULL != count); ++data, --count) {
+			if (val == *data) {
+				return const_cast<byte_t*>(data);
+			}
+		}
+		// Skip words without byte (word XOR pattern has zero byte on match)
+		const auto pattern = KWORD_ONES * val;
+		for (; (count >= sizeof(kword_t)) && !kwordZero(*reinterpret_cast<const kword_t*>(data) ^ pattern); data += sizeof(kword_t), count -= sizeof(kword_t)) {}
+		// Search the rest (matching word included) byte by byte
+		for (; 0ULL != count; ++data, --count) {
+			if (val == *data) {
+				return const_cast<byte_t*>(data);
+			}
+		}
+		return nullptr;
+	}
+
+	// Find byte in memory (end of memory if not found)
+	[[nodiscard]]
+	pointer_t kmemscan(const pointer_t src, const byte_t val, const std::size_t size) noexcept {
+		// Search byte
+		const auto found = kmemchr(src, val, size);
+		return (nullptr != found) ? found : (static_cast<byte_t*>(src) + size);
+	}
+
+
+}	// namespace igros::klib
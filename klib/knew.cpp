@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel-space allocation operators
+//
+//	File:	knew.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+#include <new>
+
+#include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#include <klib/kmalloc.hpp>
+#include <klib/kprint.hpp>
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Allocate kernel memory or halt (throwing operator new never returns nullptr)
+	[[nodiscard]]
+	static pointer_t kmallocOrHalt(const std::size_t size, const std::size_t align) noexcept {
+		// Allocate memory
+		const auto ptr = kmalloc(size, align);
+		if (nullptr == ptr) {
+			// Disable interrupts
+			arch::irq::get().disable();
+			// Print error
+			kprintf(
+				u8"KMALLOC:\tout of memory (%d bytes)",
+				static_cast<dword_t>(size)
+			);
+			// Hang CPU
+			arch::cpu::get().halt();
+		}
+		return ptr;
+	}
+
+
+}	// namespace igros::klib
+
+
+// Allocate object
+void* operator new(std::size_t size) {
+	return igros::klib::kmallocOrHalt(size, sizeof(igros::pointer_t));
+}
+
+// Allocate objects array
+void* operator new[](std::size_t size) {
+	return igros::klib::kmallocOrHalt(size, sizeof(igros::pointer_t));
+}
+
+// Allocate aligned object
+void* operator new(std::size_t size, std::align_val_t align) {
+	return igros::klib::kmallocOrHalt(size, static_cast<std::size_t>(align));
+}
+
+// Allocate aligned objects array
+void* operator new[](std::size_t size, std::align_val_t align) {
+	return igros::klib::kmallocOrHalt(size, static_cast<std::size_t>(align));
+}
+
+// Allocate object (non-throwing)
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return igros::klib::kmalloc(size);
+}
+
+// Allocate objects array (non-throwing)
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return igros::klib::kmalloc(size);
+}
+
+// Allocate aligned object (non-throwing)
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+	return igros::klib::kmalloc(size, static_cast<std::size_t>(align));
+}
+
+// Allocate aligned objects array (non-throwing)
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+	return igros::klib::kmalloc(size, static_cast<std::size_t>(align));
+}
+
+
+// Free object
+void operator delete(void* ptr) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free objects array
+void operator delete[](void* ptr) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free object (sized)
+void operator delete(void* ptr, std::size_t) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free objects array (sized)
+void operator delete[](void* ptr, std::size_t) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free aligned object
+void operator delete(void* ptr, std::align_val_t) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free aligned objects array
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free aligned object (sized)
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free aligned objects array (sized)
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free object (non-throwing)
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free objects array (non-throwing)
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free aligned object (non-throwing)
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+	igros::klib::kfree(ptr);
+}
+
+// Free aligned objects array (non-throwing)
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+	igros::klib::kfree(ptr);
+}
+
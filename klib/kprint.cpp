@@ -14,9 +14,8 @@
 #include <cstdarg>
 #include <array>
 
-#include <drivers/vga/vmem.hpp>
-#include <drivers/uart/serial.hpp>
-
+#include <klib/kformat.hpp>
+#include <klib/klog.hpp>
 #include <klib/kprint.hpp>
 #include <klib/kstring.hpp>
 #include <klib/kmath.hpp>
@@ -27,96 +26,136 @@
 namespace igros::klib {
 
 
-	// Default temporary buffer for kitoa
-	constexpr std::size_t			KITOA_BUFF_LEN		{65U};
 	// Constant integer symbols values buffer
 	constexpr std::array<sbyte_t, 16ULL>	KITOA_CONST_BUFFER	{u8'0', u8'1', u8'2', u8'3', u8'4', u8'5', u8'6', u8'7', u8'8', u8'9', u8'A', u8'B', u8'C', u8'D', u8'E', u8'F'};
+	// Decimal digit pairs "00" to "99"
+	constexpr auto				KITOA_DIGIT_PAIRS	= []() constexpr noexcept {
+		std::array<sbyte_t, 200ULL> pairs {};
+		for (auto i = 0U; i < 100U; i++) {
+			pairs[i << 1]		= static_cast<sbyte_t>(u8'0' + (i / 10U));
+			pairs[(i << 1) + 1U]	= static_cast<sbyte_t>(u8'0' + (i % 10U));
+		}
+		return pairs;
+	}();
+	// Powers of 10 (10^0 to 10^19)
+	constexpr auto				KITOA_POWERS		= []() constexpr noexcept {
+		std::array<quad_t, 20ULL> powers {};
+		powers[0] = 1ULL;
+		for (auto i = 1ULL; i < powers.size(); i++) {
+			powers[i] = powers[i - 1ULL] * 10ULL;
+		}
+		return powers;
+	}();
+	// Decimal digits in 32-bit chunk of 64-bit value
+	constexpr auto				KITOA_CHUNK_DIGITS	= 8ULL;
+	// 32-bit chunk of 64-bit value
+	constexpr auto				KITOA_CHUNK		= 100000000U;
+	// Longest single conversion output (64 binary digits with sign, fill width is below 10)
+	constexpr auto				KPRINT_CONVERSION_MAX	= 72ULL;
+
+
+	// Count digits of value
+	[[nodiscard]]
+	static std::size_t kitoaDigits(const quad_t value, const radix_t radix) noexcept {
+		// Significant bits count (zero has one digit)
+		const auto bits = 64U - static_cast<dword_t>(__builtin_clzll(value | 1ULL));
+		// Decimal digits estimated by bits * log10(2) and fixed up with single compare
+		if (radix_t::DEC == radix) {
+			const auto digits = (bits * 1233U) >> 12;
+			return digits + (((value | 1ULL) >= KITOA_POWERS[digits]) ? 1U : 0U);
+		}
+		// Bits per digit for power of 2 radix
+		const auto shift = static_cast<dword_t>(__builtin_ctz(static_cast<dword_t>(radix)));
+		return (bits + shift - 1U) / shift;
+	}
 
+	// Write decimal value backwards (value fits machine word)
+	static sbyte_t* kitoaDecimal(sbyte_t* pos, std::size_t value) noexcept {
+		// Two digits per step
+		while (value >= 100U) {
+			const auto pair	= (value % 100U) << 1;
+			value		/= 100U;
+			*--pos		= KITOA_DIGIT_PAIRS[pair + 1U];
+			*--pos		= KITOA_DIGIT_PAIRS[pair];
+		}
+		// Last one or two digits
+		if (value >= 10U) {
+			const auto pair	= value << 1;
+			*--pos		= KITOA_DIGIT_PAIRS[pair + 1U];
+			*--pos		= KITOA_DIGIT_PAIRS[pair];
+		} else {
+			*--pos		= KITOA_CONST_BUFFER[value];
+		}
+		return pos;
+	}
 
-	// Kernel large unsigned integer to string function
-	sbyte_t* kitoa(sbyte_t* buffer, const std::size_t size, const quad_t value, const radix_t radix) noexcept {
+	// Write exactly digits count symbols of value to buffer (no null terminator)
+	static void kitoaWrite(sbyte_t* buffer, const std::size_t digits, quad_t value, const radix_t radix) noexcept {
+		// Digits are written from the end
+		auto pos = buffer + digits;
+		// Power of 2 radix is done with shift and mask
+		if (radix_t::DEC != radix) {
+			const auto shift	= static_cast<dword_t>(__builtin_ctz(static_cast<dword_t>(radix)));
+			const auto mask	= static_cast<dword_t>(radix) - 1U;
+			while (pos != buffer) {
+				*--pos	= KITOA_CONST_BUFFER[static_cast<dword_t>(value) & mask];
+				value	>>= shift;
+			}
+			return;
+		}
+#if	defined (IGROS_ARCH_i386)
+		// 64-bit division is slow - split value to 8 digits chunks which fit 32-bit
+		while (value > 0xFFFFFFFFULL) {
+			const auto divres	= kudivmod<KITOA_CHUNK>(value);
+			auto chunk		= static_cast<dword_t>(divres.reminder);
+			// Chunk is padded with zeroes
+			for (auto i = 0ULL; i < KITOA_CHUNK_DIGITS; i += 2ULL) {
+				const auto pair	= (chunk % 100U) << 1;
+				chunk		/= 100U;
+				*--pos		= KITOA_DIGIT_PAIRS[pair + 1U];
+				*--pos		= KITOA_DIGIT_PAIRS[pair];
+			}
+			value = divres.quotient;
+		}
+#endif
+		// Rest of value fits machine word
+		kitoaDecimal(pos, static_cast<std::size_t>(value));
+	}
 
-		// Temporary copy of value
-		auto tempValue	= value;
-		auto tempSize	= size;
-
-		// Temporary buffer for value text representation
-		std::array<sbyte_t, KITOA_BUFF_LEN> tempBuffer;
-		// Zero-initialize
-		kmemset(tempBuffer.data(), tempBuffer.size(), u8'\0');
-
-		// Setup counter to last - 1 position in temporary buffer
-		auto pos = KITOA_BUFF_LEN - 2U;
-		// Loop through all digits while number is greater than base.
-		// Digits are stored from the end of the start of temporary buffer
-		// (this makes easier dealing with reverse routine by removing it)
-		do {
-			// Calculate digit index
-			auto divres		= kudivmod(tempValue, static_cast<dword_t>(radix));
-			// Save current digit to temporary buffer
-			tempBuffer[pos--]	= KITOA_CONST_BUFFER[divres.reminder];
-			// Divide value by base to remove current digit
-			tempValue		= divres.quotient;
-		} while (tempValue > 0U);
 
+	// Kernel large unsigned integer to string function
+	sbyte_t* kitoa(sbyte_t* buffer, const std::size_t size, const quad_t value, const radix_t radix) noexcept {
 		// Resulting string length
-		auto strLength = (KITOA_BUFF_LEN - ++pos);
-		// Check size fit
-		if (strLength > tempSize) {
+		const auto digits = kitoaDigits(value, radix);
+		// Check size fit (with null terminator)
+		if ((digits + 1ULL) > size) {
 			return buffer;
 		}
-		// Revert temporary buffer we created from value to src buffer
-		return kstrcpy(&tempBuffer[pos], buffer, strLength);
-
+		// Write digits right to destination
+		kitoaWrite(buffer, digits, value, radix);
+		buffer[digits] = u8'\0';
+		return buffer;
 	}
 
 	// Kernel large integer to string function
 	sbyte_t* kitoa(sbyte_t* buffer, const std::size_t size, const squad_t value, const radix_t radix) noexcept {
-
-		// Temporary copy of value
-		auto tempValue	= value;
-		auto tempSize	= size;
-
-		// Check if sign is negative and value should be represented
-		// as decimal (binary, octal and hexidemical values have no sign)
-		if (	(value < 0)
-			&& (radix_t::DEC == radix)) {
-			// Write minus sign to buffer
-			*buffer++ = u8'-';
-			// Decrement size counter
-			--tempSize;
-			// Made value positive
-			tempValue = -tempValue;
+		// Binary, octal and hexidemical values have no sign
+		if (	(value >= 0)
+			|| (radix_t::DEC != radix)) {
+			return kitoa(buffer, size, static_cast<quad_t>(value), radix);
 		}
-
-		// Temporary buffer for value text representation
-		std::array<sbyte_t, KITOA_BUFF_LEN> tempBuffer;
-		// Zero-initialize
-		kmemset(tempBuffer.data(), tempBuffer.size(), u8'\0');
-
-		// Setup counter to last - 1 position in temporary buffer
-		auto pos = KITOA_BUFF_LEN - 2U;
-		// Loop through all digits while number is greater than base.
-		// Digits are stored from the end of the start of temporary buffer
-		// (this makes easier dealing with reverse routine by removing it)
-		do {
-			// Calculate digit index
-			auto divres		= kudivmod(tempValue, static_cast<dword_t>(radix));
-			// Save current digit to temporary buffer
-			tempBuffer[pos--]	= KITOA_CONST_BUFFER[divres.reminder];
-			// Divide value by base to remove current digit
-			tempValue		= divres.quotient;
-		} while (tempValue > 0);
-
-		// Resulting string length
-		auto strLength = (KITOA_BUFF_LEN - ++pos);
-		// Check size fit
-		if (strLength > tempSize) {
+		// Made value positive (unsigned negation works for the smallest value too)
+		const auto absValue	= ~static_cast<quad_t>(value) + 1ULL;
+		const auto digits	= kitoaDigits(absValue, radix);
+		// Check size fit (with sign and null terminator)
+		if ((digits + 2ULL) > size) {
 			return buffer;
 		}
-		// Revert temporary buffer we created from value to src buffer
-		return kstrcpy(&tempBuffer[pos], buffer, strLength);
-
+		// Write sign and digits right to destination
+		buffer[0] = u8'-';
+		kitoaWrite(buffer + 1ULL, digits, absValue, radix);
+		buffer[digits + 1ULL] = u8'\0';
+		return buffer;
 	}
 
 
@@ -126,9 +165,62 @@ namespace igros::klib {
 	}
 
 
+	// Fill with preceding symbols
+	static void kprintFill(sbyte_t* &str, const std::size_t len, const std::size_t width, const sbyte_t fill) noexcept {
+		// Check if value should be extended with fill char
+		if (len < width) {
+			// Calc remaining length
+			const auto sz = width - len;
+			// Fill
+			kmemset(str, sz, static_cast<byte_t>(fill));
+			// Move iterator to string's end
+			str += sz;
+		}
+	}
+
+	// Copy symbols clipped to string end
+	static void kprintCopy(sbyte_t* &str, const sbyte_t* const end, const sbyte_t* src, const std::size_t len) noexcept {
+		// Symbols that fit
+		const auto fit = (len < static_cast<std::size_t>(end - str)) ? len : static_cast<std::size_t>(end - str);
+		kmemcpy(str, const_cast<sbyte_t*>(src), fit);
+		str += fit;
+	}
+
+	// Print number (digits are written right to resulting string)
+	static void kprintNumber(sbyte_t* &str, const quad_t value, const radix_t radix, const std::size_t width, const sbyte_t fill, const bool negative) noexcept {
+		// Digits count
+		const auto digits	= kitoaDigits(value, radix);
+		const auto len		= digits + (negative ? 1U : 0U);
+		// Sign goes before zeroes but after spaces
+		if (	negative
+			&& (u8'0' == fill)) {
+			*str++ = u8'-';
+		}
+		// Fill with preceding symbols
+		kprintFill(str, len, width, fill);
+		if (	negative
+			&& (u8'0' != fill)) {
+			*str++ = u8'-';
+		}
+		// Write digits
+		kitoaWrite(str, digits, value, radix);
+		// Move iterator to string's end
+		str += digits;
+	}
+
+
 	// Kernel vsnprintf function
 	void kvsnprintf(sbyte_t* buffer, const std::size_t size, const sbyte_t* format, va_list list) noexcept {
 
+		// Check buffer
+		if (0ULL == size) {
+			return;
+		}
+		// Last symbol is kept for null terminator
+		const auto end = buffer + size - 1ULL;
+		// Conversions near buffer end go through temporary buffer
+		std::array<sbyte_t, KPRINT_CONVERSION_MAX> temp;
+
 		// Foramt string iterator
 		auto fmtIterator = 0ULL;
 		// Resulting string iterator
@@ -137,24 +229,6 @@ namespace igros::klib {
 		// String pointer holder
 		auto str = static_cast<sbyte_t*>(nullptr);
 
-		// Number holder
-		std::array<sbyte_t, KITOA_BUFF_LEN> number;
-		// Zero-initialize
-		kmemset(number.data(), number.size(), u8'\0');
-
-		// Preceding char fill lambda
-		constexpr auto fillPreceding = [](auto &str, const auto len, const auto width, const auto fill) constexpr noexcept {
-			// Check if value should be extended with fillChar
-			if (len < width) {
-				// Calc remaining length
-				auto sz = width - len;
-				// Copy string
-				kmemset(str, sz, static_cast<byte_t>(fill));
-				// Move iterator to string's end
-				str += sz;
-			}
-		};
-
 		// Argument type enumeration
 		enum class argType_t : byte_t {
 			BYTE	= 0x01,
@@ -164,11 +238,7 @@ namespace igros::klib {
 		};
 
 		// Integer print lambda
-		auto printInteger = [&list, &fillPreceding](auto &str, const auto radix, const auto type, const auto width, const auto fill, const auto sign) noexcept {
-			// Number holder
-			std::array<sbyte_t, KITOA_BUFF_LEN> number;
-			// Zero-initialize
-			kmemset(number.data(), number.size(), u8'\0');
+		auto printInteger = [&list](auto &str, const auto radix, const auto type, const auto width, const auto fill, const auto sign) noexcept {
 			// Value
 			auto value	= 0ULL;
 			// Check argument size specifier
@@ -191,24 +261,20 @@ namespace igros::klib {
 				// Convert double word to string
 				case argType_t::DWORD:
 					// Signed or unsigned
-					value = (sign) ? static_cast<sdword_t>(va_arg(list, sdword_t)) : static_cast<dword_t>(va_arg(list, dword_t));
+					value = (sign) ? static_cast<quad_t>(static_cast<squad_t>(va_arg(list, sdword_t))) : static_cast<quad_t>(va_arg(list, dword_t));
 					break;
 				// Unknown
 				default:
 					break;
 			}
-			// Get string length
-			const auto len = kstrlen(kitoa(number.data(), number.size(), value, radix));
-			// Fill with preceding symbols
-			fillPreceding(str, len, width, fill);
-			// Copy string
-			kstrcpy(number.data(), str, len);
-			// Move iterator to string's end
-			str += len;
+			// Decimal values are printed with sign
+			const auto negative = sign && (radix_t::DEC == radix) && (static_cast<squad_t>(value) < 0);
+			// Print absolute value
+			kprintNumber(str, negative ? (~value + 1ULL) : value, radix, width, fill, negative);
 		};
 
 		// Iterate through format string
-		while (	(fmtIterator < size)
+		while (	(strIterator < end)
 			&& (u8'\0' != format[fmtIterator])) {
 
 			// If symbol is not placeholder symbol '%'
@@ -266,33 +332,38 @@ namespace igros::klib {
 				// Otherwise it's double word
 				}
 
+				// Conversion output (right to resulting string if it surely fits)
+				const auto direct	= static_cast<std::size_t>(end - strIterator) >= temp.size();
+				const auto limit	= direct ? end : (temp.data() + temp.size());
+				auto out		= direct ? strIterator : temp.data();
+
 				// Determine type
 				switch (format[++fmtIterator]) {
 
 					// '%' character
 					case u8'%':
 						// Copy placeholder symbol '%'
-						*strIterator++ = format[fmtIterator];
+						*out++ = format[fmtIterator];
 						break;
 
 					// Character
 					case u8'c':
 						// Fill with preceding symbols
-						fillPreceding(strIterator, sizeof(sbyte_t), fillWidth, fillChar);
+						kprintFill(out, sizeof(sbyte_t), fillWidth, fillChar);
 						// Copy character to resulting string
-						*strIterator++ = static_cast<sbyte_t>(va_arg(list, dword_t));
+						*out++ = static_cast<sbyte_t>(va_arg(list, dword_t));
 						break;
 
 					// Binary integer
 					case u8'b':
 						// Print integer
-						printInteger(strIterator, radix_t::BIN, argType, fillWidth, fillChar, false);
+						printInteger(out, radix_t::BIN, argType, fillWidth, fillChar, false);
 						break;
 
 					// Octal integer
 					case u8'o':
 						// Print integer
-						printInteger(strIterator, radix_t::OCT, argType, fillWidth, fillChar, false);
+						printInteger(out, radix_t::OCT, argType, fillWidth, fillChar, false);
 						break;
 
 					// Integer
@@ -301,19 +372,19 @@ namespace igros::klib {
 					// Integer too
 					case u8'i':
 						// Print integer
-						printInteger(strIterator, radix_t::DEC, argType, fillWidth, fillChar, true);
+						printInteger(out, radix_t::DEC, argType, fillWidth, fillChar, true);
 						break;
 
 					// Unsigned integer
 					case u8'u':
 						// Print integer
-						printInteger(strIterator, radix_t::DEC, argType, fillWidth, fillChar, false);
+						printInteger(out, radix_t::DEC, argType, fillWidth, fillChar, false);
 						break;
 
 					// Hexidemical integer
 					case u8'x':
 						// Print integer
-						printInteger(strIterator, radix_t::HEX, argType, fillWidth, fillChar, false);
+						printInteger(out, radix_t::HEX, argType, fillWidth, fillChar, false);
 						break;
 
 					// Address
@@ -322,30 +393,14 @@ namespace igros::klib {
 						// And fill char is always '0'
 						fillWidth	= sizeof(pointer_t) << 1;
 						fillChar	= u8'0';
-						// Convert pointer to string
-						kptoa(number.data(), (sizeof(pointer_t) << 3) + 1ULL, static_cast<pointer_t>(va_arg(list, pointer_t)));
-						// Get string length
-						const auto len = kstrlen(number.data());
-						// Fill with preceding symbols
-						fillPreceding(strIterator, len, fillWidth, fillChar);
-						// Copy string
-						kstrcpy(number.data(), strIterator, len);
-						// Move iterator to string's end
-						strIterator += len;
+						// Print pointer
+						kprintNumber(out, reinterpret_cast<std::size_t>(va_arg(list, pointer_t)), radix_t::HEX, fillWidth, fillChar, false);
 					} break;
 
 					// Size
 					case u8'z': {
-						// Convert pointer to string
-						kstoa(number.data(), (sizeof(std::size_t) << 3) + 1ULL, static_cast<const std::size_t>(va_arg(list, std::size_t)));
-						// Get string length
-						const auto len = kstrlen(number.data());
-						// Fill with preceding symbols
-						fillPreceding(strIterator, len, fillWidth, fillChar);
-						// Copy string
-						kstrcpy(number.data(), strIterator, len);
-						// Move iterator to string's end
-						strIterator += len;
+						// Print size
+						kprintNumber(out, static_cast<std::size_t>(va_arg(list, std::size_t)), radix_t::DEC, fillWidth, fillChar, false);
 					} break;
 
 					// String
@@ -354,20 +409,25 @@ namespace igros::klib {
 						str = static_cast<sbyte_t*>(va_arg(list, sbyte_t*));
 						// Get string length
 						const auto len = kstrlen(str);
-						// Copy string
-						kstrcpy(str, strIterator, len);
-						// Move iterator to string's end
-						strIterator += len;
+						// Copy string (clipped to output end)
+						kprintCopy(out, limit, str, len);
 					} break;
 
 					// Default action
 					default:
 						// Copy character to resulting string
-						*strIterator++ = u8'?';
+						*out++ = u8'?';
 						break;
 
 				}
 
+				// Take converted symbols
+				if (direct) {
+					strIterator = out;
+				} else {
+					kprintCopy(strIterator, end, temp.data(), static_cast<std::size_t>(out - temp.data()));
+				}
+
 				// Incremet format iterator
 				++fmtIterator;
 
@@ -385,6 +445,89 @@ namespace igros::klib {
 	}
 
 
+	// Format with precomputed specifiers (no format parsing at runtime)
+	void kvformat(sbyte_t* buffer, const std::size_t size, const sbyte_t* text, const kformatSpec_t* specs, const quad_t* args) noexcept {
+		// Check buffer
+		if (0ULL == size) {
+			return;
+		}
+		// Last symbol is kept for null terminator
+		const auto end = buffer + size - 1ULL;
+		// Conversions near buffer end go through temporary buffer
+		std::array<sbyte_t, KPRINT_CONVERSION_MAX> temp;
+		// Loop through specifiers
+		for (auto spec = specs; ; ++spec) {
+			// Copy literal text before conversion
+			kprintCopy(buffer, end, &text[spec->offset], spec->length);
+			// Specifier argument
+			auto value = (0U != spec->size) ? *args++ : 0ULL;
+			// Strings are clipped while copying
+			if (u8's' == spec->type) {
+				const auto str = reinterpret_cast<const sbyte_t*>(static_cast<std::size_t>(value));
+				kprintCopy(buffer, end, str, kstrlen(str));
+				continue;
+			}
+			// Conversion output (right to buffer if it surely fits)
+			const auto direct	= static_cast<std::size_t>(end - buffer) >= temp.size();
+			auto out		= direct ? buffer : temp.data();
+			// Determine type
+			switch (spec->type) {
+				// End of format
+				case u8'\0':
+					// Insert null terminator
+					*buffer = u8'\0';
+					return;
+				// '%' character
+				case u8'%':
+					*out++ = u8'%';
+					break;
+				// Character
+				case u8'c':
+					kprintFill(out, sizeof(sbyte_t), spec->width, spec->fill);
+					*out++ = static_cast<sbyte_t>(value);
+					break;
+				// Signed integer
+				case u8'd':
+				case u8'i': {
+					// Sign extend from argument size
+					const auto shift	= 64U - (static_cast<dword_t>(spec->size) << 3);
+					const auto sign		= static_cast<squad_t>(value << shift) >> shift;
+					const auto negative	= (sign < 0);
+					kprintNumber(out, negative ? (~static_cast<quad_t>(sign) + 1ULL) : static_cast<quad_t>(sign), radix_t::DEC, spec->width, spec->fill, negative);
+				} break;
+				// Unsigned integers
+				case u8'b':
+				case u8'o':
+				case u8'u':
+				case u8'x': {
+					// Truncate to argument size
+					const auto shift	= 64U - (static_cast<dword_t>(spec->size) << 3);
+					const auto radix	= (u8'b' == spec->type) ? radix_t::BIN : (u8'o' == spec->type) ? radix_t::OCT : (u8'u' == spec->type) ? radix_t::DEC : radix_t::HEX;
+					kprintNumber(out, (value << shift) >> shift, radix, spec->width, spec->fill, false);
+				} break;
+				// Address (always full width with '0' fill)
+				case u8'p':
+					kprintNumber(out, value, radix_t::HEX, sizeof(pointer_t) << 1, u8'0', false);
+					break;
+				// Size
+				case u8'z':
+					kprintNumber(out, value, radix_t::DEC, spec->width, spec->fill, false);
+					break;
+				// Bad specifier
+				default:
+					*out++ = u8'?';
+					break;
+			}
+			// Take converted symbols
+			if (direct) {
+				buffer = out;
+			} else {
+				kprintCopy(buffer, end, temp.data(), static_cast<std::size_t>(out - temp.data()));
+			}
+		}
+	}
+
+
 	// Kernel snprintf function
 	void ksnprintf(sbyte_t* buffer, const std::size_t size, const sbyte_t* format, ...) noexcept {
 		// Kernel variadic argument list
@@ -412,24 +555,18 @@ namespace igros::klib {
 
 	// Kernel printf function
 	void kprintf(const sbyte_t* format, ...) noexcept {
-		// Text buffer
-		static std::array<sbyte_t, 1024ULL> buffer;
-		// Zero-initialize
-		kmemset(buffer.data(), buffer.size(), u8'\0');
 		// Kernel variadic argument list
 		va_list list {};
 		// Initialize variadic arguments list
 		va_start(list, format);
-		// Format string
-		kvsnprintf(buffer.data(), buffer.size(), format, list);
+		// Format string right into log record
+		klogRing::write(KLOG_LEVEL::INFO, format, list);
 		// End variadic arguments list
 		va_end(list);
-		// Output buffer
-		arch::vmemWrite(buffer.data());
-		arch::vmemWrite(u8"\r\n");
-		// Output to serial
-		arch::serialWrite(buffer.data());
-		arch::serialWrite(u8"\r\n");
+		// Output right away unless interrupt handler is running
+		if (!klogRing::deferred()) {
+			klogRing::drain();
+		}
 	}
 
 
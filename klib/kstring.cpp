@@ -13,6 +13,7 @@
 
 #include <cstdint>
 
+#include <klib/kmemory.hpp>
 #include <klib/kstring.hpp>
 
 
@@ -23,14 +24,7 @@ namespace igros::klib {
 	// Find string end
 	[[nodiscard]]
 	sbyte_t* kstrend(sbyte_t* src) noexcept {
-		// Check src pointer
-		if (nullptr == src) {
-			return nullptr;
-		}
-                // Find string end pointer
-                for (;*src != u8'\0'; ++src) {};
-		// Return string end
-                return src;
+		return const_cast<sbyte_t*>(kstrend(static_cast<const sbyte_t*>(src)));
 	}
 
 	// Find string end
@@ -41,20 +35,52 @@ namespace igros::klib {
 			return nullptr;
 		}
 		// Copy string start pointer
-                auto iter = src;
-                // Find string end pointer
-                for (;*iter != u8'\0'; ++iter) {};
+		auto iter = src;
+		// Check unaligned head byte by byte
+		for (; 0ULL != (reinterpret_cast<std::size_t>(iter) & KWORD_MASK); ++iter) {
+			if (u8'\0' == *iter) {
+				return iter;
+			}
+		}
+		// Skip aligned words without null terminator (aligned read never crosses page)
+		for (; !kwordZero(*reinterpret_cast<const kword_t*>(iter)); iter += sizeof(kword_t)) {}
+		// Find null terminator inside word
+		for (; u8'\0' != *iter; ++iter) {}
 		// Return string end
-                return iter;
+		return iter;
 	}
 
 
 	// Calculate string length
 	[[nodiscard]]
 	std::size_t kstrlen(const sbyte_t* src) noexcept {
-                // Return string length
-                return kstrend(src) - src;
-        }
+		// Return string length
+		return kstrend(src) - src;
+	}
+
+	// Calculate string length (size symbols at most)
+	[[nodiscard]]
+	std::size_t kstrnlen(const sbyte_t* src, const std::size_t size) noexcept {
+		// Check src pointer
+		if (nullptr == src) {
+			return 0ULL;
+		}
+		// Copy string start pointer
+		auto iter	= src;
+		auto count	= size;
+		// Check unaligned head byte by byte
+		for (; (0ULL != (reinterpret_cast<std::size_t>(iter) & KWORD_MASK)) && (0ULL != count); ++iter, --count) {
+			if (u8'\0' == *iter) {
+				return iter - src;
+			}
+		}
+		// Skip aligned words without null terminator
+		for (; (count >= sizeof(kword_t)) && !kwordZero(*reinterpret_cast<const kword_t*>(iter)); iter += sizeof(kword_t), count -= sizeof(kword_t)) {}
+		// Find null terminator inside word or tail
+		for (; (0ULL != count) && (u8'\0' != *iter); ++iter, --count) {}
+		// Return string length
+		return iter - src;
+	}
 
 
 	// Copy string from one to other
@@ -104,7 +130,24 @@ namespace igros::klib {
 	}
 
 
-	// Concatenate string
+	// Copy string from one to other (rest of dst is filled with null terminators)
+	[[maybe_unused]]
+	sbyte_t* kstrncpy(const sbyte_t* src, sbyte_t* dst, std::size_t size) noexcept {
+		// Check src and dst pointers
+		if (nullptr == src || nullptr == dst) {
+			return dst;
+		}
+		// Copy string without null terminator
+		const auto len = kstrnlen(src, size);
+		kmemcpy(dst, const_cast<sbyte_t*>(src), len);
+		// Pad the rest
+		kmemset(&dst[len], size - len, byte_t(0x00));
+		// Return pointer to dst string
+		return dst;
+	}
+
+
+	// Concatenate string (size is whole dst buffer size, result is always null-terminated)
 	[[maybe_unused]]
 	sbyte_t* kstrcat(const sbyte_t* src, sbyte_t* dst, std::size_t size) noexcept {
 		// Check src, dst pointers and size
@@ -112,8 +155,18 @@ namespace igros::klib {
 			// Return nothing
 			return nullptr;
 		}
-		// Return nothing
-		return nullptr;
+		// Find dst string end
+		const auto dstLen = kstrnlen(dst, size);
+		// No null terminator inside dst buffer
+		if (dstLen >= size) {
+			return dst;
+		}
+		// Append as much of src as fits
+		const auto srcLen = kstrnlen(src, size - dstLen - 1ULL);
+		kmemcpy(&dst[dstLen], const_cast<sbyte_t*>(src), srcLen);
+		dst[dstLen + srcLen] = u8'\0';
+		// Return pointer to dst string
+		return dst;
 	}
 
 
@@ -129,6 +182,21 @@ namespace igros::klib {
 				return 1;
 			}
 		}
+		// Words are compared only when both strings share alignment
+		if (0ULL == ((reinterpret_cast<std::size_t>(src1) ^ reinterpret_cast<std::size_t>(src2)) & KWORD_MASK)) {
+			// Compare unaligned head
+			for (; (0ULL != (reinterpret_cast<std::size_t>(src1) & KWORD_MASK)) && (size > 1u) && (*src1 != u8'\0') && (*src1 == *src2); ++src1, ++src2, --size) {}
+			// Skip equal words without null terminator (last symbol is left for final compare)
+			if (0ULL == (reinterpret_cast<std::size_t>(src1) & KWORD_MASK)) {
+				for (; (size > sizeof(kword_t)); src1 += sizeof(kword_t), src2 += sizeof(kword_t), size -= sizeof(kword_t)) {
+					const auto word = *reinterpret_cast<const kword_t*>(src1);
+					if (	(word != *reinterpret_cast<const kword_t*>(src2))
+						|| kwordZero(word)) {
+						break;
+					}
+				}
+			}
+		}
 		// Compare string symbol by symbol
 		for (;(--size > 0u) && (*src1 != u8'\0') && (*src1 == *src2); ++src1, ++src2) {};
 		// Return string difference
@@ -139,14 +207,7 @@ namespace igros::klib {
 	// Find char occurrence in string
 	[[nodiscard]]
 	sbyte_t* kstrchr(sbyte_t* src, sbyte_t chr, std::size_t size) noexcept {
-		// Check src pointer and size
-		if (nullptr == src || 0u == size) {
-			return nullptr;
-		}
-		// Find symbol inside string
-		for (;(--size > 0u) && (*src != u8'\0') && (*src != chr); ++src) {};
-		// Return address of first occurrence or null pointer
-		return (*src == chr) ? src : nullptr;
+		return const_cast<sbyte_t*>(kstrchr(static_cast<const sbyte_t*>(src), chr, size));
 	}
 
 	// Find char occurrence in string
@@ -156,6 +217,18 @@ namespace igros::klib {
 		if (nullptr == src || 0u == size) {
 			return nullptr;
 		}
+		// Check unaligned head
+		for (; (0ULL != (reinterpret_cast<std::size_t>(src) & KWORD_MASK)) && (size > 1u) && (*src != u8'\0') && (*src != chr); ++src, --size) {}
+		// Skip words without symbol and null terminator (last symbol is left for final check)
+		if (0ULL == (reinterpret_cast<std::size_t>(src) & KWORD_MASK)) {
+			const auto pattern = KWORD_ONES * static_cast<byte_t>(chr);
+			for (; size > sizeof(kword_t); src += sizeof(kword_t), size -= sizeof(kword_t)) {
+				const auto word = *reinterpret_cast<const kword_t*>(src);
+				if (kwordZero(word) || kwordZero(word ^ pattern)) {
+					break;
+				}
+			}
+		}
 		// Find symbol inside string
 		for (;(--size > 0u) && (*src != u8'\0') && (*src != chr); ++src) {};
 		// Return address of first occurrence or null pointer
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel binary trace log
+//
+//	File:	ktrace.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <array>
+
+#include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
+
+
+// Kernel library code zone
+namespace igros::klib {
+
+
+	// Formatted event text size
+	constexpr auto KTRACE_MESSAGE_SIZE = 256ULL;
+	// Check events count
+	static_assert(0ULL == (KTRACE_EVENTS & (KTRACE_EVENTS - 1ULL)), "Trace events count should be power of 2");
+
+
+	// Trace events
+	ktraceEvent_t	ktraceRing::mEvents[KTRACE_CPUS][KTRACE_EVENTS]	{};
+	// Next position to write
+	dword_t		ktraceRing::mHead[KTRACE_CPUS]			{};
+
+
+	// Copy published event (false if event is missing or was overwritten while copying)
+	[[nodiscard]]
+	static bool eventRead(const ktraceEvent_t &event, const dword_t position, ktraceEvent_t &copy) noexcept {
+		// Event should be published at this position
+		const auto sequence = __atomic_load_n(&event.sequence, __ATOMIC_ACQUIRE);
+		if (	(0U == sequence)
+			|| ((position + 1U) != sequence)) {
+			return false;
+		}
+		// Copy event
+		copy = event;
+		// Check event was not overwritten meanwhile
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		return sequence == __atomic_load_n(&event.sequence, __ATOMIC_RELAXED);
+	}
+
+	// Loop through published events of CPU from the oldest one
+	template<typename F>
+	void ktraceRing::forEach(const std::size_t cpu, F &&func) noexcept {
+		// Current ring head
+		const auto head = __atomic_load_n(&ktraceRing::mHead[cpu], __ATOMIC_ACQUIRE);
+		// Check every slot from the oldest position
+		for (auto i = static_cast<dword_t>(KTRACE_EVENTS); i > 0U; i--) {
+			const auto position	= head - i;
+			auto copy		= ktraceEvent_t {};
+			if (eventRead(ktraceRing::mEvents[cpu][position & (KTRACE_EVENTS - 1ULL)], position, copy)) {
+				func(copy);
+			}
+		}
+	}
+
+
+	// Print formatted events of all CPUs
+	void ktraceRing::dump() noexcept {
+		// Formatted event text
+		std::array<sbyte_t, KTRACE_MESSAGE_SIZE> message;
+		for (auto cpu = 0ULL; cpu < KTRACE_CPUS; cpu++) {
+			ktraceRing::forEach(cpu, [cpu, &message](const ktraceEvent_t &event) noexcept {
+				// Specifiers were parsed at compile time, words are read back by their sizes
+				kvformat(message.data(), message.size(), event.text, event.specs, event.args);
+				kprintf(u8"[CPU %d] %llu:\t%s", static_cast<dword_t>(cpu), event.timestamp, message.data());
+			});
+		}
+	}
+
+	// Print raw events of all CPUs (format pointers are resolved from kernel ELF by tests/ktrace-decode)
+	void ktraceRing::dumpRaw() noexcept {
+		for (auto cpu = 0ULL; cpu < KTRACE_CPUS; cpu++) {
+			ktraceRing::forEach(cpu, [cpu](const ktraceEvent_t &event) noexcept {
+				kprintf(
+					u8"KTRACE %d %llx %p %d %llx %llx %llx %llx %llx %llx",
+					static_cast<dword_t>(cpu),
+					event.timestamp,
+					event.text,
+					event.count,
+					event.args[0],
+					event.args[1],
+					event.args[2],
+					event.args[3],
+					event.args[4],
+					event.args[5]
+				);
+			});
+		}
+	}
+
+
+}	// namespace igros::klib
+
@@ -20,6 +20,11 @@
 // Architecture dependent
 #include <arch/types.hpp>
 #include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#if	defined (IGROS_ARCH_x86_64)
+#include <arch/x86_64/pcid.hpp>
+#endif
 
 // Kernel drivers
 #include <drivers/vga/vmem.hpp>
@@ -29,11 +34,22 @@
 #include <drivers/uart/serial.hpp>
 
 // Kernel library
+#include <klib/klog.hpp>
+#include <klib/kmemory.hpp>
 #include <klib/kstring.hpp>
 #include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
 
 // Kernel memory
+#include <mem/direct.hpp>
 #include <mem/mmap.hpp>
+#include <mem/numa.hpp>
+#include <mem/slab.hpp>
+#include <mem/tables.hpp>
+#include <mem/vmm.hpp>
+
+// Kernel system
+#include <sys/acpi.hpp>
 
 
 // OS namesapce
@@ -92,9 +108,30 @@ extern "C" {
 		// Print kernel header
 		igros::printHeader(multiboot);
 
+		// Select memory routines
+		igros::klib::kmemoryInit();
+
 		// Initialize platform
 		igros::platform::CURRENT_PLATFORM.initialize();
 
+		// Setup physical memory
+		if (multiboot->hasInfoMemoryMap()) {
+			// Multiboot memory map
+			const auto map = reinterpret_cast<const igros::multiboot::memoryMapEntry*>(multiboot->mmapAddr);
+			// Map physical memory to direct map
+			igros::mem::direct::init(map, multiboot->mmapLength);
+			// Find ACPI tables (direct map is needed)
+			igros::sys::acpi::init();
+			// Detect NUMA nodes
+			igros::mem::numa::init();
+			// Setup physical memory allocator
+			igros::mem::phys::init(map, multiboot->mmapLength);
+			// Map the rest of physical memory (page tables come from allocator now)
+			igros::mem::direct::init(map, multiboot->mmapLength);
+			// Manage newly mapped memory
+			igros::mem::phys::extend(map, multiboot->mmapLength);
+		}
+
 		// Setup PIT
 		//igros::arch::pitSetup();
 		// Setup keyboard
@@ -113,11 +150,47 @@ extern "C" {
 		// Show memory map
 		multiboot->printMemMap();
 
+#if	defined (IGROS_BENCHMARKS)
+		// Measure copy-on-write clone of 64 Mb. kernel heap range against full copy
+		igros::mem::vmm::benchmark(64ULL << 20);
+		// Measure TLB invalidation of 1 - 512 remapped pages
+		igros::mem::vmm::benchmarkRemap(512ULL);
+#if	defined (IGROS_ARCH_x86_64)
+		// Measure address space ping-pong with 64 pages working set
+		igros::x86_64::pcid::benchmark(64ULL);
+		igros::x86_64::pcid::print();
+#endif
+#endif
+		// Show page faults statistics and kernel heap areas
+		igros::mem::vmm::print();
+		// Show physical memory, page tables pool and slab caches (kmalloc size classes too) state with debug log level
+		if constexpr (igros::klib::KLOG_LEVEL::DEBUG >= igros::klib::KLOG_MIN_LEVEL) {
+			igros::mem::phys::print();
+			igros::mem::tables::print();
+			igros::mem::cache::printAll();
+		}
+		// Boot trace events (decoded on host by tests/ktrace-decode with kernel ELF)
+		igros::klib::ktraceRing::dumpRaw();
+
 		// Write "Booted successfully" message
 		igros::klib::kprintf(u8"Booted successfully\r\n");
 
-		// Halt CPU
-		igros::arch::cpu::get().halt();
+		// Idle loop (spare time is spent on log output and zeroing pages)
+		while (true) {
+			// Output log records queued by interrupt handlers
+			if (	igros::klib::klogRing::drain()
+				|| igros::mem::phys::zeroIdle()) {
+				continue;
+			}
+			// Check for records with interrupts disabled, so none is queued between check and halt
+			igros::arch::irq::get().disable();
+			if (igros::klib::klogRing::pending()) {
+				igros::arch::irq::get().enable();
+				continue;
+			}
+			// Nothing to do - wait for interrupt
+			igros::arch::cpu::get().idle();
+		}
 
 	}
 
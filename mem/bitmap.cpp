@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////////
+//
+//	Bitmap physical memory allocator
+//
+//	File:	bitmap.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <klib/kmemory.hpp>
+#include <klib/kprint.hpp>
+
+#include <mem/mmap.hpp>
+#include <mem/bitmap.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Bitmap word with all bits set
+	constexpr auto BITMAP_WORD_FULL	= ~std::size_t(0ULL);
+
+
+	// Get lowest set bit index (word must not be zero)
+	[[nodiscard]]
+	static inline std::size_t bitScan(const std::size_t word) noexcept {
+		// Compiles to single bsf/tzcnt
+		return static_cast<std::size_t>(__builtin_ctzl(static_cast<unsigned long>(word)));
+	}
+
+	// Get mask of bits [offset, offset + count) inside bitmap word
+	[[nodiscard]]
+	static inline std::size_t bitMask(const std::size_t offset, const std::size_t count) noexcept {
+		return (count >= BITMAP_WORD_BITS) ? BITMAP_WORD_FULL : (((std::size_t(1ULL) << count) - 1ULL) << offset);
+	}
+
+
+	// Find first free frame starting from position
+	[[nodiscard]]
+	std::size_t bitmap::findSet(const std::size_t pos) const noexcept {
+		// Check position
+		if (pos >= mCount) {
+			return mCount;
+		}
+		// Check rest of current word first
+		auto word	= pos / BITMAP_WORD_BITS;
+		auto bits	= mBits[word] & (BITMAP_WORD_FULL << (pos % BITMAP_WORD_BITS));
+		if (0ULL != bits) {
+			return word * BITMAP_WORD_BITS + bitScan(bits);
+		}
+		// Use summary to skip words without free frames
+		auto next = word + 1ULL;
+		while (next < mWords) {
+			// Summary word with words after current one
+			const auto index	= next / BITMAP_WORD_BITS;
+			const auto summary	= mSummary[index] & (BITMAP_WORD_FULL << (next % BITMAP_WORD_BITS));
+			// Found word with free frames
+			if (0ULL != summary) {
+				word = index * BITMAP_WORD_BITS + bitScan(summary);
+				return word * BITMAP_WORD_BITS + bitScan(mBits[word]);
+			}
+			// Move to next summary word
+			next = (index + 1ULL) * BITMAP_WORD_BITS;
+		}
+		// Nothing found
+		return mCount;
+	}
+
+	// Find first allocated frame in [pos, end)
+	[[nodiscard]]
+	std::size_t bitmap::findClear(std::size_t pos, const std::size_t end) const noexcept {
+		// Scan word at a time
+		while (pos < end) {
+			// Allocated frames of current word starting from position
+			const auto word = pos / BITMAP_WORD_BITS;
+			const auto bits = ~mBits[word] & (BITMAP_WORD_FULL << (pos % BITMAP_WORD_BITS));
+			// Found allocated frame
+			if (0ULL != bits) {
+				const auto found = word * BITMAP_WORD_BITS + bitScan(bits);
+				return (found < end) ? found : end;
+			}
+			// Move to next word
+			pos = (word + 1ULL) * BITMAP_WORD_BITS;
+		}
+		// Whole range is free
+		return end;
+	}
+
+
+	// Mark frames range as free
+	void bitmap::set(std::size_t pos, const std::size_t count) noexcept {
+		// Range end
+		const auto end = pos + count;
+		// Set bits word at a time
+		while (pos < end) {
+			// Current word and bits count inside it
+			const auto word		= pos / BITMAP_WORD_BITS;
+			const auto offset	= pos % BITMAP_WORD_BITS;
+			const auto bits		= ((end - pos) < (BITMAP_WORD_BITS - offset)) ? (end - pos) : (BITMAP_WORD_BITS - offset);
+			// Set bits and mark word as having free frames
+			mBits[word]				|= bitMask(offset, bits);
+			mSummary[word / BITMAP_WORD_BITS]	|= std::size_t(1ULL) << (word % BITMAP_WORD_BITS);
+			// Move to next word
+			pos += bits;
+		}
+	}
+
+	// Mark frames range as allocated
+	void bitmap::clear(std::size_t pos, const std::size_t count) noexcept {
+		// Range end
+		const auto end = pos + count;
+		// Clear bits word at a time
+		while (pos < end) {
+			// Current word and bits count inside it
+			const auto word		= pos / BITMAP_WORD_BITS;
+			const auto offset	= pos % BITMAP_WORD_BITS;
+			const auto bits		= ((end - pos) < (BITMAP_WORD_BITS - offset)) ? (end - pos) : (BITMAP_WORD_BITS - offset);
+			// Clear bits
+			mBits[word] &= ~bitMask(offset, bits);
+			// Word has no free frames left
+			if (0ULL == mBits[word]) {
+				mSummary[word / BITMAP_WORD_BITS] &= ~(std::size_t(1ULL) << (word % BITMAP_WORD_BITS));
+			}
+			// Move to next word
+			pos += bits;
+		}
+	}
+
+
+	// Initialize allocator
+	void bitmap::init(const range_t &span, const pointer_t storage) noexcept {
+		// Setup frames span
+		mFirst		= span.first;
+		mCount		= span.last - span.first;
+		mWords		= (mCount + BITMAP_WORD_BITS - 1ULL) / BITMAP_WORD_BITS;
+		mFree		= 0ULL;
+		// Setup frames bitmap and summary right after it
+		mBits		= static_cast<std::size_t*>(storage);
+		mSummary	= &mBits[mWords];
+		// No free frames yet
+		klib::kmemset(mBits, metadata(span), byte_t(0x00));
+	}
+
+	// Add free memory region
+	void bitmap::addRegion(const range_t &range) noexcept {
+		// Clip region to frames span
+		const auto first	= (range.first > mFirst) ? range.first : mFirst;
+		const auto last		= (range.last < (mFirst + mCount)) ? range.last : (mFirst + mCount);
+		// Check if anything left
+		if (first >= last) {
+			return;
+		}
+		// Mark region frames free
+		set(first - mFirst, last - first);
+		mFree += last - first;
+	}
+
+
+	// Allocate 2^order frames
+	[[nodiscard]]
+	pointer_t bitmap::alloc(const std::size_t order) noexcept {
+		// Check order
+		if (order > PHYS_MAX_ORDER) {
+			return nullptr;
+		}
+		// Naturally aligned range
+		return allocRange(1ULL << order, 1ULL << order);
+	}
+
+	// Free 2^order frames
+	void bitmap::free(const pointer_t page, const std::size_t order) noexcept {
+		// Check order
+		if (order > PHYS_MAX_ORDER) {
+			return;
+		}
+		// Free naturally aligned range
+		freeRange(page, 1ULL << order);
+	}
+
+
+	// Allocate contiguous frames range
+	[[nodiscard]]
+	pointer_t bitmap::allocRange(const std::size_t count, const std::size_t alignment) noexcept {
+		// Check count
+		if (	(0ULL == count)
+			|| (count > mFree)) {
+			return nullptr;
+		}
+		// Alignment is rounded up to power of 2
+		const auto align = std::size_t(1ULL) << frameOrder((0ULL != alignment) ? alignment : 1ULL);
+		// Search for free range
+		auto pos = std::size_t(0ULL);
+		while (true) {
+			// Skip to next free frame
+			pos = findSet(pos);
+			// Align frame number (not bitmap position)
+			pos = ((mFirst + pos + align - 1ULL) & ~(align - 1ULL)) - mFirst;
+			// Check range fits the rest of frames span
+			if (	(pos >= mCount)
+				|| (count > (mCount - pos))) {
+				return nullptr;
+			}
+			// Check whole range is free
+			const auto end = findClear(pos, pos + count);
+			if ((pos + count) == end) {
+				break;
+			}
+			// Continue after allocated frame
+			pos = end + 1ULL;
+		}
+		// Mark range allocated
+		clear(pos, count);
+		mFree -= count;
+		// Initialize frames descriptors on first touch
+		const auto pfn = mFirst + pos;
+		phys::prepare({pfn, pfn + count});
+		// Mark range head frame as allocated
+		const auto head	= phys::frame(pfn);
+		head->flags	= FRAME_FLAGS::ALLOCATED;
+		head->order	= static_cast<word_t>(frameOrder(count));
+		// Return range address
+		return frameAddress(pfn);
+	}
+
+	// Free contiguous frames range
+	void bitmap::freeRange(const pointer_t page, const std::size_t count) noexcept {
+		// Get range frame number
+		const auto pfn = frameNumber(page);
+		// Check range is inside frames span
+		if (	(0ULL == count)
+			|| (pfn < mFirst)
+			|| ((pfn - mFirst) >= mCount)
+			|| (count > (mCount - (pfn - mFirst)))) {
+			return;
+		}
+		// Check range head frame is allocated
+		const auto head = phys::frame(pfn);
+		if (	(nullptr == head)
+			|| (FRAME_FLAGS::ALLOCATED != head->flags)) {
+			return;
+		}
+		// Check no frame of range is free already
+		const auto pos = pfn - mFirst;
+		if (findSet(pos) < (pos + count)) {
+			return;
+		}
+		// Mark range free
+		set(pos, count);
+		mFree		+= count;
+		head->flags	= FRAME_FLAGS::NONE;
+	}
+
+
+	// Get free pages count
+	[[nodiscard]]
+	std::size_t bitmap::freePages() const noexcept {
+		return mFree;
+	}
+
+
+	// Print allocator state
+	void bitmap::print() const noexcept {
+		klib::kprintf(
+			u8"\tBitmap:\t%d Kb. free\r\n"
+			u8"\tWords:\t%d (%d summary)\r\n",
+			static_cast<dword_t>(mFree << (DEFAULT_PAGE_SHIFT - 10U)),
+			static_cast<dword_t>(mWords),
+			static_cast<dword_t>((mWords + BITMAP_WORD_BITS - 1ULL) / BITMAP_WORD_BITS)
+		);
+	}
+
+
+}	// namespace igros::mem
+
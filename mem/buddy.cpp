@@ -0,0 +1,388 @@
+////////////////////////////////////////////////////////////////
+//
+//	Buddy physical memory allocator
+//
+//	File:	buddy.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <klib/kprint.hpp>
+
+#include <mem/mmap.hpp>
+#include <mem/buddy.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Get block by frame number
+	[[nodiscard]]
+	inline buddy::block_t* buddy::block(const std::size_t pfn) noexcept {
+		return static_cast<block_t*>(frameAddress(pfn));
+	}
+
+
+	// Add block to free list
+	void buddy::push(const std::size_t pfn, const std::size_t order) noexcept {
+		// Get block
+		const auto node	= buddy::block(pfn);
+		// Link block as new list head
+		node->next	= mFreeLists[order];
+		node->prev	= nullptr;
+		// Update old head
+		if (nullptr != node->next) {
+			node->next->prev = node;
+		}
+		// Set new list head
+		mFreeLists[order] = node;
+		++mFreeCount[order];
+		// Mark block head frame as free
+		const auto head	= phys::frame(pfn);
+		head->flags	= FRAME_FLAGS::FREE;
+		head->order	= static_cast<word_t>(order);
+	}
+
+	// Remove block from free list
+	void buddy::remove(const std::size_t pfn, const std::size_t order) noexcept {
+		// Get block
+		const auto node = buddy::block(pfn);
+		// Unlink from previous node (or list head)
+		if (nullptr != node->prev) {
+			node->prev->next = node->next;
+		} else {
+			mFreeLists[order] = node->next;
+		}
+		// Unlink from next node
+		if (nullptr != node->next) {
+			node->next->prev = node->prev;
+		}
+		--mFreeCount[order];
+		// Block head frame is not free anymore
+		phys::frame(pfn)->flags = FRAME_FLAGS::NONE;
+	}
+
+
+	// Check frames range lies in allocator memory regions (frames of other zones and nodes are not touched)
+	[[nodiscard]]
+	bool buddy::owns(std::size_t first, const std::size_t last) const noexcept {
+		while (first < last) {
+			// Find region holding range start
+			auto i = 0ULL;
+			while (	(i < mRegionsCount)
+				&& ((first < mRegionsFirst[i]) || (first >= mRegions[i].last))) {
+				++i;
+			}
+			// Frame belongs to someone else
+			if (i >= mRegionsCount) {
+				return false;
+			}
+			// Rest of range may continue in adjacent region
+			first = mRegions[i].last;
+		}
+		return true;
+	}
+
+
+	// Release block (with buddies merge)
+	void buddy::release(std::size_t pfn, std::size_t order) noexcept {
+		// Merge with buddies while possible
+		while (order < PHYS_MAX_ORDER) {
+			// Buddy block frame number
+			const auto buddyPFN	= pfn ^ (1ULL << order);
+			// Buddy must be managed free block of the same order from this allocator
+			const auto buddyFrame	= phys::frame(buddyPFN);
+			if (	(nullptr == buddyFrame)
+				|| (FRAME_FLAGS::FREE != buddyFrame->flags)
+				|| (order != buddyFrame->order)
+				|| !owns(buddyPFN, buddyPFN + (1ULL << order))) {
+				break;
+			}
+			// Take buddy from its free list
+			remove(buddyPFN, order);
+			// Merged block starts at lower buddy
+			pfn = (pfn < buddyPFN) ? pfn : buddyPFN;
+			++order;
+		}
+		// Put (merged) block to free list
+		push(pfn, order);
+	}
+
+	// Release frames range as naturally aligned blocks
+	void buddy::releaseRange(std::size_t pfn, const std::size_t last) noexcept {
+		while (pfn < last) {
+			// Biggest block that is aligned and fits the rest of range
+			auto order = 0ULL;
+			while (	(order < PHYS_MAX_ORDER)
+				&& (0ULL == (pfn & ((2ULL << order) - 1ULL)))
+				&& ((pfn + (2ULL << order)) <= last)) {
+				++order;
+			}
+			release(pfn, order);
+			pfn += (1ULL << order);
+		}
+	}
+
+	// Find run of free max order blocks (nullptr if there is none)
+	[[nodiscard]]
+	buddy::block_t* buddy::findRun(const std::size_t blocks, const std::size_t alignment) const noexcept {
+		// Every free max order block could start the run
+		for (auto node = mFreeLists[PHYS_MAX_ORDER]; nullptr != node; node = node->next) {
+			const auto pfn = frameNumber(node);
+			// Check alignment
+			if (0ULL != (pfn & (alignment - 1ULL))) {
+				continue;
+			}
+			// Check following blocks are free too (and not free blocks of other zone or node allocator)
+			auto i = 1ULL;
+			for (; i < blocks; i++) {
+				const auto next = phys::frame(pfn + (i << PHYS_MAX_ORDER));
+				if (	(nullptr == next)
+					|| (FRAME_FLAGS::FREE != next->flags)
+					|| (PHYS_MAX_ORDER != next->order)) {
+					break;
+				}
+			}
+			// Found
+			if (	(blocks == i)
+				&& owns(pfn, pfn + (blocks << PHYS_MAX_ORDER))) {
+				return node;
+			}
+		}
+		return nullptr;
+	}
+
+	// Carve next free block from memory regions
+	[[nodiscard]]
+	bool buddy::carve() noexcept {
+		// Skip exhausted regions
+		while (	(mRegionsNext < mRegionsCount)
+			&& (mRegions[mRegionsNext].first >= mRegions[mRegionsNext].last)) {
+			++mRegionsNext;
+		}
+		// No memory left
+		if (mRegionsNext >= mRegionsCount) {
+			return false;
+		}
+		// Get current region
+		auto &region	= mRegions[mRegionsNext];
+		const auto pfn	= region.first;
+		// Find biggest order that fits both alignment and region size
+		auto order = 0ULL;
+		while (	(order < PHYS_MAX_ORDER)
+			&& (0ULL == (pfn & ((2ULL << order) - 1ULL)))
+			&& ((pfn + (2ULL << order)) <= region.last)) {
+			++order;
+		}
+		// Initialize frames descriptors on first touch
+		phys::prepare({pfn, pfn + (std::size_t(1ULL) << order)});
+		// Move region start
+		region.first	+= (1ULL << order);
+		mRegionsPages	-= (1ULL << order);
+		// Release block
+		release(pfn, order);
+		return true;
+	}
+
+
+	// Initialize allocator
+	void buddy::init(const range_t&, const pointer_t) noexcept {
+		// Reset free lists
+		for (auto order = 0ULL; order <= PHYS_MAX_ORDER; order++) {
+			mFreeLists[order]	= nullptr;
+			mFreeCount[order]	= 0ULL;
+		}
+		// Reset regions
+		mRegionsCount	= 0ULL;
+		mRegionsNext	= 0ULL;
+		mRegionsPages	= 0ULL;
+	}
+
+	// Add free memory region (pages are carved on demand)
+	void buddy::addRegion(const range_t &range) noexcept {
+		// Check regions limit
+		if (	(range.first >= range.last)
+			|| (mRegionsCount >= PHYS_MAX_REGIONS)) {
+			return;
+		}
+		// Record region
+		mRegionsFirst[mRegionsCount]	= range.first;
+		mRegions[mRegionsCount++]	= range;
+		mRegionsPages			+= range.last - range.first;
+	}
+
+
+	// Allocate 2^order frames
+	[[nodiscard]]
+	pointer_t buddy::alloc(const std::size_t order) noexcept {
+		// Check order
+		if (order > PHYS_MAX_ORDER) {
+			return nullptr;
+		}
+		// Find smallest order with free blocks
+		auto current = order;
+		while (true) {
+			// Search free lists
+			while ((current <= PHYS_MAX_ORDER) && (nullptr == mFreeLists[current])) {
+				++current;
+			}
+			// Found
+			if (current <= PHYS_MAX_ORDER) {
+				break;
+			}
+			// Carve more memory from regions
+			if (!carve()) {
+				// No free blocks left
+				return nullptr;
+			}
+			// Retry
+			current = order;
+		}
+		// Take block from free list
+		const auto pfn = frameNumber(mFreeLists[current]);
+		remove(pfn, current);
+		// Split block down to required order
+		while (current > order) {
+			--current;
+			// Upper half goes back to free list
+			push(pfn + (1ULL << current), current);
+		}
+		// Mark block as allocated
+		const auto head	= phys::frame(pfn);
+		head->flags	= FRAME_FLAGS::ALLOCATED;
+		head->order	= static_cast<word_t>(order);
+		// Return block address
+		return frameAddress(pfn);
+	}
+
+	// Free 2^order frames
+	void buddy::free(const pointer_t page, const std::size_t order) noexcept {
+		// Get block frame number
+		const auto pfn	= frameNumber(page);
+		// Get block head frame
+		const auto head	= phys::frame(pfn);
+		// Check block is managed, properly aligned and was allocated with the same order
+		if (	(order > PHYS_MAX_ORDER)
+			|| (nullptr == head)
+			|| (0ULL != (pfn & ((1ULL << order) - 1ULL)))
+			|| (FRAME_FLAGS::ALLOCATED != head->flags)
+			|| (order != head->order)) {
+			return;
+		}
+		// Return block to free lists
+		release(pfn, order);
+	}
+
+
+	// Allocate exactly count contiguous frames (ranges above max order are built from free max order blocks)
+	[[nodiscard]]
+	pointer_t buddy::allocRange(const std::size_t count, const std::size_t alignment) noexcept {
+		// Check count
+		if (0ULL == count) {
+			return nullptr;
+		}
+		// Alignment is rounded up to power of 2
+		const auto align	= std::size_t(1ULL) << frameOrder((0ULL != alignment) ? alignment : 1ULL);
+		// Smallest naturally aligned block holding range
+		const auto order	= frameOrder((count > align) ? count : align);
+		auto pfn		= std::size_t(0ULL);
+		auto last		= std::size_t(0ULL);
+		if (order <= PHYS_MAX_ORDER) {
+			// Take whole block
+			const auto page = alloc(order);
+			if (nullptr == page) {
+				return nullptr;
+			}
+			pfn	= frameNumber(page);
+			last	= pfn + (1ULL << order);
+		} else {
+			// Run of max order blocks
+			const auto blocks	= (count + (1ULL << PHYS_MAX_ORDER) - 1ULL) >> PHYS_MAX_ORDER;
+			auto node		= findRun(blocks, align);
+			// Carve more memory until run appears
+			while (nullptr == node) {
+				for (auto i = 0ULL; i < blocks; i++) {
+					if (!carve()) {
+						return nullptr;
+					}
+				}
+				node = findRun(blocks, align);
+			}
+			// Take blocks from free list
+			pfn	= frameNumber(node);
+			last	= pfn + (blocks << PHYS_MAX_ORDER);
+			for (auto i = 0ULL; i < blocks; i++) {
+				remove(pfn + (i << PHYS_MAX_ORDER), PHYS_MAX_ORDER);
+			}
+		}
+		// Return frames past the range end
+		releaseRange(pfn + count, last);
+		// Mark range head frame as allocated
+		const auto head	= phys::frame(pfn);
+		head->flags	= FRAME_FLAGS::ALLOCATED;
+		head->order	= static_cast<word_t>(frameOrder(count));
+		// Return range address
+		return frameAddress(pfn);
+	}
+
+	// Free exactly count contiguous frames
+	void buddy::freeRange(const pointer_t page, const std::size_t count) noexcept {
+		// Get range head frame
+		const auto pfn	= frameNumber(page);
+		const auto head	= phys::frame(pfn);
+		// Check range is allocated
+		if (	(0ULL == count)
+			|| (nullptr == head)
+			|| (FRAME_FLAGS::ALLOCATED != head->flags)) {
+			return;
+		}
+		// Return range as naturally aligned blocks
+		head->flags = FRAME_FLAGS::NONE;
+		releaseRange(pfn, pfn + count);
+	}
+
+
+	// Get free pages count
+	[[nodiscard]]
+	std::size_t buddy::freePages() const noexcept {
+		// Free pages count (including not yet carved)
+		auto count = mRegionsPages;
+		// Sum up all orders
+		for (auto order = 0ULL; order <= PHYS_MAX_ORDER; order++) {
+			count += mFreeCount[order] << order;
+		}
+		// Return free pages count
+		return count;
+	}
+
+
+	// Print allocator state
+	void buddy::print() const noexcept {
+		// Print header
+		klib::kprintf(
+			u8"\tBuddy:\t%d Kb. free\r\n"
+			u8"\tLazy:\t%d Kb. in %d regions\r\n",
+			static_cast<dword_t>(freePages() << (DEFAULT_PAGE_SHIFT - 10U)),
+			static_cast<dword_t>(mRegionsPages << (DEFAULT_PAGE_SHIFT - 10U)),
+			static_cast<dword_t>(mRegionsCount - mRegionsNext)
+		);
+		// Print free blocks per order
+		for (auto order = 0ULL; order <= PHYS_MAX_ORDER; order++) {
+			klib::kprintf(
+				u8"\t[%02d] %d blocks",
+				static_cast<dword_t>(order),
+				static_cast<dword_t>(mFreeCount[order])
+			);
+		}
+	}
+
+
+}	// namespace igros::mem
+
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////
+//
+//	Physical memory direct map
+//
+//	File:	direct.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <flags.hpp>
+
+#if	defined (IGROS_ARCH_i386)
+#include <arch/i386/paging.hpp>
+#elif	defined (IGROS_ARCH_x86_64)
+#include <arch/x86_64/paging.hpp>
+#endif
+
+#include <klib/kprint.hpp>
+
+#include <mem/direct.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+#if	defined (IGROS_ARCH_i386)
+	// Paging type
+	using paging	= i386::paging;
+	// Page type
+	using page_t	= i386::page_t;
+	// Direct map step (4 Mb, single page directory entry)
+	constexpr auto DIRECT_MAP_STEP	= std::size_t(1ULL) << i386::PAGE_DIRECTORY_SHIFT;
+#elif	defined (IGROS_ARCH_x86_64)
+	// Paging type
+	using paging	= x86_64::paging;
+	// Page type
+	using page_t	= x86_64::page_t;
+	// Direct map step (1 Gb, single page directory pointer entry)
+	constexpr auto DIRECT_MAP_STEP	= std::size_t(1ULL) << x86_64::PAGE_DIRECTORY_POINTER_SHIFT;
+#endif
+
+
+	// Mapped physical memory end
+	std::size_t	direct::mEnd	{0ULL};
+	// Physical memory end to be mapped
+	std::size_t	direct::mLimit	{0ULL};
+
+
+	// Map physical memory reported by multiboot
+	void direct::init(const multiboot::memoryMapEntry* map, const std::size_t size) noexcept {
+
+		// Find physical memory end (ACPI and NVS regions are mapped too)
+		auto last	= quad_t(0ULL);
+		// Memory map entries iterator
+		auto entry	= map;
+		// Memory map end address
+		const auto end	= reinterpret_cast<std::size_t>(map) + size;
+		// Loop through memory map
+		while (reinterpret_cast<std::size_t>(entry) < end) {
+			// Skip bad memory
+			if (multiboot::MEMORY_MAP_TYPE::BAD != entry->type) {
+				last = ((entry->address + entry->length) > last) ? (entry->address + entry->length) : last;
+			}
+			// Move to next memory map entry
+			entry = reinterpret_cast<const multiboot::memoryMapEntry*>(reinterpret_cast<std::size_t>(entry) + entry->size + sizeof(entry->size));
+		}
+		// Clip to direct map limit
+		last = (last > platform::DIRECT_MAP_LIMIT()) ? platform::DIRECT_MAP_LIMIT() : last;
+		// Round up to whole steps
+		direct::mLimit = static_cast<std::size_t>((last + DIRECT_MAP_STEP - 1ULL) & ~quad_t(DIRECT_MAP_STEP - 1ULL));
+
+		// Direct map is global and writable (huge pages are picked by paging)
+		constexpr auto flags = kflags<paging::FLAGS> {
+			paging::FLAGS::GLOBAL,
+			paging::FLAGS::WRITABLE,
+			paging::FLAGS::PRESENT
+		};
+		// Map by steps, so running out of bootstrap page tables leaves valid prefix (calling again maps the rest)
+		while (direct::mEnd < direct::mLimit) {
+			// Map next step
+			if (!paging::mapRange(reinterpret_cast<const page_t*>(direct::mEnd), physToVirt(direct::mEnd), DIRECT_MAP_STEP, flags)) {
+				break;
+			}
+			direct::mEnd += DIRECT_MAP_STEP;
+		}
+
+	}
+
+
+	// Get mapped physical memory end
+	[[nodiscard]]
+	std::size_t direct::end() noexcept {
+		return direct::mEnd;
+	}
+
+	// Get physical memory end to be mapped
+	[[nodiscard]]
+	std::size_t direct::limit() noexcept {
+		return direct::mLimit;
+	}
+
+
+	// Print direct map state
+	void direct::print() noexcept {
+		klib::kprintf(
+			u8"DIRECT MAP:\r\n"
+			u8"\tPhys:\t0x%p - 0x%p\r\n"
+			u8"\tVirt:\t0x%p\r\n"
+			u8"\tSize:\t%d Mb. of %d Mb.",
+			reinterpret_cast<pointer_t>(0ULL),
+			reinterpret_cast<pointer_t>(direct::mEnd),
+			physToVirt(0ULL),
+			static_cast<dword_t>(direct::mEnd >> 20U),
+			static_cast<dword_t>(direct::mLimit >> 20U)
+		);
+	}
+
+
+}	// namespace igros::mem
+
@@ -15,6 +15,12 @@
 
 #include <platform.hpp>
 
+#include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#include <klib/kmemory.hpp>
+#include <klib/kprint.hpp>
+
 #include <mem/mmap.hpp>
 
 
@@ -22,71 +28,780 @@
 namespace igros::mem {
 
 
-	// Free pages pointer
-	pointer_t phys::freePageList {nullptr};
+	// Low memory (BIOS data, bootloader structures) end frame (1 Mb)
+	constexpr auto PHYS_LOW_MEMORY_END	= 0x100000ULL >> DEFAULT_PAGE_SHIFT;
 
 
-	// Initialize physical memory
-	void phys::init(const multiboot::memoryMapEntry* map, const std::size_t size) noexcept {
+	// Frames descriptors chunk order (frames descriptors are initialized by chunks of max order blocks)
+	constexpr auto PHYS_CHUNK_ORDER		= PHYS_MAX_ORDER;
+	// Chunks bitmap word bits count
+	constexpr auto PHYS_CHUNK_BITS		= sizeof(std::size_t) << 3;
+
+
+	// Frames descriptors
+	frame_t*		phys::mFrames				{nullptr};
+	// Initialized frames descriptors chunks bitmap
+	std::size_t*		phys::mChunks				{nullptr};
+	// First managed frame number
+	std::size_t		phys::mFramesFirst			{0ULL};
+	// Managed frames count
+	std::size_t		phys::mFramesCount			{0ULL};
+	// Frame past the last memory passed to allocators
+	std::size_t		phys::mMapped				{0ULL};
+	// Per-node memory zones
+	zone_t			phys::mZones[NUMA_MAX_NODES][PHYS_ZONES]	{};
+	// Failed allocations per requested zone
+	std::size_t		phys::mFailures[PHYS_ZONES]		{};
+	// Per-CPU free pages magazines
+	magazine		phys::mPages[MAGAZINE_CPUS]		{};
+	// Pre-zeroed pages list
+	pointer_t		phys::mZeroed				{nullptr};
+	// Pre-zeroed pages count
+	std::size_t		phys::mZeroedCount			{0ULL};
+	// Zeroed allocations served by pool
+	std::size_t		phys::mZeroHits				{0ULL};
+	// Zeroed allocations zeroed in place
+	std::size_t		phys::mZeroMisses			{0ULL};
+	// Pages zeroed in idle time
+	std::size_t		phys::mZeroPages			{0ULL};
+	// Idle time zeroing TSC cycles
+	std::size_t		phys::mZeroCycles			{0ULL};
 
+
+	// Walk through available memory map entries below limit as whole frame ranges
+	template<typename F>
+	static void mapWalk(const multiboot::memoryMapEntry* map, const std::size_t size, const std::size_t limit, F &&func) noexcept {
 		// Memory map entries iterator
 		auto entry	= map;
-		// Previous entry pointer
-		auto prevEntry	= static_cast<pointer_t>(nullptr);
+		// Memory map end address
+		const auto end	= reinterpret_cast<std::size_t>(map) + size;
 		// Loop through memory map
-		while (reinterpret_cast<std::size_t>(entry) < size) {
+		while (reinterpret_cast<std::size_t>(entry) < end) {
 			// Check if entry is available
-			if (	(multiboot::MEMORY_MAP_TYPE::AVAILABLE		== entry->type)
-				&& ((reinterpret_cast<std::size_t>(entry)	< reinterpret_cast<std::size_t>(platform::KERNEL_START()))
-				|| (reinterpret_cast<std::size_t>(entry)	> reinterpret_cast<std::size_t>(platform::KERNEL_END())))) {
-				// Initial entry's memory offset
-				auto entrySize = 0ULL;
-				// Loop through entry's memory
-				while ((entry->address + entrySize) < entry->length) {
-					// Calculate new entry address
-					const auto newEntry = pointer_t(entry->address + entrySize);
-					// Place previous entry's pointer in current entry
-					*reinterpret_cast<pointer_t*>(newEntry) = prevEntry;
-					// Save new entry's address ass new oldEntry's address
-					prevEntry = newEntry;
-					// Increment size by one page (4KB)
-					entrySize += DEFAULT_PAGE_SIZE;
+			if (multiboot::MEMORY_MAP_TYPE::AVAILABLE == entry->type) {
+				// First whole frame of entry
+				auto first	= (entry->address + DEFAULT_PAGE_SIZE - 1ULL) >> DEFAULT_PAGE_SHIFT;
+				// Frame past the last whole frame of entry
+				auto last	= (entry->address + entry->length) >> DEFAULT_PAGE_SHIFT;
+				// Skip low memory
+				first		= (first < PHYS_LOW_MEMORY_END) ? PHYS_LOW_MEMORY_END : first;
+				// Skip memory above limit
+				last		= (last > (limit >> DEFAULT_PAGE_SHIFT)) ? (limit >> DEFAULT_PAGE_SHIFT) : last;
+				// Check if anything left
+				if (first < last) {
+					func(static_cast<std::size_t>(first), static_cast<std::size_t>(last));
 				}
 			}
 			// Move to next memory map entry
-			entry = reinterpret_cast<multiboot::memoryMapEntry*>(std::size_t(entry) + entry->size + sizeof(entry->size));
+			entry = reinterpret_cast<const multiboot::memoryMapEntry*>(reinterpret_cast<std::size_t>(entry) + entry->size + sizeof(entry->size));
+		}
+	}
+
+	// Get zone of frame with end of the same zone frames run
+	[[nodiscard]]
+	static std::size_t zoneOf(const std::size_t pfn, std::size_t &end) noexcept {
+		if (pfn < PHYS_ZONE_DMA_END) {
+			end = PHYS_ZONE_DMA_END;
+			return static_cast<std::size_t>(ZONE::DMA);
+		}
+		if (pfn < PHYS_ZONE_DMA32_END) {
+			end = PHYS_ZONE_DMA32_END;
+			return static_cast<std::size_t>(ZONE::DMA32);
+		}
+		end = ~std::size_t(0ULL);
+		return static_cast<std::size_t>(ZONE::NORMAL);
+	}
+
+	// Split frames range by NUMA nodes and zones
+	template<typename F>
+	static void zoneSplit(const range_t &range, F &&func) noexcept {
+		// Loop through same node and zone runs of range
+		for (auto first = range.first; first < range.last;) {
+			auto nodeEnd	= std::size_t(0ULL);
+			auto zoneEnd	= std::size_t(0ULL);
+			const auto node	= numa::nodeOf(first, &nodeEnd);
+			const auto zone	= zoneOf(first, zoneEnd);
+			// Run ends at nearest boundary
+			auto last	= (nodeEnd < zoneEnd) ? nodeEnd : zoneEnd;
+			last		= (last < range.last) ? last : range.last;
+			func(node, zone, first, last);
+			first		= last;
+		}
+	}
+
+	// Check zone may give pages away (own zone requests keep low watermark unless reserve is used, lower zones keep high watermark)
+	[[nodiscard]]
+	static bool allowed(const zone_t &zone, const std::size_t pages, const bool own, const bool reserve) noexcept {
+		// Free pages to keep
+		const auto mark = own ? (reserve ? 0ULL : zone.low) : zone.high;
+		return zone.allocator.freePages() >= (pages + mark);
+	}
+
+
+	// Add memory region except reserved ranges
+	void phys::addRegion(const range_t &range, const range_t* reserved, const std::size_t count) noexcept {
+		// Check if range is empty
+		if (range.first >= range.last) {
+			return;
+		}
+		// No reservations left - pass range to its zones allocators
+		if (0ULL == count) {
+			zoneSplit(range, [](const auto node, const auto zone, const auto first, const auto last) noexcept {
+				phys::mZones[node][zone].allocator.addRegion({first, last});
+				phys::mZones[node][zone].pages += last - first;
+			});
+			return;
+		}
+		// Reservation doesn't intersect range
+		if (	(reserved->last <= range.first)
+			|| (reserved->first >= range.last)) {
+			phys::addRegion(range, reserved + 1ULL, count - 1ULL);
+			return;
+		}
+		// Add parts of range before and after reservation
+		phys::addRegion({range.first, reserved->first}, reserved + 1ULL, count - 1ULL);
+		phys::addRegion({reserved->last, range.last}, reserved + 1ULL, count - 1ULL);
+	}
+
+
+	// Initialize physical memory
+	void phys::init(const multiboot::memoryMapEntry* map, const std::size_t size) noexcept {
+
+		// Kernel image frames
+		const auto kernel = range_t {
+			(reinterpret_cast<std::size_t>(platform::KERNEL_START()) - platform::KERNEL_OFFSET()) >> DEFAULT_PAGE_SHIFT,
+			(reinterpret_cast<std::size_t>(platform::KERNEL_END()) - platform::KERNEL_OFFSET() + DEFAULT_PAGE_SIZE - 1U) >> DEFAULT_PAGE_SHIFT
+		};
+
+		// Find managed frames span of each node zone
+		range_t spans[NUMA_MAX_NODES][PHYS_ZONES] {};
+		for (auto &zones : spans) {
+			for (auto &span : zones) {
+				span = {~std::size_t(0ULL), 0ULL};
+			}
+		}
+		// (memory to be direct mapped later is counted too, frames descriptors can't grow)
+		mapWalk(map, size, direct::limit(), [&spans](const auto regionFirst, const auto regionLast) noexcept {
+			zoneSplit({regionFirst, regionLast}, [&spans](const auto node, const auto zone, const auto runFirst, const auto runLast) noexcept {
+				auto &span	= spans[node][zone];
+				span.first	= (runFirst < span.first) ? runFirst : span.first;
+				span.last	= (runLast > span.last) ? runLast : span.last;
+			});
+		});
+		// Find managed frames span with allocators metadata size
+		auto first	= ~std::size_t(0ULL);
+		auto last	= std::size_t(0ULL);
+		auto metadata	= std::size_t(0ULL);
+		for (auto &zones : spans) {
+			for (auto &span : zones) {
+				// Zone without memory
+				if (span.first >= span.last) {
+					span = {0ULL, 0ULL};
+					continue;
+				}
+				first		= (span.first < first) ? span.first : first;
+				last		= (span.last > last) ? span.last : last;
+				metadata	+= physAllocator_t::metadata(span);
+			}
+		}
+		// Check if there is any memory
+		if (first >= last) {
+			return;
+		}
+		// Align managed span to frames descriptors chunks
+		first	&= ~((std::size_t(1ULL) << PHYS_CHUNK_ORDER) - 1ULL);
+		last	= (last + (std::size_t(1ULL) << PHYS_CHUNK_ORDER) - 1ULL) & ~((std::size_t(1ULL) << PHYS_CHUNK_ORDER) - 1ULL);
+
+		// Frames descriptors chunks bitmap size (in words)
+		const auto chunksSize = static_cast<std::size_t>((((last - first) >> PHYS_CHUNK_ORDER) + PHYS_CHUNK_BITS - 1ULL) / PHYS_CHUNK_BITS);
+		// Frames descriptors with chunks bitmap and allocator metadata size (in frames)
+		const auto framesSize = static_cast<std::size_t>(((last - first) * sizeof(frame_t) + chunksSize * sizeof(std::size_t) + metadata + DEFAULT_PAGE_SIZE - 1U) >> DEFAULT_PAGE_SHIFT);
+		// Find place for frames descriptors inside direct map and outside of kernel image (DMA zone is the last resort)
+		auto frames = range_t {0ULL, 0ULL};
+		const std::size_t bottoms[] {PHYS_ZONE_DMA_END, 0ULL};
+		for (const auto bottom : bottoms) {
+			mapWalk(map, size, direct::end(), [&kernel, &frames, framesSize, bottom](const auto regionFirst, const auto regionLast) noexcept {
+				// Already placed
+				if (0ULL != frames.last) {
+					return;
+				}
+				// Region start above bottom
+				const auto start = (regionFirst > bottom) ? regionFirst : bottom;
+				// Region parts before and after kernel image
+				const range_t parts[] {
+					{start, (regionLast < kernel.first) ? regionLast : kernel.first},
+					{(start > kernel.last) ? start : kernel.last, regionLast}
+				};
+				// Check if any part fits
+				for (const auto &part : parts) {
+					if ((part.first < part.last) && ((part.last - part.first) >= framesSize)) {
+						frames = {part.first, part.first + framesSize};
+						return;
+					}
+				}
+			});
+		}
+		// No place for frames descriptors
+		if (0ULL == frames.last) {
+			return;
+		}
+
+		// Setup frames descriptors (initialized lazily by chunks)
+		phys::mFrames		= static_cast<frame_t*>(frameAddress(frames.first));
+		phys::mFramesFirst	= first;
+		phys::mFramesCount	= last - first;
+		// Setup chunks bitmap right after frames descriptors
+		phys::mChunks		= reinterpret_cast<std::size_t*>(&phys::mFrames[phys::mFramesCount]);
+		// No chunks initialized yet
+		klib::kmemset(phys::mChunks, chunksSize * sizeof(std::size_t), byte_t(0x00));
+		// Setup zones allocators with their metadata right after chunks bitmap
+		auto storage = reinterpret_cast<byte_t*>(&phys::mChunks[chunksSize]);
+		for (auto node = 0ULL; node < numa::nodes(); node++) {
+			for (auto zone = 0ULL; zone < PHYS_ZONES; zone++) {
+				phys::mZones[node][zone].allocator.init(spans[node][zone], storage);
+				storage += physAllocator_t::metadata(spans[node][zone]);
+			}
 		}
-		// Linked list of free pages 
-		phys::freePageList = prevEntry;
+
+		// Reserved ranges
+		const range_t reserved[] {
+			kernel,
+			frames
+		};
+		// Pass direct mapped memory regions to allocator
+		mapWalk(map, size, direct::end(), [&reserved](const auto regionFirst, const auto regionLast) noexcept {
+			phys::addRegion({regionFirst, regionLast}, reserved, sizeof(reserved) / sizeof(reserved[0]));
+		});
+		phys::mMapped = direct::end() >> DEFAULT_PAGE_SHIFT;
+
+		// Setup zones watermarks
+		phys::watermarks();
 
 	}
 
+	// Manage memory direct mapped after initialization
+	void phys::extend(const multiboot::memoryMapEntry* map, const std::size_t size) noexcept {
+		// Check frames descriptors are set up
+		if (nullptr == phys::mFrames) {
+			return;
+		}
+		// Memory below managed end (kernel image and frames descriptors too) was passed already
+		const auto from = phys::mMapped;
+		{
+			// Keep interrupt handlers away from allocator
+			arch::irqGuard guard;
+			mapWalk(map, size, direct::end(), [from](const auto regionFirst, const auto regionLast) noexcept {
+				phys::addRegion({(regionFirst > from) ? regionFirst : from, regionLast}, nullptr, 0ULL);
+			});
+			phys::mMapped = direct::end() >> DEFAULT_PAGE_SHIFT;
+			// Zones grew
+			phys::watermarks();
+		}
+	}
+
+
+	// Setup zones watermarks
+	void phys::watermarks() noexcept {
+		for (auto node = 0ULL; node < numa::nodes(); node++) {
+			for (auto &zone : phys::mZones[node]) {
+				zone.low	= zone.pages >> PHYS_WATERMARK_SHIFT;
+				zone.high	= zone.low << 1;
+			}
+		}
+	}
+
 
-	// Allcoate physical page
-   	[[nodiscard]] pointer_t phys::alloc() noexcept {
-		// Check if we have free pages
-		if (nullptr != phys::freePageList) {
-			// Get page pointer
-			const auto page		= phys::freePageList;
-			// Remove page from list of free pages
-			phys::freePageList	= reinterpret_cast<pointer_t>(*static_cast<std::size_t*>(phys::freePageList));
-			// Return page pointer
-			return page;
+	// Get zone owning frame
+	[[nodiscard]]
+	zone_t& phys::owner(const std::size_t pfn) noexcept {
+		auto end = std::size_t(0ULL);
+		return phys::mZones[numa::nodeOf(pfn)][zoneOf(pfn, end)];
+	}
+
+	// Allocate pages from nearest node zones allowed by watermarks
+	template<typename F>
+	[[nodiscard]]
+	pointer_t phys::allocNear(const std::size_t pages, const ZONE zone, const bool reserve, F &&func) noexcept {
+		// Current CPU node
+		const auto local = numa::local();
+		// Requested zone
+		const auto own = static_cast<std::size_t>(zone);
+		// Try nodes by distance
+		for (auto step = 0ULL; step < numa::nodes(); step++) {
+			auto &zones = phys::mZones[numa::fallback(local, step)];
+			// Try requested zone first, then lower ones
+			for (auto index = own + 1ULL; index-- > 0ULL;) {
+				auto &current = zones[index];
+				// Zone is below its watermark
+				if (!allowed(current, pages, own == index, reserve)) {
+					continue;
+				}
+				const auto page = func(current.allocator);
+				if (nullptr != page) {
+					// Count higher zone request served
+					if (own != index) {
+						++current.fallbacks;
+					}
+					return page;
+				}
+			}
 		}
-		// No free pages left
 		return nullptr;
 	}
 
-	// Free physical page
-	void phys::free(pointer_t &page) noexcept {
+
+	// Allocate single page via current CPU magazine
+	[[nodiscard]]
+	pointer_t phys::allocPage() noexcept {
+		// Magazine is CPU-local, so only interrupts should be kept away
+		arch::irqGuard guard;
+		// Current CPU magazine
+		auto &pages = phys::mPages[arch::cpu::get().index()];
+		// Refill empty magazine from allocator by batch
+		if (pages.empty()) {
+			pages.miss();
+			for (auto i = 0ULL; i < MAGAZINE_BATCH; i++) {
+				// Get page from nearest node
+				const auto page = phys::allocNear(1ULL, ZONE::NORMAL, false, [](auto &allocator) noexcept {
+					return allocator.alloc(0ULL);
+				});
+				if (nullptr == page) {
+					break;
+				}
+				// Mark page cached
+				phys::frame(frameNumber(page))->flags = FRAME_FLAGS::CACHED;
+				pages.push(page);
+			}
+		} else {
+			pages.hit();
+		}
+		// Take page from magazine
+		const auto page = pages.pop();
+		if (nullptr != page) {
+			// Mark page allocated
+			phys::frame(frameNumber(page))->flags = FRAME_FLAGS::ALLOCATED;
+		}
+		return page;
+	}
+
+	// Free single page via current CPU magazine
+	void phys::freePage(const pointer_t page) noexcept {
+		// Magazine is CPU-local, so only interrupts should be kept away
+		arch::irqGuard guard;
+		// Check page is allocated single page (interrupt handler can't change frame state in between)
+		const auto frame = phys::frame(frameNumber(page));
+		if (	(nullptr == frame)
+			|| (FRAME_FLAGS::ALLOCATED != frame->flags)
+			|| (0U != frame->order)
+			|| (nullptr != frame->owner)) {
+			return;
+		}
+		// Current CPU magazine
+		auto &pages = phys::mPages[arch::cpu::get().index()];
+		// Drain full magazine to allocator by batch
+		if (pages.full()) {
+			pages.miss();
+			for (auto i = 0ULL; i < MAGAZINE_BATCH; i++) {
+				// Take page from magazine
+				const auto cached = pages.pop();
+				// Return page to its node allocator
+				phys::frame(frameNumber(cached))->flags = FRAME_FLAGS::ALLOCATED;
+				phys::owner(frameNumber(cached)).allocator.free(cached, 0ULL);
+			}
+		} else {
+			pages.hit();
+		}
+		// Put page to magazine
+		frame->flags = FRAME_FLAGS::CACHED;
+		pages.push(page);
+	}
+
+	// Return current CPU magazine pages to allocator
+	void phys::drain() noexcept {
+		// Magazine is CPU-local, so only interrupts should be kept away
+		arch::irqGuard guard;
+		// Current CPU magazine
+		auto &pages = phys::mPages[arch::cpu::get().index()];
+		// Return all cached pages
+		while (!pages.empty()) {
+			// Take page from magazine
+			const auto cached = pages.pop();
+			// Return page to its node allocator
+			phys::frame(frameNumber(cached))->flags = FRAME_FLAGS::ALLOCATED;
+			phys::owner(frameNumber(cached)).allocator.free(cached, 0ULL);
+		}
+	}
+
+
+	// Allcoate 2^order physical pages from zone (or lower ones)
+   	[[nodiscard]] pointer_t phys::alloc(const std::size_t order, const ZONE zone) noexcept {
+		// Unconstrained single pages are served by per-CPU magazines and pre-zeroed pool
+		if (	(0ULL == order)
+			&& (ZONE::NORMAL == zone)) {
+			const auto page = phys::allocPage();
+			if (nullptr != page) {
+				return page;
+			}
+			const auto zeroed = phys::takeZeroed();
+			if (nullptr != zeroed) {
+				return zeroed;
+			}
+		}
+		// Keep interrupt handlers away from allocator
+		arch::irqGuard guard;
+		// Block allocation
+		const auto block = [order](auto &allocator) noexcept {
+			return allocator.alloc(order);
+		};
+		// Allocate pages block from nearest node above watermarks
+		auto page = phys::allocNear(std::size_t(1ULL) << order, zone, false, block);
+		if (nullptr == page) {
+			// Pages cached in magazine may prevent blocks merge, low watermark reserve is the last resort
+			phys::drain();
+			page = phys::allocNear(std::size_t(1ULL) << order, zone, true, block);
+		}
+		// Count failure
+		if (nullptr == page) {
+			++phys::mFailures[static_cast<std::size_t>(zone)];
+		}
+		return page;
+	}
+
+	// Free 2^order physical pages
+	void phys::free(pointer_t &page, const std::size_t order) noexcept {
+		// Error check
+		if (nullptr == page) {
+			return;
+		}
+		// Single pages go to per-CPU magazines
+		if (0ULL == order) {
+			phys::freePage(page);
+		} else {
+			// Keep interrupt handlers away from allocator
+			arch::irqGuard guard;
+			// Return pages to their zone allocator
+			phys::owner(frameNumber(page)).allocator.free(page, order);
+		}
+		page = nullptr;
+	}
+
+
+	// Take page from pre-zeroed pool (nullptr if empty)
+	[[nodiscard]]
+	pointer_t phys::takeZeroed() noexcept {
+		// Keep interrupt handlers away from pool
+		arch::irqGuard guard;
+		// Check pool
+		const auto page = phys::mZeroed;
+		if (nullptr == page) {
+			return nullptr;
+		}
+		// Unlink page
+		phys::mZeroed = *static_cast<pointer_t*>(page);
+		--phys::mZeroedCount;
+		// Clear list link
+		*static_cast<pointer_t*>(page) = nullptr;
+		return page;
+	}
+
+	// Allocate zeroed physical page (pre-zeroed pool first)
+	[[nodiscard]]
+	pointer_t phys::allocZeroed() noexcept {
+		{
+			// Keep interrupt handlers away from pool and its counters
+			arch::irqGuard guard;
+			// Take pre-zeroed page
+			const auto zeroed = phys::takeZeroed();
+			if (nullptr != zeroed) {
+				++phys::mZeroHits;
+				return zeroed;
+			}
+			++phys::mZeroMisses;
+		}
+		// Zero page in place (it's about to be used, so cached stores are fine)
+		const auto page = phys::alloc();
+		if (nullptr != page) {
+			klib::kmemset(page, DEFAULT_PAGE_SIZE, byte_t(0x00));
+		}
+		return page;
+	}
+
+	// Zero single page for pool in idle time (false if nothing to do)
+	bool phys::zeroIdle() noexcept {
+		// Pool is full
+		if (phys::mZeroedCount >= PHYS_ZERO_POOL) {
+			return false;
+		}
+		// Take page from magazine or allocator only (phys::alloc falls back to the pool itself)
+		const auto page = phys::allocPage();
+		if (nullptr == page) {
+			return false;
+		}
+		// Zero page bypassing cache
+		const auto begin = arch::cpu::get().timestamp();
+		arch::cpu::get().zeroPage(page);
+		const auto cycles = static_cast<std::size_t>(arch::cpu::get().timestamp() - begin);
+		// Keep interrupt handlers away from pool
+		arch::irqGuard guard;
+		// Put page to pool
+		*static_cast<pointer_t*>(page)	= phys::mZeroed;
+		phys::mZeroed			= page;
+		++phys::mZeroedCount;
+		++phys::mZeroPages;
+		phys::mZeroCycles += cycles;
+		return true;
+	}
+
+
+	// Allocate contiguous physical pages range
+	[[nodiscard]]
+	pointer_t phys::allocRange(const std::size_t count, const std::size_t alignment, const ZONE zone) noexcept {
+		// Keep interrupt handlers away from allocator
+		arch::irqGuard guard;
+		// Range allocation
+		const auto range = [count, alignment](auto &allocator) noexcept {
+			return allocator.allocRange(count, alignment);
+		};
+		// Allocate pages range from nearest node above watermarks
+		auto page = phys::allocNear(count, zone, false, range);
+		if (nullptr == page) {
+			// Pages cached in magazine may split free ranges, low watermark reserve is the last resort
+			phys::drain();
+			page = phys::allocNear(count, zone, true, range);
+		}
+		// Count failure
+		if (nullptr == page) {
+			++phys::mFailures[static_cast<std::size_t>(zone)];
+		}
+		return page;
+	}
+
+	// Free contiguous physical pages range
+	void phys::freeRange(pointer_t &page, const std::size_t count) noexcept {
 		// Error check
 		if (nullptr == page) {
 			return;
 		}
-		// Return page to free pages list
-		*static_cast<pointer_t*>(page)	= phys::freePageList;
-		phys::freePageList		= reinterpret_cast<pointer_t>(*static_cast<std::size_t*>(phys::freePageList));
-		page				= nullptr;
+		// Keep interrupt handlers away from allocator
+		arch::irqGuard guard;
+		// Return pages to their zone allocator (range never spans zones)
+		phys::owner(frameNumber(page)).allocator.freeRange(page, count);
+		page = nullptr;
+	}
+
+
+	// Get frame descriptor by frame number (nullptr if not managed or not initialized)
+	[[nodiscard]]
+	frame_t* phys::frame(const std::size_t pfn) noexcept {
+		// Check frame is managed
+		if (	(pfn < phys::mFramesFirst)
+			|| (pfn >= (phys::mFramesFirst + phys::mFramesCount))) {
+			return nullptr;
+		}
+		// Check frame descriptors chunk is initialized
+		const auto chunk = (pfn - phys::mFramesFirst) >> PHYS_CHUNK_ORDER;
+		if (0ULL == (phys::mChunks[chunk / PHYS_CHUNK_BITS] & (std::size_t(1ULL) << (chunk % PHYS_CHUNK_BITS)))) {
+			return nullptr;
+		}
+		// Return frame descriptor
+		return &phys::mFrames[pfn - phys::mFramesFirst];
+	}
+
+	// Initialize frames descriptors of range on first touch
+	void phys::prepare(const range_t &range) noexcept {
+		// Clip range to managed frames
+		const auto first	= (range.first > phys::mFramesFirst) ? range.first : phys::mFramesFirst;
+		const auto last		= (range.last < (phys::mFramesFirst + phys::mFramesCount)) ? range.last : (phys::mFramesFirst + phys::mFramesCount);
+		// Check if anything left
+		if (first >= last) {
+			return;
+		}
+		// Loop through all chunks of range
+		for (auto chunk = (first - phys::mFramesFirst) >> PHYS_CHUNK_ORDER; chunk <= ((last - 1ULL - phys::mFramesFirst) >> PHYS_CHUNK_ORDER); chunk++) {
+			// Chunk bit
+			const auto bit = std::size_t(1ULL) << (chunk % PHYS_CHUNK_BITS);
+			// Already initialized
+			if (0ULL != (phys::mChunks[chunk / PHYS_CHUNK_BITS] & bit)) {
+				continue;
+			}
+			// Frames in chunk are not managed by default
+			klib::kmemset(&phys::mFrames[chunk << PHYS_CHUNK_ORDER], sizeof(frame_t) << PHYS_CHUNK_ORDER, byte_t(0x00));
+			// Mark chunk initialized
+			phys::mChunks[chunk / PHYS_CHUNK_BITS] |= bit;
+		}
+	}
+
+
+	// Take extra frame reference (frame is shared by one more mapping)
+	void phys::ref(const pointer_t page) noexcept {
+		// Get frame descriptor
+		const auto desc = phys::frame(frameNumber(page));
+		if (nullptr == desc) {
+			return;
+		}
+		// Keep fault handler away from counter
+		arch::irqGuard guard;
+		++desc->refs;
+	}
+
+	// Drop frame reference (true if caller was the last owner)
+	[[nodiscard]]
+	bool phys::unref(const pointer_t page) noexcept {
+		// Get frame descriptor (unmanaged frames are never freed)
+		const auto desc = phys::frame(frameNumber(page));
+		if (nullptr == desc) {
+			return false;
+		}
+		// Keep fault handler away from counter
+		arch::irqGuard guard;
+		// Last owner
+		if (0U == desc->refs) {
+			return true;
+		}
+		--desc->refs;
+		return false;
+	}
+
+
+	// Get node pages kept in magazines and pre-zeroed pool
+	[[nodiscard]]
+	std::size_t phys::cachedPages(const std::size_t node) noexcept {
+		// Keep interrupt handlers away from magazines and pool
+		arch::irqGuard guard;
+		// Count magazines pages of node
+		auto count = std::size_t(0ULL);
+		for (const auto &pages : phys::mPages) {
+			for (auto i = 0ULL; i < pages.count(); i++) {
+				count += (node == numa::nodeOf(frameNumber(pages.at(i)))) ? 1ULL : 0ULL;
+			}
+		}
+		// Count pre-zeroed pages of node
+		for (auto page = phys::mZeroed; nullptr != page; page = *static_cast<pointer_t*>(page)) {
+			count += (node == numa::nodeOf(frameNumber(page))) ? 1ULL : 0ULL;
+		}
+		return count;
+	}
+
+
+	// Get free pages count (pages cached in magazines and pre-zeroed pool are counted)
+	[[nodiscard]]
+	std::size_t phys::freePages() noexcept {
+		// Nodes allocators free pages count
+		auto count = std::size_t(0ULL);
+		for (auto node = 0ULL; node < numa::nodes(); node++) {
+			count += phys::freePages(node);
+		}
+		// Add pages cached in magazines
+		for (const auto &pages : phys::mPages) {
+			count += pages.count();
+		}
+		// Add pre-zeroed pages
+		return count + phys::mZeroedCount;
+	}
+
+	// Get node free pages count (pages cached in magazines and pre-zeroed pool are not counted)
+	[[nodiscard]]
+	std::size_t phys::freePages(const std::size_t node) noexcept {
+		// Sum up node zones
+		auto count = std::size_t(0ULL);
+		for (auto zone = 0ULL; zone < PHYS_ZONES; zone++) {
+			count += phys::freePages(node, static_cast<ZONE>(zone));
+		}
+		return count;
+	}
+
+	// Get node zone free pages count
+	[[nodiscard]]
+	std::size_t phys::freePages(const std::size_t node, const ZONE zone) noexcept {
+		return (node < numa::nodes()) ? phys::mZones[node][static_cast<std::size_t>(zone)].allocator.freePages() : 0ULL;
+	}
+
+	// Get node used pages count (pages cached in magazines and pre-zeroed pool are not used)
+	[[nodiscard]]
+	std::size_t phys::usedPages(const std::size_t node) noexcept {
+		// Node is not present
+		if (node >= numa::nodes()) {
+			return 0ULL;
+		}
+		// Sum up node zones managed pages
+		auto count = std::size_t(0ULL);
+		for (const auto &zone : phys::mZones[node]) {
+			count += zone.pages;
+		}
+		return count - phys::freePages(node) - phys::cachedPages(node);
+	}
+
+
+	// Print physical memory state
+	void phys::print() noexcept {
+		// Print header
+		klib::kprintf(
+			u8"PHYSICAL MEMORY:\r\n"
+			u8"\tFrames:\t0x%p - 0x%p\r\n",
+			reinterpret_cast<pointer_t>(phys::mFramesFirst << DEFAULT_PAGE_SHIFT),
+			reinterpret_cast<pointer_t>((phys::mFramesFirst + phys::mFramesCount) << DEFAULT_PAGE_SHIFT)
+		);
+		// Zones names
+		constexpr const sbyte_t* names[PHYS_ZONES] {u8"DMA", u8"DMA32", u8"Normal"};
+		// Print nodes zones state
+		for (auto node = 0ULL; node < numa::nodes(); node++) {
+			klib::kprintf(
+				u8"\tNode %d:\t%d pages free, %d pages cached, %d pages used",
+				static_cast<dword_t>(node),
+				static_cast<dword_t>(phys::freePages(node)),
+				static_cast<dword_t>(phys::cachedPages(node)),
+				static_cast<dword_t>(phys::usedPages(node))
+			);
+			for (auto index = 0ULL; index < PHYS_ZONES; index++) {
+				// Skip empty zones
+				const auto &zone = phys::mZones[node][index];
+				if (0ULL == zone.pages) {
+					continue;
+				}
+				klib::kprintf(
+					u8"\t%s:\t%d of %d pages free, watermarks %d/%d, %d fallbacks",
+					names[index],
+					static_cast<dword_t>(zone.allocator.freePages()),
+					static_cast<dword_t>(zone.pages),
+					static_cast<dword_t>(zone.low),
+					static_cast<dword_t>(zone.high),
+					static_cast<dword_t>(zone.fallbacks)
+				);
+				zone.allocator.print();
+			}
+		}
+		// Print failed allocations per requested zone
+		klib::kprintf(
+			u8"\tFailed:\t%d DMA, %d DMA32, %d Normal",
+			static_cast<dword_t>(phys::mFailures[static_cast<std::size_t>(ZONE::DMA)]),
+			static_cast<dword_t>(phys::mFailures[static_cast<std::size_t>(ZONE::DMA32)]),
+			static_cast<dword_t>(phys::mFailures[static_cast<std::size_t>(ZONE::NORMAL)])
+		);
+		// Print magazines usage
+		for (auto cpu = 0ULL; cpu < MAGAZINE_CPUS; cpu++) {
+			// Skip unused magazines
+			const auto &pages = phys::mPages[cpu];
+			if (0ULL == (pages.hits() + pages.misses())) {
+				continue;
+			}
+			klib::kprintf(
+				u8"\tCPU %d:\t%d pages cached, %d hits, %d misses",
+				static_cast<dword_t>(cpu),
+				static_cast<dword_t>(pages.count()),
+				static_cast<dword_t>(pages.hits()),
+				static_cast<dword_t>(pages.misses())
+			);
+		}
+		// Average idle time page zeroing cost
+		const auto cycles = (0ULL != phys::mZeroPages) ? (phys::mZeroCycles / phys::mZeroPages) : 0ULL;
+		// Print pre-zeroed pool usage (each hit saves page zeroing on allocation path)
+		klib::kprintf(
+			u8"\tZeroed:\t%d pages pooled, %d hits, %d misses, ~%d cycles saved per hit",
+			static_cast<dword_t>(phys::mZeroedCount),
+			static_cast<dword_t>(phys::mZeroHits),
+			static_cast<dword_t>(phys::mZeroMisses),
+			static_cast<dword_t>(cycles)
+		);
 	}
 
 
@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////
+//
+//	NUMA nodes topology definition
+//
+//	File:	numa.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <arch/cpu.hpp>
+
+#include <klib/kprint.hpp>
+
+#include <mem/frame.hpp>
+#include <mem/numa.hpp>
+
+#include <sys/acpi.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// SRAT entry enabled flag
+	constexpr auto NUMA_SRAT_ENABLED	= 0x00000001U;
+	// Node boundaries granularity (max order blocks never span two nodes)
+	constexpr auto NUMA_RANGE_MASK		= ~((quad_t(1ULL) << PHYS_MAX_ORDER) - 1ULL);
+
+
+	// Nodes count
+	std::size_t	numa::mNodes						{0ULL};
+	// Proximity domain of each node
+	dword_t		numa::mDomains[NUMA_MAX_NODES]				{};
+	// Memory ranges
+	numaRange_t	numa::mRanges[NUMA_MAX_RANGES]				{};
+	// Memory ranges count
+	std::size_t	numa::mRangesCount					{0ULL};
+	// Nodes distances
+	byte_t		numa::mDistance[NUMA_MAX_NODES][NUMA_MAX_NODES]		{};
+	// Nodes fallback order
+	std::size_t	numa::mOrder[NUMA_MAX_NODES][NUMA_MAX_NODES]		{};
+	// Node of each CPU
+	std::size_t	numa::mCPUs[MAGAZINE_CPUS]				{};
+
+
+	// Get node index of proximity domain (new node is added if possible)
+	[[nodiscard]]
+	std::size_t numa::node(const dword_t domain) noexcept {
+		// Known domain
+		for (auto i = 0ULL; i < numa::mNodes; i++) {
+			if (domain == numa::mDomains[i]) {
+				return i;
+			}
+		}
+		// Too many domains - fold extra ones into first node
+		if (numa::mNodes >= NUMA_MAX_NODES) {
+			return 0ULL;
+		}
+		// Add new node
+		numa::mDomains[numa::mNodes] = domain;
+		return numa::mNodes++;
+	}
+
+
+	// Parse System Resource Affinity Table
+	void numa::parseSRAT() noexcept {
+		// Find table
+		const auto srat = reinterpret_cast<const sys::acpiSRAT_t*>(sys::acpi::table(u8"SRAT"));
+		if (nullptr == srat) {
+			return;
+		}
+		// Entries follow table header
+		auto entry	= reinterpret_cast<const byte_t*>(srat) + sizeof(sys::acpiSRAT_t);
+		const auto end	= reinterpret_cast<const byte_t*>(srat) + srat->header.length;
+		// Enabled CPUs count (CPU index follows SRAT order)
+		auto cpus	= 0ULL;
+		// Loop through entries
+		while ((entry + sizeof(sys::acpiSRATEntry_t)) <= end) {
+			// Check entry fits table
+			const auto header = reinterpret_cast<const sys::acpiSRATEntry_t*>(entry);
+			if (	(header->length < sizeof(sys::acpiSRATEntry_t))
+				|| ((entry + header->length) > end)) {
+				break;
+			}
+			switch (static_cast<sys::ACPI_SRAT_TYPE>(header->type)) {
+				// Local APIC affinity
+				case sys::ACPI_SRAT_TYPE::CPU: {
+					const auto cpu = reinterpret_cast<const sys::acpiSRATCpu_t*>(entry);
+					if (	(0U != (cpu->flags & NUMA_SRAT_ENABLED))
+						&& (cpus < MAGAZINE_CPUS)) {
+						// Proximity domain is split into low byte and high 3 bytes
+						const auto domain = dword_t(cpu->proximityLow)
+							| (dword_t(cpu->proximityHigh[0]) << 8)
+							| (dword_t(cpu->proximityHigh[1]) << 16)
+							| (dword_t(cpu->proximityHigh[2]) << 24);
+						numa::mCPUs[cpus++] = numa::node(domain);
+					}
+					break;
+				}
+				// Local x2APIC affinity
+				case sys::ACPI_SRAT_TYPE::CPU_X2APIC: {
+					const auto cpu = reinterpret_cast<const sys::acpiSRATCpu2_t*>(entry);
+					if (	(0U != (cpu->flags & NUMA_SRAT_ENABLED))
+						&& (cpus < MAGAZINE_CPUS)) {
+						numa::mCPUs[cpus++] = numa::node(cpu->proximity);
+					}
+					break;
+				}
+				// Memory affinity
+				case sys::ACPI_SRAT_TYPE::MEMORY: {
+					const auto memory = reinterpret_cast<const sys::acpiSRATMemory_t*>(entry);
+					if (	(0U == (memory->flags & NUMA_SRAT_ENABLED))
+						|| (numa::mRangesCount >= NUMA_MAX_RANGES)) {
+						break;
+					}
+					// Range boundaries are rounded down to max order blocks
+					const auto first	= static_cast<std::size_t>(((memory->base >> DEFAULT_PAGE_SHIFT) & NUMA_RANGE_MASK));
+					const auto last		= static_cast<std::size_t>((((memory->base + memory->length) >> DEFAULT_PAGE_SHIFT) & NUMA_RANGE_MASK));
+					if (first >= last) {
+						break;
+					}
+					// Insert range keeping list sorted
+					auto i = numa::mRangesCount++;
+					for (; (i > 0ULL) && (numa::mRanges[i - 1ULL].first > first); i--) {
+						numa::mRanges[i] = numa::mRanges[i - 1ULL];
+					}
+					numa::mRanges[i] = {first, last, numa::node(memory->proximity)};
+					break;
+				}
+				// Other entries are not used
+				default:
+					break;
+			}
+			// Move to next entry
+			entry += header->length;
+		}
+	}
+
+	// Parse System Locality Information Table
+	void numa::parseSLIT() noexcept {
+		// Find table
+		const auto slit = reinterpret_cast<const sys::acpiSLIT_t*>(sys::acpi::table(u8"SLIT"));
+		if (nullptr == slit) {
+			return;
+		}
+		// Check distances matrix fits table
+		const auto localities = slit->localities;
+		if ((sizeof(sys::acpiSLIT_t) + localities * localities) > slit->header.length) {
+			return;
+		}
+		// Distances matrix is indexed by proximity domains
+		const auto matrix = reinterpret_cast<const byte_t*>(slit) + sizeof(sys::acpiSLIT_t);
+		for (auto from = 0ULL; from < numa::mNodes; from++) {
+			for (auto to = 0ULL; to < numa::mNodes; to++) {
+				if (	(numa::mDomains[from] < localities)
+					&& (numa::mDomains[to] < localities)) {
+					numa::mDistance[from][to] = matrix[static_cast<std::size_t>(numa::mDomains[from] * localities + numa::mDomains[to])];
+				}
+			}
+		}
+	}
+
+
+	// Detect nodes
+	void numa::init() noexcept {
+		// Parse affinity information
+		numa::parseSRAT();
+		// Single node if nothing found
+		if (0ULL == numa::mNodes) {
+			numa::mNodes		= 1ULL;
+			numa::mRangesCount	= 0ULL;
+		}
+		// Default distances
+		for (auto from = 0ULL; from < numa::mNodes; from++) {
+			for (auto to = 0ULL; to < numa::mNodes; to++) {
+				numa::mDistance[from][to] = (from == to) ? NUMA_LOCAL_DISTANCE : NUMA_REMOTE_DISTANCE;
+			}
+		}
+		// Real distances
+		numa::parseSLIT();
+		// Sort fallback order of each node by distance (node itself goes first)
+		for (auto from = 0ULL; from < numa::mNodes; from++) {
+			auto &order = numa::mOrder[from];
+			// Distance sort key (node itself wins ties)
+			const auto key = [from](const std::size_t to) noexcept {
+				return (std::size_t(numa::mDistance[from][to]) << 1) | ((from == to) ? 0ULL : 1ULL);
+			};
+			// Insertion sort
+			for (auto i = 0ULL; i < numa::mNodes; i++) {
+				auto j = i;
+				for (; (j > 0ULL) && (key(order[j - 1ULL]) > key(i)); j--) {
+					order[j] = order[j - 1ULL];
+				}
+				order[j] = i;
+			}
+		}
+	}
+
+
+	// Get nodes count
+	[[nodiscard]]
+	std::size_t numa::nodes() noexcept {
+		return numa::mNodes;
+	}
+
+	// Get node of frame (memory not described by SRAT belongs to first node)
+	[[nodiscard]]
+	std::size_t numa::nodeOf(const std::size_t pfn, std::size_t* end) noexcept {
+		// Ranges are sorted by address
+		for (auto i = 0ULL; i < numa::mRangesCount; i++) {
+			const auto &range = numa::mRanges[i];
+			// Frame is inside hole before range
+			if (pfn < range.first) {
+				if (nullptr != end) {
+					*end = range.first;
+				}
+				return 0ULL;
+			}
+			// Frame is inside range
+			if (pfn < range.last) {
+				if (nullptr != end) {
+					*end = range.last;
+				}
+				return range.node;
+			}
+		}
+		// Frame is after all ranges
+		if (nullptr != end) {
+			*end = ~std::size_t(0ULL);
+		}
+		return 0ULL;
+	}
+
+	// Get current CPU node
+	[[nodiscard]]
+	std::size_t numa::local() noexcept {
+		// Current CPU index
+		const auto cpu = arch::cpu::get().index();
+		return (cpu < MAGAZINE_CPUS) ? numa::mCPUs[cpu] : 0ULL;
+	}
+
+	// Get node to try at given fallback step
+	[[nodiscard]]
+	std::size_t numa::fallback(const std::size_t node, const std::size_t step) noexcept {
+		return ((node < numa::mNodes) && (step < numa::mNodes)) ? numa::mOrder[node][step] : 0ULL;
+	}
+
+	// Get distance between nodes
+	[[nodiscard]]
+	std::size_t numa::distance(const std::size_t from, const std::size_t to) noexcept {
+		return ((from < numa::mNodes) && (to < numa::mNodes)) ? numa::mDistance[from][to] : NUMA_REMOTE_DISTANCE;
+	}
+
+
+	// Print nodes topology
+	void numa::print() noexcept {
+		// Print header
+		klib::kprintf(
+			u8"NUMA:\r\n"
+			u8"\tNodes:\t%d (CPU %d is on node %d)",
+			static_cast<dword_t>(numa::mNodes),
+			static_cast<dword_t>(arch::cpu::get().index()),
+			static_cast<dword_t>(numa::local())
+		);
+		// Print nodes with nearest fallback node
+		for (auto node = 0ULL; node < numa::mNodes; node++) {
+			// Nearest remote node (node itself if single)
+			const auto next = (numa::mNodes > 1ULL) ? numa::mOrder[node][1] : node;
+			klib::kprintf(
+				u8"\tNode %d:\tdomain %d, fallback node %d (distance %d)",
+				static_cast<dword_t>(node),
+				numa::mDomains[node],
+				static_cast<dword_t>(next),
+				static_cast<dword_t>(numa::mDistance[node][next])
+			);
+		}
+		// Print memory ranges
+		for (auto i = 0ULL; i < numa::mRangesCount; i++) {
+			klib::kprintf(
+				u8"\tRange:\t0x%p - 0x%p on node %d",
+				reinterpret_cast<pointer_t>(numa::mRanges[i].first << DEFAULT_PAGE_SHIFT),
+				reinterpret_cast<pointer_t>(numa::mRanges[i].last << DEFAULT_PAGE_SHIFT),
+				static_cast<dword_t>(numa::mRanges[i].node)
+			);
+		}
+	}
+
+
+}	// namespace igros::mem
+
@@ -0,0 +1,368 @@
+////////////////////////////////////////////////////////////////
+//
+//	Slab object cache allocator
+//
+//	File:	slab.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#include <klib/kprint.hpp>
+
+#include <mem/mmap.hpp>
+#include <mem/slab.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Registered caches list
+	cache*	cache::mCaches	{nullptr};
+
+
+	// Get list slab belongs to by its usage
+	[[nodiscard]]
+	cache::slab_t*& cache::list(const slab_t* slab) noexcept {
+		// Empty slab
+		if (0ULL == slab->inUse) {
+			return mEmpty;
+		}
+		// Full or partial slab
+		return (mObjects == slab->inUse) ? mFull : mPartial;
+	}
+
+	// Link slab to list
+	void cache::link(slab_t* &head, slab_t* slab) noexcept {
+		// Link slab as new list head
+		slab->next	= head;
+		slab->prev	= nullptr;
+		// Update old head
+		if (nullptr != head) {
+			head->prev = slab;
+		}
+		// Set new list head
+		head		= slab;
+	}
+
+	// Unlink slab from list
+	void cache::unlink(slab_t* &head, slab_t* slab) noexcept {
+		// Unlink from previous slab (or list head)
+		if (nullptr != slab->prev) {
+			slab->prev->next = slab->next;
+		} else {
+			head = slab->next;
+		}
+		// Unlink from next slab
+		if (nullptr != slab->next) {
+			slab->next->prev = slab->prev;
+		}
+	}
+
+
+	// Allocate new slab
+	[[nodiscard]]
+	cache::slab_t* cache::grow() noexcept {
+		// Check object fits slab
+		if (0ULL == mObjects) {
+			return nullptr;
+		}
+		// Allocate slab pages
+		const auto page = phys::alloc(mOrder);
+		if (nullptr == page) {
+			return nullptr;
+		}
+		// Setup slab header
+		const auto slab	= static_cast<slab_t*>(page);
+		slab->owner	= this;
+		slab->freeList	= nullptr;
+		slab->inUse	= 0ULL;
+		// First object address (shifted by slab color)
+		const auto base = static_cast<byte_t*>(page) + mOffset + mColorNext * mColorStep;
+		// Move to next color
+		if (++mColorNext >= mColors) {
+			mColorNext = 0ULL;
+		}
+		// Construct objects and build free objects list (lowest address first)
+		for (auto i = mObjects; i > 0ULL; i--) {
+			const auto object = base + (i - 1ULL) * mSize;
+			if (nullptr != mCtor) {
+				mCtor(object);
+			}
+			next(object)	= slab->freeList;
+			slab->freeList	= object;
+		}
+		// Mark slab frames as owned by slab
+		const auto pfn = frameNumber(page);
+		for (auto i = 0ULL; i < (1ULL << mOrder); i++) {
+			phys::frame(pfn + i)->owner = slab;
+		}
+		// Register cache on first slab
+		if (!mRegistered) {
+			mNext		= cache::mCaches;
+			cache::mCaches	= this;
+			mRegistered	= true;
+		}
+		// Put slab to empty list
+		link(mEmpty, slab);
+		++mEmptyCount;
+		++mSlabs;
+		return slab;
+	}
+
+	// Return slab pages
+	void cache::release(slab_t* slab) noexcept {
+		// Take slab from empty list
+		unlink(mEmpty, slab);
+		--mEmptyCount;
+		--mSlabs;
+		// Destroy objects (all of them are free in empty slab)
+		if (nullptr != mDtor) {
+			for (auto object = slab->freeList; nullptr != object; object = next(object)) {
+				mDtor(object);
+			}
+		}
+		// Slab frames are not owned anymore
+		const auto pfn = frameNumber(slab);
+		for (auto i = 0ULL; i < (1ULL << mOrder); i++) {
+			phys::frame(pfn + i)->owner = nullptr;
+		}
+		// Return slab pages
+		auto page = static_cast<pointer_t>(slab);
+		phys::free(page, mOrder);
+	}
+
+
+	// Get free object list link
+	[[nodiscard]]
+	pointer_t& cache::next(const pointer_t object) const noexcept {
+		return *reinterpret_cast<pointer_t*>(static_cast<byte_t*>(object) + mLink);
+	}
+
+
+	// Take object from slabs
+	[[nodiscard]]
+	pointer_t cache::take() noexcept {
+		// Prefer partial slabs, then empty ones, then allocate new slab
+		auto slab = mPartial;
+		if (nullptr == slab) {
+			slab = (nullptr != mEmpty) ? mEmpty : grow();
+			if (nullptr == slab) {
+				return nullptr;
+			}
+		}
+		// Take slab from its list
+		unlink(list(slab), slab);
+		if (0ULL == slab->inUse) {
+			--mEmptyCount;
+		}
+		// Take object from slab free list
+		const auto object	= slab->freeList;
+		slab->freeList		= next(object);
+		++slab->inUse;
+		// Put slab to list matching its new usage
+		link(list(slab), slab);
+		return object;
+	}
+
+	// Return object to its slab
+	void cache::put(const pointer_t object) noexcept {
+		// Get slab object belongs to
+		const auto slab = static_cast<slab_t*>(phys::frame(frameNumber(object))->owner);
+		// Take slab from its list
+		unlink(list(slab), slab);
+		// Return object to slab free list
+		next(object)	= slab->freeList;
+		slab->freeList	= object;
+		--slab->inUse;
+		// Put slab to list matching its new usage
+		link(list(slab), slab);
+		// Keep limited amount of empty slabs
+		if (0ULL == slab->inUse) {
+			++mEmptyCount;
+			if (mEmptyCount > SLAB_EMPTY_LIMIT) {
+				release(slab);
+			}
+		}
+	}
+
+	// Return magazine objects to slabs
+	void cache::drain(magazine &objects) noexcept {
+		while (!objects.empty()) {
+			put(objects.pop());
+		}
+	}
+
+
+	// Allocate object
+	[[nodiscard]]
+	pointer_t cache::alloc() noexcept {
+		// Object to return
+		auto object = static_cast<pointer_t>(nullptr);
+		{
+			// Magazine is CPU-local, so only interrupts should be kept away
+			arch::irqGuard guard;
+			// Current CPU magazine
+			auto &objects = mMagazines[arch::cpu::get().index()];
+			// Refill empty magazine from slabs by batch
+			if (objects.empty()) {
+				objects.miss();
+				for (auto i = 0ULL; i < MAGAZINE_BATCH; i++) {
+					// Take object from slabs
+					const auto taken = take();
+					if (nullptr == taken) {
+						break;
+					}
+					objects.push(taken);
+				}
+			} else {
+				objects.hit();
+			}
+			// Take object from magazine
+			object = objects.pop();
+			if (nullptr == object) {
+				return nullptr;
+			}
+			++mInUse;
+		}
+		// Object is constructed already
+		return object;
+	}
+
+	// Free object
+	void cache::free(const pointer_t object) noexcept {
+		// Error check
+		if (nullptr == object) {
+			return;
+		}
+		// Find slab object belongs to
+		const auto frame = phys::frame(frameNumber(object));
+		if (	(nullptr == frame)
+			|| (nullptr == frame->owner)) {
+			return;
+		}
+		// Check slab belongs to this cache
+		if (this != static_cast<slab_t*>(frame->owner)->owner) {
+			return;
+		}
+		// Object stays constructed until its slab is released
+		// Magazine is CPU-local, so only interrupts should be kept away
+		arch::irqGuard guard;
+		// Current CPU magazine
+		auto &objects = mMagazines[arch::cpu::get().index()];
+		// Drain full magazine to slabs by batch
+		if (objects.full()) {
+			objects.miss();
+			for (auto i = 0ULL; i < MAGAZINE_BATCH; i++) {
+				put(objects.pop());
+			}
+		} else {
+			objects.hit();
+		}
+		// Put object to magazine
+		objects.push(object);
+		--mInUse;
+	}
+
+
+	// Return empty slabs pages
+	void cache::shrink() noexcept {
+		// Keep interrupt handlers away from cache (only bootstrap CPU is running, so other magazines are idle)
+		arch::irqGuard guard;
+		// Return cached objects of all CPUs to slabs
+		for (auto &objects : mMagazines) {
+			drain(objects);
+		}
+		// Return empty slabs
+		while (nullptr != mEmpty) {
+			release(mEmpty);
+		}
+	}
+
+
+	// Get object size
+	[[nodiscard]]
+	std::size_t cache::size() const noexcept {
+		return mObjectSize;
+	}
+
+	// Get allocated objects count
+	[[nodiscard]]
+	std::size_t cache::inUse() const noexcept {
+		return mInUse;
+	}
+
+
+	// Get cache object belongs to (nullptr if not a slab object)
+	[[nodiscard]]
+	cache* cache::owner(const pointer_t object) noexcept {
+		// Get object frame
+		const auto frame = phys::frame(frameNumber(object));
+		if (	(nullptr == frame)
+			|| (nullptr == frame->owner)) {
+			return nullptr;
+		}
+		// Return slab owner
+		return static_cast<slab_t*>(frame->owner)->owner;
+	}
+
+
+	// Print cache statistics
+	void cache::print() const noexcept {
+		// Objects cached in magazines
+		auto cached = std::size_t(0ULL);
+		for (const auto &objects : mMagazines) {
+			cached += objects.count();
+		}
+		// Print cache usage
+		klib::kprintf(
+			u8"\t%s:\tsize %d, in use %d of %d (%d cached), slabs %d (order %d, %d empty), waste %d bytes",
+			mName,
+			static_cast<dword_t>(mObjectSize),
+			static_cast<dword_t>(mInUse),
+			static_cast<dword_t>(mSlabs * mObjects),
+			static_cast<dword_t>(cached),
+			static_cast<dword_t>(mSlabs),
+			static_cast<dword_t>(mOrder),
+			static_cast<dword_t>(mEmptyCount),
+			static_cast<dword_t>(mSlabs * (slabSize(mOrder) - mObjects * mObjectSize))
+		);
+		// Print magazines usage
+		for (auto cpu = 0ULL; cpu < MAGAZINE_CPUS; cpu++) {
+			// Skip unused magazines
+			const auto &objects = mMagazines[cpu];
+			if (0ULL == (objects.hits() + objects.misses())) {
+				continue;
+			}
+			klib::kprintf(
+				u8"\t\tCPU %d:\t%d cached, %d hits, %d misses",
+				static_cast<dword_t>(cpu),
+				static_cast<dword_t>(objects.count()),
+				static_cast<dword_t>(objects.hits()),
+				static_cast<dword_t>(objects.misses())
+			);
+		}
+	}
+
+	// Print all caches statistics
+	void cache::printAll() noexcept {
+		// Print header
+		klib::kprintf(u8"SLAB CACHES:");
+		// Loop through registered caches
+		for (auto current = cache::mCaches; nullptr != current; current = current->mNext) {
+			current->print();
+		}
+	}
+
+
+}	// namespace igros::mem
+
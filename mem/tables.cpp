@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////
+//
+//	Page tables pool
+//
+//	File:	tables.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <arch/irq.hpp>
+
+#include <klib/kmemory.hpp>
+#include <klib/kprint.hpp>
+
+#include <mem/mmap.hpp>
+#include <mem/tables.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Bootstrap tables (part of kernel image, so no guessing what lies after its end)
+	alignas(DEFAULT_PAGE_SIZE) static byte_t tablesBootstrap[TABLES_BOOTSTRAP][DEFAULT_PAGE_SIZE];
+
+
+	// Free tables list
+	tables::node_t*	tables::mFree		{nullptr};
+	// Free tables count
+	std::size_t	tables::mFreeCount	{0ULL};
+	// Allocated tables count
+	std::size_t	tables::mUsed		{0ULL};
+	// Lowest free tables count seen
+	std::size_t	tables::mLowest		{0ULL};
+	// Refills from physical memory count
+	std::size_t	tables::mRefills	{0ULL};
+	// Failed allocations count
+	std::size_t	tables::mFailures	{0ULL};
+
+
+	// Put zeroed table to free list
+	void tables::push(const pointer_t table) noexcept {
+		// Link table as new list head
+		const auto node	= static_cast<node_t*>(table);
+		node->next	= tables::mFree;
+		tables::mFree	= node;
+		++tables::mFreeCount;
+	}
+
+	// Refill pool from physical memory
+	void tables::refill() noexcept {
+		// Count refill attempt
+		++tables::mRefills;
+		// Take batch of pages
+		for (auto i = 0ULL; i < TABLES_BATCH; i++) {
+			// Allocate zeroed page (tables are kept zeroed)
+			const auto page = phys::allocZeroed();
+			if (nullptr == page) {
+				break;
+			}
+			tables::push(page);
+		}
+	}
+
+
+	// Initialize pool with bootstrap tables
+	void tables::init() noexcept {
+		// Reset pool
+		tables::mFree		= nullptr;
+		tables::mFreeCount	= 0ULL;
+		tables::mUsed		= 0ULL;
+		// Zero bootstrap tables
+		klib::kmemset(tablesBootstrap, sizeof(tablesBootstrap), byte_t(0x00));
+		// Put bootstrap tables to pool
+		for (auto &table : tablesBootstrap) {
+			tables::push(table);
+		}
+		tables::mLowest		= tables::mFreeCount;
+	}
+
+
+	// Allocate zeroed table
+	[[nodiscard]]
+	pointer_t tables::alloc() noexcept {
+		// Keep interrupt handlers away from pool
+		arch::irqGuard guard;
+		// Keep enough tables ready
+		if (tables::mFreeCount < TABLES_LOW_WATER) {
+			tables::refill();
+		}
+		// Check pool is exhausted
+		if (nullptr == tables::mFree) {
+			++tables::mFailures;
+			return nullptr;
+		}
+		// Take table from free list
+		const auto node	= tables::mFree;
+		tables::mFree	= node->next;
+		--tables::mFreeCount;
+		++tables::mUsed;
+		// Track pool pressure
+		if (tables::mFreeCount < tables::mLowest) {
+			tables::mLowest = tables::mFreeCount;
+		}
+		// Clear list link so table is fully zeroed
+		node->next = nullptr;
+		return node;
+	}
+
+	// Free table
+	void tables::free(const pointer_t table) noexcept {
+		// Check table is page aligned
+		if (	(nullptr == table)
+			|| (0ULL != (reinterpret_cast<std::size_t>(table) & (DEFAULT_PAGE_SIZE - 1ULL)))) {
+			return;
+		}
+		// Tables are kept zeroed
+		klib::kmemset(table, DEFAULT_PAGE_SIZE, byte_t(0x00));
+		// Keep interrupt handlers away from pool
+		arch::irqGuard guard;
+		// Return table to pool
+		tables::push(table);
+		--tables::mUsed;
+	}
+
+
+	// Get free tables count
+	[[nodiscard]]
+	std::size_t tables::freeTables() noexcept {
+		return tables::mFreeCount;
+	}
+
+
+	// Print pool state
+	void tables::print() noexcept {
+		klib::kprintf(
+			u8"PAGE TABLES:\r\n"
+			u8"\tFree:\t%d (lowest %d, low water %d)\r\n"
+			u8"\tUsed:\t%d\r\n"
+			u8"\tRefills:\t%d\r\n"
+			u8"\tFailures:\t%d",
+			static_cast<dword_t>(tables::mFreeCount),
+			static_cast<dword_t>(tables::mLowest),
+			static_cast<dword_t>(TABLES_LOW_WATER),
+			static_cast<dword_t>(tables::mUsed),
+			static_cast<dword_t>(tables::mRefills),
+			static_cast<dword_t>(tables::mFailures)
+		);
+	}
+
+
+}	// namespace igros::mem
+
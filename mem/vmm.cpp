@@ -0,0 +1,652 @@
+////////////////////////////////////////////////////////////////
+//
+//	Virtual memory areas and page fault handling
+//
+//	File:	vmm.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <platform.hpp>
+#include <flags.hpp>
+
+#include <arch/cpu.hpp>
+#include <arch/irq.hpp>
+
+#if	defined (IGROS_ARCH_i386)
+#include <arch/i386/paging.hpp>
+#elif	defined (IGROS_ARCH_x86_64)
+#include <arch/x86_64/paging.hpp>
+#endif
+
+#include <klib/kmemory.hpp>
+#include <klib/kprint.hpp>
+
+#include <mem/mmap.hpp>
+#include <mem/slab.hpp>
+#include <mem/vmm.hpp>
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+#if	defined (IGROS_ARCH_i386)
+	// Paging type
+	using paging	= i386::paging;
+	// Page type
+	using page_t	= i386::page_t;
+	// Page tables root type
+	using root_t	= i386::directory_t;
+	// Page entry physical address mask
+	constexpr auto VMM_ENTRY_ADDR_MASK	= i386::PAGE_ENTRY_ADDR_MASK;
+	// Page entry flags mask
+	constexpr auto VMM_ENTRY_FLAGS_MASK	= i386::PAGE_MASK;
+#elif	defined (IGROS_ARCH_x86_64)
+	// Paging type
+	using paging	= x86_64::paging;
+	// Page type
+	using page_t	= x86_64::page_t;
+	// Page tables root type
+	using root_t	= x86_64::pml4_t;
+	// Page entry physical address mask
+	constexpr auto VMM_ENTRY_ADDR_MASK	= x86_64::PAGE_ENTRY_ADDR_MASK;
+	// Page entry flags mask
+	constexpr auto VMM_ENTRY_FLAGS_MASK	= x86_64::PAGE_MASK;
+#endif
+
+	// Raw page entry flags
+	constexpr auto VMM_ENTRY_PRESENT	= static_cast<std::size_t>(paging::FLAGS::PRESENT);
+	constexpr auto VMM_ENTRY_WRITABLE	= static_cast<std::size_t>(paging::FLAGS::WRITABLE);
+	constexpr auto VMM_ENTRY_COW		= static_cast<std::size_t>(paging::FLAGS::COPY_ON_WRITE);
+
+	// Page offset mask
+	constexpr auto VMM_PAGE_MASK	= std::size_t(DEFAULT_PAGE_SIZE) - 1ULL;
+
+
+	// Areas descriptors cache
+	static kcache<area_t> areaCache {u8"vm-area"};
+
+
+	// Get page tables root
+	[[nodiscard]]
+	pointer_t space::root() const noexcept {
+		// Space without own root lives in active one
+		return (nullptr != mRoot) ? mRoot : static_cast<pointer_t>(paging::root());
+	}
+
+
+	// Get areas list
+	[[nodiscard]]
+	const area_t* space::areas() const noexcept {
+		return mAreas;
+	}
+
+
+	// Find area containing address
+	[[nodiscard]]
+	const area_t* space::find(const std::size_t addr) const noexcept {
+		// Areas are sorted, so stop at first area ending after address
+		for (auto area = mAreas; nullptr != area; area = area->next) {
+			if (addr < area->end) {
+				return (addr >= area->start) ? area : nullptr;
+			}
+		}
+		// Nothing found
+		return nullptr;
+	}
+
+	// Find free range of given length inside [from, to) (0 if none)
+	[[nodiscard]]
+	std::size_t space::gap(const std::size_t from, const std::size_t to, const std::size_t length) const noexcept {
+		// Candidate range start
+		auto start = from;
+		// Check space before each area
+		for (auto area = mAreas; nullptr != area; area = area->next) {
+			// Skip areas before candidate
+			if (area->end <= start) {
+				continue;
+			}
+			// Found fitting hole
+			if ((area->start >= start) && ((area->start - start) >= length)) {
+				break;
+			}
+			// Try right after area
+			start = area->end;
+		}
+		// Check range fits window
+		return ((start < to) && ((to - start) >= length)) ? start : 0ULL;
+	}
+
+
+	// Add area (false if it overlaps existing one or out of memory)
+	[[nodiscard]]
+	bool space::insert(const std::size_t start, const std::size_t length, const kflags<AREA_FLAGS> flags) noexcept {
+		// Check range
+		const auto end = start + length;
+		if (	(0ULL == length)
+			|| (end < start)) {
+			return false;
+		}
+		// Find list position
+		auto prev = static_cast<area_t*>(nullptr);
+		auto next = mAreas;
+		while ((nullptr != next) && (next->end <= start)) {
+			prev = next;
+			next = next->next;
+		}
+		// Check overlap with next area
+		if ((nullptr != next) && (next->start < end)) {
+			return false;
+		}
+		// Make area descriptor
+		const auto area = areaCache.alloc();
+		if (nullptr == area) {
+			return false;
+		}
+		area->start	= start;
+		area->end	= end;
+		area->flags	= flags;
+		area->next	= next;
+		// Link area
+		if (nullptr != prev) {
+			prev->next = area;
+		} else {
+			mAreas = area;
+		}
+		++mCount;
+		return true;
+	}
+
+	// Remove area starting at address (returns its length, 0 if not found)
+	std::size_t space::remove(const std::size_t start) noexcept {
+		// Find area
+		auto prev = static_cast<area_t*>(nullptr);
+		auto area = mAreas;
+		while ((nullptr != area) && (area->start != start)) {
+			prev = area;
+			area = area->next;
+		}
+		// Not found
+		if (nullptr == area) {
+			return 0ULL;
+		}
+		// Unlink area
+		if (nullptr != prev) {
+			prev->next = area->next;
+		} else {
+			mAreas = area->next;
+		}
+		--mCount;
+		// Free area descriptor
+		const auto length = area->end - area->start;
+		areaCache.free(area);
+		return length;
+	}
+
+
+	// Print areas
+	void space::print() const noexcept {
+		klib::kprintf(u8"\tAreas:\t%d", static_cast<dword_t>(mCount));
+		for (auto area = mAreas; nullptr != area; area = area->next) {
+			klib::kprintf(
+				u8"\t\t0x%p - 0x%p %s%s%s",
+				reinterpret_cast<pointer_t>(area->start),
+				reinterpret_cast<pointer_t>(area->end),
+				((area->flags & AREA_FLAGS::WRITABLE) != AREA_FLAGS::NONE)	? u8"W" : u8"-",
+				((area->flags & AREA_FLAGS::USER) != AREA_FLAGS::NONE)		? u8"U" : u8"-",
+				((area->flags & AREA_FLAGS::ZERO) != AREA_FLAGS::NONE)		? u8"Z" : u8"-"
+			);
+		}
+	}
+
+
+	// Kernel address space
+	space		vmm::mKernel		{};
+	// Resolved faults count
+	std::size_t	vmm::mMinorFaults	{0ULL};
+	// Unresolved faults count
+	std::size_t	vmm::mFailedFaults	{0ULL};
+	// Copy-on-write faults count
+	std::size_t	vmm::mSharedFaults	{0ULL};
+	// Copy-on-write faults that copied frame count
+	std::size_t	vmm::mCopiedFaults	{0ULL};
+	// Resolved faults total TSC cycles
+	std::size_t	vmm::mFaultCycles	{0ULL};
+	// Slowest resolved fault TSC cycles
+	std::size_t	vmm::mFaultCyclesMax	{0ULL};
+
+
+	// Get kernel address space
+	[[nodiscard]]
+	space& vmm::kernel() noexcept {
+		return vmm::mKernel;
+	}
+
+
+	// Resolve copy-on-write fault of present page
+	[[nodiscard]]
+	bool vmm::copyOnWrite(const std::size_t virt) noexcept {
+		// Get page entry
+		const auto addr		= reinterpret_cast<pointer_t>(virt);
+		const auto entry	= paging::leaf(addr);
+		if (	(nullptr == entry)
+			|| (0ULL == (*entry & VMM_ENTRY_COW))) {
+			return false;
+		}
+		++vmm::mSharedFaults;
+		// Shared frame
+		const auto frame	= physToVirt(*entry & VMM_ENTRY_ADDR_MASK);
+		// Private writable flags
+		const auto flags	= (*entry & VMM_ENTRY_FLAGS_MASK & ~VMM_ENTRY_COW) | VMM_ENTRY_WRITABLE;
+		// Last owner takes frame back without copying
+		if (phys::unref(frame)) {
+			*entry = (*entry & VMM_ENTRY_ADDR_MASK) | flags;
+			paging::invalidate(addr);
+			return true;
+		}
+		// Copy frame
+		auto page = phys::alloc();
+		if (nullptr == page) {
+			phys::ref(frame);
+			return false;
+		}
+		klib::kmemcpy(page, frame, DEFAULT_PAGE_SIZE);
+		// Map private copy (stale read-only translation is dropped by paging)
+		if (!paging::mapRange(reinterpret_cast<const page_t*>(virtToPhys(page)), addr, DEFAULT_PAGE_SIZE, kflags<paging::FLAGS> {flags})) {
+			phys::free(page);
+			phys::ref(frame);
+			return false;
+		}
+		++vmm::mCopiedFaults;
+		return true;
+	}
+
+	// Map zeroed frame on first touch of anonymous area
+	[[nodiscard]]
+	bool vmm::demandZero(const std::size_t virt, const bool write) noexcept {
+		// Only kernel address space exists for now
+		const auto area = vmm::mKernel.find(virt);
+		// Only anonymous areas are resolved
+		if (	(nullptr == area)
+			|| ((area->flags & AREA_FLAGS::ZERO) == AREA_FLAGS::NONE)
+			|| (write && ((area->flags & AREA_FLAGS::WRITABLE) == AREA_FLAGS::NONE))) {
+			return false;
+		}
+		// Take zeroed frame
+		auto page = phys::allocZeroed();
+		if (nullptr == page) {
+			return false;
+		}
+		// Page flags from area flags
+		auto flags = kflags<paging::FLAGS> {paging::FLAGS::PRESENT};
+		if ((area->flags & AREA_FLAGS::WRITABLE) != AREA_FLAGS::NONE) {
+			flags |= paging::FLAGS::WRITABLE;
+		}
+		if ((area->flags & AREA_FLAGS::USER) != AREA_FLAGS::NONE) {
+			flags |= paging::FLAGS::USER_ACCESSIBLE;
+		}
+		// Map frame (page wasn't present, so nothing to invalidate)
+		if (!paging::mapRange(static_cast<root_t*>(vmm::mKernel.root()), reinterpret_cast<const page_t*>(virtToPhys(page)), reinterpret_cast<pointer_t>(virt), DEFAULT_PAGE_SIZE, flags)) {
+			phys::free(page);
+			return false;
+		}
+		return true;
+	}
+
+
+	// Handle page fault (false if fault can't be resolved)
+	[[nodiscard]]
+	bool vmm::fault(const pointer_t addr, const bool write, const bool present) noexcept {
+		// Fault start time
+		const auto begin = arch::cpu::get().timestamp();
+		// Faulting page
+		const auto virt = reinterpret_cast<std::size_t>(addr) & ~VMM_PAGE_MASK;
+		// Write to present page may only be copy-on-write, missing page - demand zero
+		const auto resolved = present ? (write && vmm::copyOnWrite(virt)) : vmm::demandZero(virt, write);
+		if (!resolved) {
+			++vmm::mFailedFaults;
+			return false;
+		}
+		// Update statistics
+		const auto cycles = static_cast<std::size_t>(arch::cpu::get().timestamp() - begin);
+		++vmm::mMinorFaults;
+		vmm::mFaultCycles	+= cycles;
+		vmm::mFaultCyclesMax	= (cycles > vmm::mFaultCyclesMax) ? cycles : vmm::mFaultCyclesMax;
+		return true;
+	}
+
+
+	// Reserve kernel heap range (frames are allocated on first touch)
+	[[nodiscard]]
+	pointer_t vmm::reserve(const std::size_t length) noexcept {
+		// Whole pages only
+		const auto size = (length + VMM_PAGE_MASK) & ~VMM_PAGE_MASK;
+		if (0ULL == size) {
+			return nullptr;
+		}
+		// Keep fault handler away from areas list
+		arch::irqGuard guard;
+		// Find free heap range
+		const auto start = vmm::mKernel.gap(platform::HEAP_OFFSET(), platform::HEAP_OFFSET() + platform::HEAP_LIMIT(), size);
+		if (0ULL == start) {
+			return nullptr;
+		}
+		// Register anonymous area (nothing is mapped yet)
+		if (!vmm::mKernel.insert(start, size, kflags<AREA_FLAGS> {AREA_FLAGS::WRITABLE, AREA_FLAGS::ZERO})) {
+			return nullptr;
+		}
+		return reinterpret_cast<pointer_t>(start);
+	}
+
+	// Release kernel heap range (touched frames are freed)
+	void vmm::release(const pointer_t addr) noexcept {
+		// Keep fault handler away from areas list
+		arch::irqGuard guard;
+		// Remove area
+		const auto start	= reinterpret_cast<std::size_t>(addr);
+		const auto length	= vmm::mKernel.remove(start);
+		if (0ULL == length) {
+			return;
+		}
+		// Free touched frames
+		vmm::drop(vmm::mKernel, start, length);
+	}
+
+
+	// Unmap range of address space (touched frames lose reference)
+	void vmm::drop(const space &target, const std::size_t start, const std::size_t length) noexcept {
+		// Page tables root
+		const auto root = static_cast<root_t*>(target.root());
+		// Stale translations (flushed once on return)
+		paging::batch pending;
+		// Areas are mapped by 4 Kb pages only
+		for (auto virt = start; virt < (start + length); virt += DEFAULT_PAGE_SIZE) {
+			// Get page entry
+			const auto addr		= reinterpret_cast<pointer_t>(virt);
+			const auto entry	= paging::leaf(root, addr);
+			if (	(nullptr == entry)
+				|| (0ULL == (*entry & VMM_ENTRY_PRESENT))) {
+				continue;
+			}
+			// Unmap page
+			auto page = physToVirt(*entry & VMM_ENTRY_ADDR_MASK);
+			*entry = 0ULL;
+			pending.add(addr);
+			// Free frame (shared one only loses reference)
+			if (phys::unref(page)) {
+				phys::free(page);
+			}
+		}
+	}
+
+
+	// Copy address space areas frame by frame (false if out of memory)
+	[[nodiscard]]
+	bool vmm::duplicate(space &dst, const space &src) noexcept {
+		// Page tables roots
+		const auto dstRoot	= static_cast<root_t*>(dst.root());
+		const auto srcRoot	= static_cast<root_t*>(src.root());
+		// Loop through source areas
+		for (auto area = src.areas(); nullptr != area; area = area->next) {
+			// Register same area
+			if (!dst.insert(area->start, area->end - area->start, area->flags)) {
+				return false;
+			}
+			// Copy touched pages
+			for (auto virt = area->start; virt < area->end; virt += DEFAULT_PAGE_SIZE) {
+				// Get source page entry
+				const auto addr		= reinterpret_cast<pointer_t>(virt);
+				const auto entry	= paging::leaf(srcRoot, addr);
+				if (	(nullptr == entry)
+					|| (0ULL == (*entry & VMM_ENTRY_PRESENT))) {
+					continue;
+				}
+				// Copy frame
+				auto page = phys::alloc();
+				if (nullptr == page) {
+					return false;
+				}
+				klib::kmemcpy(page, physToVirt(*entry & VMM_ENTRY_ADDR_MASK), DEFAULT_PAGE_SIZE);
+				// Map private copy with writable flags restored
+				const auto flags = (*entry & VMM_ENTRY_FLAGS_MASK & ~VMM_ENTRY_COW) | (((area->flags & AREA_FLAGS::WRITABLE) != AREA_FLAGS::NONE) ? VMM_ENTRY_WRITABLE : 0ULL);
+				if (!paging::mapRange(dstRoot, reinterpret_cast<const page_t*>(virtToPhys(page)), addr, DEFAULT_PAGE_SIZE, kflags<paging::FLAGS> {flags})) {
+					phys::free(page);
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+
+	// Check if address belongs to kernel heap
+	[[nodiscard]]
+	bool vmm::heap(const pointer_t addr) noexcept {
+		// Heap window offset
+		const auto offset = reinterpret_cast<std::size_t>(addr) - platform::HEAP_OFFSET();
+		// Addresses below window wrap around
+		return offset < platform::HEAP_LIMIT();
+	}
+
+
+	// Share range between page tables roots copy-on-write (false if out of page tables)
+	[[nodiscard]]
+	bool vmm::share(const pointer_t dst, const pointer_t src, const std::size_t start, const std::size_t length) noexcept {
+		// Page tables roots
+		const auto dstRoot	= static_cast<root_t*>(dst);
+		const auto srcRoot	= static_cast<root_t*>(src);
+		// Source translations become read-only (flushed once on return)
+		paging::batch pending;
+		// Loop through range pages (only page tables are touched, frames are not copied)
+		for (auto virt = start & ~VMM_PAGE_MASK; virt < (start + length); virt += DEFAULT_PAGE_SIZE) {
+			// Get source page entry
+			const auto addr		= reinterpret_cast<pointer_t>(virt);
+			const auto entry	= paging::leaf(srcRoot, addr);
+			if (	(nullptr == entry)
+				|| (0ULL == (*entry & VMM_ENTRY_PRESENT))) {
+				continue;
+			}
+			// Writable pages become copy-on-write in both spaces
+			if (0ULL != (*entry & VMM_ENTRY_WRITABLE)) {
+				*entry = (*entry & ~VMM_ENTRY_WRITABLE) | VMM_ENTRY_COW;
+				pending.add(addr);
+			}
+			// Map same frame into destination
+			const auto frame = *entry & VMM_ENTRY_ADDR_MASK;
+			if (!paging::mapRange(dstRoot, reinterpret_cast<const page_t*>(frame), addr, DEFAULT_PAGE_SIZE, kflags<paging::FLAGS> {*entry & VMM_ENTRY_FLAGS_MASK}, &pending)) {
+				return false;
+			}
+			phys::ref(physToVirt(frame));
+		}
+		return true;
+	}
+
+
+	// Clone address space areas copy-on-write (false if out of memory)
+	[[nodiscard]]
+	bool vmm::clone(space &dst, const space &src) noexcept {
+		// Keep fault handler away from areas lists and page entries
+		arch::irqGuard guard;
+		// Loop through source areas
+		for (auto area = src.areas(); nullptr != area; area = area->next) {
+			// Register same area and share its frames
+			const auto length = area->end - area->start;
+			if (	!dst.insert(area->start, length, area->flags)
+				|| !vmm::share(dst.root(), src.root(), area->start, length)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Drop all areas of address space (page tables root stays with owner)
+	void vmm::destroy(space &target) noexcept {
+		// Keep fault handler away from areas list
+		arch::irqGuard guard;
+		// Remove areas one by one
+		while (nullptr != target.areas()) {
+			const auto start	= target.areas()->start;
+			const auto length	= target.remove(start);
+			vmm::drop(target, start, length);
+		}
+	}
+
+
+	// Compare copy-on-write clone of kernel heap range with full copy
+	void vmm::benchmark(const std::size_t length) noexcept {
+		// Whole pages only
+		const auto size		= (length + VMM_PAGE_MASK) & ~VMM_PAGE_MASK;
+		const auto pages	= size >> DEFAULT_PAGE_SHIFT;
+		// Source range and its full copy must fit free memory (with page tables)
+		if (phys::freePages() < ((pages << 1) + (pages >> 6))) {
+			klib::kprintf(u8"VMM:\tclone of %d Kb. skipped (not enough memory)", static_cast<dword_t>(size >> 10));
+			return;
+		}
+		// Empty page tables roots
+		const auto sharedRoot	= static_cast<root_t*>(paging::allocate());
+		const auto copiedRoot	= static_cast<root_t*>(paging::allocate());
+		// Source range
+		const auto source	= vmm::reserve(size);
+		if (	(nullptr == sharedRoot)
+			|| (nullptr == copiedRoot)
+			|| (nullptr == source)) {
+			paging::deallocate(sharedRoot);
+			paging::deallocate(copiedRoot);
+			vmm::release(source);
+			return;
+		}
+		// Every page is touched, so every frame is mapped
+		klib::kmemset(source, size, byte_t(0x5A));
+		// Spaces with own page tables roots
+		space shared	{sharedRoot};
+		space copied	{copiedRoot};
+		// Clone kernel heap copy-on-write
+		const auto shareStart	= arch::cpu::get().timestamp();
+		const auto cloned	= vmm::clone(shared, vmm::mKernel);
+		const auto shareCycles	= static_cast<std::size_t>(arch::cpu::get().timestamp() - shareStart);
+		// Copy kernel heap frame by frame
+		const auto copyStart	= arch::cpu::get().timestamp();
+		const auto duplicated	= vmm::duplicate(copied, vmm::mKernel);
+		const auto copyCycles	= static_cast<std::size_t>(arch::cpu::get().timestamp() - copyStart);
+		// Write to shared page copies frame, clone still owns original
+		const auto copiedBefore	= vmm::mCopiedFaults;
+		static_cast<volatile byte_t*>(source)[0ULL] = 0xA5;
+		const auto copiedShared	= vmm::mCopiedFaults - copiedBefore;
+		// Once clone is gone last owner takes frame back without copying
+		vmm::destroy(shared);
+		static_cast<volatile byte_t*>(source)[DEFAULT_PAGE_SIZE] = 0xA5;
+		const auto copiedOwned	= vmm::mCopiedFaults - copiedBefore - copiedShared;
+		// Clean up
+		vmm::destroy(copied);
+		paging::destroy(sharedRoot);
+		paging::destroy(copiedRoot);
+		vmm::release(source);
+		// Show results
+		klib::kprintf(
+			u8"VMM:\tclone of %d Kb. (%s):\t%d cycles\r\n"
+			u8"\tcopy of %d Kb. (%s):\t%d cycles\r\n"
+			u8"\tcopy-on-write:\t%d copied while shared, %d copied once owned",
+			static_cast<dword_t>(size >> 10),
+			cloned ? u8"done" : u8"failed",
+			static_cast<dword_t>(shareCycles),
+			static_cast<dword_t>(size >> 10),
+			duplicated ? u8"done" : u8"failed",
+			static_cast<dword_t>(copyCycles),
+			static_cast<dword_t>(copiedShared),
+			static_cast<dword_t>(copiedOwned)
+		);
+	}
+
+
+	// Compare batched TLB invalidation of remapped pages with whole TLB flush after every page
+	void vmm::benchmarkRemap(const std::size_t pages) noexcept {
+		// Remapped pages counts (batch flushes whole TLB above PAGE_INVALIDATE_LIMIT)
+		constexpr std::size_t counts[] {1ULL, 8ULL, 32ULL, 64ULL, 512ULL};
+		// Updates per measurement
+		constexpr auto rounds = std::size_t(16ULL);
+		// Frames and virtual window (shifted by one page, so large pages are never used)
+		auto frames		= phys::allocRange(pages);
+		const auto window	= static_cast<byte_t*>(vmm::reserve((pages + 1ULL) << DEFAULT_PAGE_SHIFT));
+		if (	(nullptr == frames)
+			|| (nullptr == window)) {
+			klib::kprintf(u8"Paging:\tremap of %d pages skipped (not enough memory)", static_cast<dword_t>(pages));
+			phys::freeRange(frames, pages);
+			vmm::release(window);
+			return;
+		}
+		const auto virt		= window + DEFAULT_PAGE_SIZE;
+		const auto phys		= reinterpret_cast<const page_t*>(virtToPhys(frames));
+		const auto flags	= kflags<paging::FLAGS> {paging::FLAGS::PRESENT, paging::FLAGS::WRITABLE};
+		paging::mapRange(phys, virt, pages << DEFAULT_PAGE_SHIFT, flags);
+		// Remap pages and touch them all (TSC cycles per page)
+		const auto remap = [virt, phys, flags](const std::size_t count, const bool batched, const bool global) noexcept {
+			const auto start = arch::cpu::get().timestamp();
+			for (auto round = 0ULL; round < rounds; round++) {
+				if (batched) {
+					// Whole update is invalidated once
+					paging::batch pending;
+					paging::unmapRange(virt, count << DEFAULT_PAGE_SHIFT, &pending);
+					paging::mapRange(phys, virt, count << DEFAULT_PAGE_SHIFT, flags, &pending);
+				} else {
+					// Every page change drops whole TLB (same as CR3 reload without global pages)
+					for (auto i = 0ULL; i < count; i++) {
+						paging::unmapRange(virt + (i << DEFAULT_PAGE_SHIFT), DEFAULT_PAGE_SIZE);
+						paging::flushTLB(global);
+						paging::mapRange(&phys[i], virt + (i << DEFAULT_PAGE_SHIFT), DEFAULT_PAGE_SIZE, flags);
+						paging::flushTLB(global);
+					}
+				}
+				// Refill TLB
+				for (auto i = 0ULL; i < count; i++) {
+					static_cast<void>(static_cast<volatile byte_t*>(virt)[i << DEFAULT_PAGE_SHIFT]);
+				}
+			}
+			return static_cast<dword_t>(static_cast<std::size_t>(arch::cpu::get().timestamp() - start) / (rounds * count));
+		};
+		// Show results
+		klib::kprintf(u8"Paging:\tremap cycles per page (batched / flush / flush with global)");
+		for (const auto count : counts) {
+			if (count > pages) {
+				break;
+			}
+			klib::kprintf(
+				u8"\t%d pages:\t%d / %d / %d",
+				static_cast<dword_t>(count),
+				remap(count, true, false),
+				remap(count, false, false),
+				remap(count, false, true)
+			);
+		}
+		// Clean up
+		paging::unmapRange(virt, pages << DEFAULT_PAGE_SHIFT);
+		vmm::release(window);
+		phys::freeRange(frames, pages);
+	}
+
+
+	// Print page faults statistics
+	void vmm::print() noexcept {
+		klib::kprintf(
+			u8"VMM:\r\n"
+			u8"\tFaults:\t%d minor, %d copy-on-write (%d copied), %d failed\r\n"
+			u8"\tCycles:\t%d avg, %d max",
+			static_cast<dword_t>(vmm::mMinorFaults),
+			static_cast<dword_t>(vmm::mSharedFaults),
+			static_cast<dword_t>(vmm::mCopiedFaults),
+			static_cast<dword_t>(vmm::mFailedFaults),
+			static_cast<dword_t>((0ULL != vmm::mMinorFaults) ? (vmm::mFaultCycles / vmm::mMinorFaults) : 0ULL),
+			static_cast<dword_t>(vmm::mFaultCyclesMax)
+		);
+		vmm::mKernel.print();
+	}
+
+
+}	// namespace igros::mem
+
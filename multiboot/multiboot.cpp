@@ -18,7 +18,7 @@
 #include <arch/types.hpp>
 #include <arch/cpu.hpp>
 
-#include <klib/kprint.hpp>
+#include <klib/klog.hpp>
 
 
 // Multiboot code zone
@@ -30,10 +30,10 @@ namespace igros::multiboot {
 		// Check multiboot magic
 		if (!multiboot::check(magic)) {
 			// Write Multiboot magic error message message
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::ERROR>(
 				u8"BAD MULTIBOOT MAGIC!!!\r\n"
 				u8"\tMagic:\t\t0x%08x\r\n"
-				u8"\tAddress:\t0x%p\r\n",
+				u8"\tAddress:\t0x%p\r\n"_fmt,
 				magic,
 				multiboot
 			);
@@ -46,7 +46,7 @@ namespace igros::multiboot {
         // Print multiboot flags
 	void info_t::printFlags() const noexcept {
                 // Print header
-		klib::kprintf(
+		klib::klog<klib::KLOG_LEVEL::INFO>(
 			u8"MULTIBOOT header:\r\n"
 			u8"\tFlags:\t\t\t0x%08x\r\n"
 			u8"\tBIOS memory map:\t[ %c ]\r\n"
@@ -60,7 +60,7 @@ namespace igros::multiboot {
 			u8"\tBootloader name:\t[ %c ]\r\n"
 			u8"\tAPM:\t\t\t[ %c ]\r\n"
 			u8"\tVBE:\t\t\t[ %c ]\r\n"
-			u8"\tFB:\t\t\t[ %c ]\r\n",
+			u8"\tFB:\t\t\t[ %c ]\r\n"_fmt,
 			flags,
 			hasInfoMemory()		? u8'Y' : u8'N',
 			hasInfoBootDevice()	? u8'Y' : u8'N',
@@ -80,38 +80,38 @@ namespace igros::multiboot {
 	// Print multiboot memory info
 	void info_t::printMemInfo() const noexcept {
 		// Print header
-		klib::kprintf(u8"MEMORY INFO:\r\n");
+		klib::klog<klib::KLOG_LEVEL::INFO>(u8"MEMORY INFO:\r\n"_fmt);
 		// Check if memory info exists
 		if (hasInfoMemory()) {
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::INFO>(
 				u8"\tLow:\t%d Kb\r\n"
-				u8"\tHigh:\t%d Kb.\r\n",
+				u8"\tHigh:\t%d Kb.\r\n"_fmt,
 				memLow,
 				memHigh
 			);
 		} else {
-			klib::kprintf(u8"\tNo memory info provided...\r\n");
+			klib::klog<klib::KLOG_LEVEL::INFO>(u8"\tNo memory info provided...\r\n"_fmt);
 		}
 	}
 
 	// Dump multiboot memory map
 	void info_t::printMemMap() const noexcept {
 		// Print header
-		klib::kprintf(u8"MEMORY MAP:\r\n");
+		klib::klog<klib::KLOG_LEVEL::INFO>(u8"MEMORY MAP:\r\n"_fmt);
 		// Check if memory map exists
 		if (hasInfoMemoryMap()) {
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::INFO>(
 				u8"\tSize:\t%d bytes\r\n"
-				u8"\tAddr:\t0x%p\r\n",
+				u8"\tAddr:\t0x%p\r\n"_fmt,
 				mmapLength,
-				mmapAddr
+				reinterpret_cast<pointer_t>(static_cast<std::size_t>(mmapAddr))
 			);
 			// Get pointer to memory map
 			auto memoryMap = reinterpret_cast<multiboot::memoryMapEntry*>(mmapAddr);
 			// Loop through memory map
 			while (reinterpret_cast<quad_t>(memoryMap) < (mmapAddr + mmapLength)) {
-				klib::kprintf(
-					u8"\t[%d] 0x%p - 0x%p",
+				klib::klog<klib::KLOG_LEVEL::INFO>(
+					u8"\t[%d] 0x%p - 0x%p"_fmt,
 					memoryMap->type,
 					reinterpret_cast<pointer_t>(memoryMap->address),
 					reinterpret_cast<pointer_t>(memoryMap->address + memoryMap->length)
@@ -119,9 +119,9 @@ namespace igros::multiboot {
 				// Move to next memory map entry
 				memoryMap = reinterpret_cast<multiboot::memoryMapEntry*>(reinterpret_cast<quad_t>(memoryMap) + memoryMap->size + sizeof(memoryMap->size));
 			}
-			klib::kprintf(u8"\r\n");
+			klib::klog<klib::KLOG_LEVEL::INFO>(u8"\r\n"_fmt);
 		} else {
-			klib::kprintf(u8"\tNo memory map provided...\r\n");
+			klib::klog<klib::KLOG_LEVEL::INFO>(u8"\tNo memory map provided...\r\n"_fmt);
 		}
 	}
 
@@ -129,7 +129,7 @@ namespace igros::multiboot {
 	// Print multiboot VBE info
 	void info_t::printVBEInfo() const noexcept {
 		// Print header
-		klib::kprintf(u8"VBE:\r\n");
+		klib::klog<klib::KLOG_LEVEL::INFO>(u8"VBE:\r\n"_fmt);
 		// Test VBE
 		if (hasInfoVBE()) {
 			// Get VBE config info
@@ -145,7 +145,7 @@ namespace igros::multiboot {
 			// Get revision string
 			const auto revision	= reinterpret_cast<const char* const>(((config->productRev & 0xFFFF0000) >> 12) + (config->productRev & 0xFFFF));
 			// Dump VBE
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::INFO>(
 				u8"Signature:\t%c%c%c%c\r\n"
 				u8"Version:\t%d.%d\r\n"
 				u8"OEM:\t\t\"%s\"\r\n"
@@ -153,7 +153,7 @@ namespace igros::multiboot {
 				u8"Card name:\t\"%s\"\r\n"
 				u8"Card rev.:\t\"%s\"\r\n"
 				u8"Current mode:\t#%d (%dx%d, %dbpp, 0x%p)\r\n"
-				u8"Video memory:\t%d Kb.\r\n",
+				u8"Video memory:\t%d Kb.\r\n"_fmt,
 				config->signature[0],
 				config->signature[1],
 				config->signature[2],
@@ -168,18 +168,18 @@ namespace igros::multiboot {
 				mode->width,
 				mode->height,
 				mode->bpp,
-				mode->physbase,
+				reinterpret_cast<pointer_t>(static_cast<std::size_t>(mode->physbase)),
 				static_cast<dword_t>(config->memory) * 64U
 			);
 		} else {
-			klib::kprintf(u8"\tNo VBE info provided...\r\n");
+			klib::klog<klib::KLOG_LEVEL::INFO>(u8"\tNo VBE info provided...\r\n"_fmt);
 		}
 	}
 
 	// Print multiboot FB info
 	void info_t::printFBInfo() const noexcept {
 		// Print header
-		klib::kprintf(u8"FB:\r\n");
+		klib::klog<klib::KLOG_LEVEL::INFO>(u8"FB:\r\n"_fmt);
 		// Check framebuffer
 		if (hasInfoFrameBuffer()) {
 			// Framebuffer type name
@@ -200,20 +200,20 @@ namespace igros::multiboot {
 					break;
 			}
 			// Dump FB
-			klib::kprintf(
+			klib::klog<klib::KLOG_LEVEL::INFO>(
 				u8"Current mode:\t(%dx%d, %dbpp, %d, %s)\r\n"
 				u8"Address:\t0x%p\r\n"
-				u8"Size:\t\t%z\r\n",
+				u8"Size:\t\t%z\r\n"_fmt,
 				fbWidth,
 				fbHeight,
 				fbBpp,
 				fbPitch,
 				fbTypeName,
-				static_cast<std::size_t>(fbAddress),
+				reinterpret_cast<pointer_t>(static_cast<std::size_t>(fbAddress)),
 				fbWidth * (fbBpp >> 3) * fbHeight * fbPitch
 			);
 		} else {
-			klib::kprintf(u8"\tNo framebuffer info provided...\r\n");
+			klib::klog<klib::KLOG_LEVEL::INFO>(u8"\tNo framebuffer info provided...\r\n"_fmt);
 		}
 	}
 
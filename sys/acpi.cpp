@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////
+//
+//	ACPI tables lookup
+//
+//	File:	acpi.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdint>
+
+#include <klib/kprint.hpp>
+#include <klib/kstring.hpp>
+
+#include <mem/direct.hpp>
+
+#include <sys/acpi.hpp>
+
+
+// System code zone
+namespace igros::sys {
+
+
+	// EBDA segment pointer physical address (BIOS data area)
+	constexpr auto ACPI_EBDA_POINTER	= 0x0000040EULL;
+	// EBDA part searched for RSDP
+	constexpr auto ACPI_EBDA_SIZE		= 0x00000400ULL;
+	// BIOS read-only area searched for RSDP
+	constexpr auto ACPI_BIOS_FIRST		= 0x000E0000ULL;
+	constexpr auto ACPI_BIOS_LAST		= 0x00100000ULL;
+	// RSDP is 16 bytes aligned
+	constexpr auto ACPI_RSDP_ALIGN		= 0x00000010ULL;
+	// ACPI 1.0 RSDP part size
+	constexpr auto ACPI_RSDP_V1_SIZE	= 20ULL;
+
+
+	// Check table bytes sum to zero
+	[[nodiscard]]
+	static bool checksum(const pointer_t table, const std::size_t length) noexcept {
+		// Bytes sum
+		auto sum = byte_t(0x00);
+		for (auto i = 0ULL; i < length; i++) {
+			sum += static_cast<const byte_t*>(table)[i];
+		}
+		return 0x00 == sum;
+	}
+
+
+	// Root System Description Pointer
+	const acpiRSDP_t*	acpi::mRSDP		{nullptr};
+	// Root table (RSDT or XSDT)
+	const acpiHeader_t*	acpi::mRoot		{nullptr};
+	// Root table is XSDT (64-bit entries)
+	bool			acpi::mExtended		{false};
+
+
+	// Get table by physical address (nullptr if not mapped or broken)
+	[[nodiscard]]
+	const acpiHeader_t* acpi::map(const quad_t address) noexcept {
+		// Check header is inside direct map
+		if (	(0ULL == address)
+			|| ((address + sizeof(acpiHeader_t)) > mem::direct::end())) {
+			return nullptr;
+		}
+		// Check whole table is inside direct map
+		const auto table = static_cast<const acpiHeader_t*>(mem::physToVirt(static_cast<std::size_t>(address)));
+		if (	(table->length < sizeof(acpiHeader_t))
+			|| ((address + table->length) > mem::direct::end())) {
+			return nullptr;
+		}
+		// Check table checksum
+		return checksum(const_cast<acpiHeader_t*>(table), table->length) ? table : nullptr;
+	}
+
+	// Find RSDP in physical memory range
+	[[nodiscard]]
+	const acpiRSDP_t* acpi::scan(const std::size_t first, const std::size_t last) noexcept {
+		// Check range is inside direct map
+		if (	(first >= last)
+			|| (last > mem::direct::end())) {
+			return nullptr;
+		}
+		// RSDP signature is 16 bytes aligned
+		for (auto address = first; (address + sizeof(acpiRSDP_t)) <= last; address += ACPI_RSDP_ALIGN) {
+			const auto rsdp = static_cast<const acpiRSDP_t*>(mem::physToVirt(address));
+			// Check signature and ACPI 1.0 part checksum
+			if (	(0 == klib::kstrcmp(rsdp->signature, u8"RSD PTR ", sizeof(rsdp->signature)))
+				&& checksum(const_cast<acpiRSDP_t*>(rsdp), ACPI_RSDP_V1_SIZE)) {
+				return rsdp;
+			}
+		}
+		// Nothing found
+		return nullptr;
+	}
+
+
+	// Find root tables
+	void acpi::init() noexcept {
+		// EBDA is searched first
+		if (ACPI_EBDA_POINTER < mem::direct::end()) {
+			const auto ebda = std::size_t(*static_cast<const word_t*>(mem::physToVirt(ACPI_EBDA_POINTER))) << 4;
+			acpi::mRSDP = scan(ebda, ebda + ACPI_EBDA_SIZE);
+		}
+		// Then BIOS read-only area
+		if (nullptr == acpi::mRSDP) {
+			acpi::mRSDP = scan(ACPI_BIOS_FIRST, ACPI_BIOS_LAST);
+		}
+		// No ACPI
+		if (nullptr == acpi::mRSDP) {
+			return;
+		}
+		// XSDT is preferred on ACPI 2.0+
+		if (	(acpi::mRSDP->revision >= 2U)
+			&& checksum(const_cast<acpiRSDP_t*>(acpi::mRSDP), acpi::mRSDP->length)) {
+			acpi::mRoot	= map(acpi::mRSDP->xsdtAddress);
+			acpi::mExtended	= nullptr != acpi::mRoot;
+		}
+		// Fall back to RSDT
+		if (nullptr == acpi::mRoot) {
+			acpi::mRoot	= map(acpi::mRSDP->rsdtAddress);
+		}
+	}
+
+
+	// Find table by signature (nullptr if not found)
+	[[nodiscard]]
+	const acpiHeader_t* acpi::table(const sbyte_t* signature) noexcept {
+		// No root table
+		if (nullptr == acpi::mRoot) {
+			return nullptr;
+		}
+		// Root table entries (physical addresses right after header)
+		const auto entries	= reinterpret_cast<const byte_t*>(acpi::mRoot) + sizeof(acpiHeader_t);
+		const auto size		= acpi::mExtended ? sizeof(quad_t) : sizeof(dword_t);
+		const auto count	= (acpi::mRoot->length - sizeof(acpiHeader_t)) / size;
+		// Loop through root table entries
+		for (auto i = 0ULL; i < count; i++) {
+			// Entry may be unaligned
+			auto address = quad_t(0ULL);
+			for (auto b = 0ULL; b < size; b++) {
+				address |= quad_t(entries[i * size + b]) << (b << 3);
+			}
+			// Check table signature
+			const auto header = map(address);
+			if (	(nullptr != header)
+				&& (0 == klib::kstrcmp(header->signature, signature, sizeof(header->signature)))) {
+				return header;
+			}
+		}
+		// Nothing found
+		return nullptr;
+	}
+
+
+	// Print ACPI tables
+	void acpi::print() noexcept {
+		// No ACPI
+		if (nullptr == acpi::mRoot) {
+			klib::kprintf(u8"ACPI:\tnot found");
+			return;
+		}
+		klib::kprintf(
+			u8"ACPI:\r\n"
+			u8"\tRSDP:\t0x%p (revision %d)\r\n"
+			u8"\tRoot:\t%s at 0x%p",
+			acpi::mRSDP,
+			static_cast<dword_t>(acpi::mRSDP->revision),
+			acpi::mExtended ? u8"XSDT" : u8"RSDT",
+			acpi::mRoot
+		);
+	}
+
+
+}	// namespace igros::sys
+
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel memory allocator host benchmark
+//
+//	File:	kbench-kmalloc.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include <klib/kmalloc.hpp>
+#include <klib/kmemory.hpp>
+
+#include <mem/mmap.hpp>
+#include <mem/buddy.hpp>
+#include <mem/vmm.hpp>
+
+#include "khost.hpp"
+#include "kbench.hpp"
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Host kernel heap window size
+	constexpr auto HOST_HEAP_SIZE	= 256ULL << 20;
+
+
+	// Host page blocks allocator (zones, magazines and zeroed pool are not benchmarked)
+	static buddy					hostPages	{};
+	// Host kernel heap window (ranges are never touched, so nothing is mapped)
+	static byte_t*					hostHeap	{nullptr};
+	// Host kernel heap areas (start offset -> length)
+	static std::map<std::size_t, std::size_t>	hostAreas	{};
+
+
+	// Allocate 2^order pages
+	[[nodiscard]]
+	pointer_t phys::alloc(const std::size_t order, const ZONE) noexcept {
+		return hostPages.alloc(order);
+	}
+
+	// Free 2^order pages
+	void phys::free(pointer_t &page, const std::size_t order) noexcept {
+		hostPages.free(page, order);
+		page = nullptr;
+	}
+
+
+	// Reserve kernel heap range (first fit in areas list, same as kernel)
+	[[nodiscard]]
+	pointer_t vmm::reserve(const std::size_t length) noexcept {
+		// Whole pages only
+		const auto size = (length + DEFAULT_PAGE_SIZE - 1ULL) & ~(DEFAULT_PAGE_SIZE - 1ULL);
+		if (0ULL == size) {
+			return nullptr;
+		}
+		// Find gap between areas
+		auto start = std::size_t(0ULL);
+		for (const auto &[first, bytes] : hostAreas) {
+			if ((first - start) >= size) {
+				break;
+			}
+			start = first + bytes;
+		}
+		if ((start + size) > HOST_HEAP_SIZE) {
+			return nullptr;
+		}
+		// Register area
+		hostAreas.emplace(start, size);
+		return hostHeap + start;
+	}
+
+	// Release kernel heap range
+	void vmm::release(const pointer_t addr) noexcept {
+		hostAreas.erase(static_cast<std::size_t>(static_cast<byte_t*>(addr) - hostHeap));
+	}
+
+	// Check address belongs to kernel heap window
+	[[nodiscard]]
+	bool vmm::heap(const pointer_t addr) noexcept {
+		return (reinterpret_cast<std::size_t>(addr) - reinterpret_cast<std::size_t>(hostHeap)) < HOST_HEAP_SIZE;
+	}
+
+
+}	// namespace igros::mem
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Benchmark memory size
+	constexpr auto BENCH_KMALLOC_MEMORY	= 256ULL << 20;
+	// Operations per workload (every operation is single kmalloc or kfree)
+	constexpr auto BENCH_KMALLOC_OPERATIONS	= 1000000ULL;
+
+
+	// Allocation sizes of workload
+	struct sizes_t final {
+		const char*	name;		// Workload name
+		std::size_t	slots;		// Live allocations slots (about half of them are used)
+		std::size_t	small;		// Size classes share (percents)
+		std::size_t	blocks;		// Page blocks share (percents, rest goes to kernel heap)
+	};
+
+	// Workloads
+	constexpr sizes_t BENCH_KMALLOC_SIZES[] {
+		{"size classes 8 b. - 2 Kb.",		4096ULL,	100ULL,	0ULL},
+		{"page blocks 2 - 64 Kb.",		256ULL,		0ULL,	100ULL},
+		{"kernel heap 64 Kb. - 1 Mb.",		64ULL,		0ULL,	0ULL},
+		{"mixed 90% / 9% / 1%",			4096ULL,	90ULL,	9ULL}
+	};
+
+
+	// Workload operation
+	struct operation_t final {
+		std::size_t	slot;		// Slot to allocate (if empty) or free
+		std::size_t	size;		// Allocation size
+	};
+
+	// Random allocation size of workload
+	[[nodiscard]]
+	static std::size_t size(const sizes_t &sizes, std::mt19937_64 &random) noexcept {
+		const auto path = random() % 100ULL;
+		// Size classes (every size class is equally likely)
+		if (path < sizes.small) {
+			return 1ULL + random() % ((1ULL << klib::KMALLOC_MIN_SHIFT) << (random() % klib::KMALLOC_CLASSES));
+		}
+		// Page blocks
+		constexpr auto smallest = (1ULL << klib::KMALLOC_MAX_SHIFT) + 1ULL;
+		if (path < (sizes.small + sizes.blocks)) {
+			return smallest + random() % ((1ULL << klib::KMALLOC_BLOCK_SHIFT) - smallest + 1ULL);
+		}
+		// Kernel heap ranges
+		return (1ULL << klib::KMALLOC_BLOCK_SHIFT) + 1ULL + random() % (15ULL << klib::KMALLOC_BLOCK_SHIFT);
+	}
+
+	// Run workload (returns TSC cycles per operation)
+	template<typename A, typename F>
+	[[nodiscard]]
+	static double run(const std::vector<operation_t> &operations, std::vector<pointer_t> &slots, A &&alloc, F &&free) noexcept {
+		const auto start = cycles();
+		for (const auto &op : operations) {
+			auto &slot = slots[op.slot];
+			if (nullptr == slot) {
+				slot = alloc(op.size);
+			} else {
+				free(slot);
+				slot = nullptr;
+			}
+		}
+		const auto spent = cycles() - start;
+		// Free what is left
+		for (auto &slot : slots) {
+			if (nullptr != slot) {
+				free(slot);
+				slot = nullptr;
+			}
+		}
+		return double(spent) / double(operations.size());
+	}
+
+
+	// Kernel allocator mixed sizes: size classes, page blocks and kernel heap ranges
+	void benchKmalloc() noexcept {
+		klib::kmemoryInit();
+		const auto rate = frequency();
+		// Host memory (populated, so host page faults are not measured)
+		const auto memory	= arena(BENCH_KMALLOC_MEMORY, true);
+		const auto heap		= ::mmap(nullptr, mem::HOST_HEAP_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (	(nullptr == memory.base)
+			|| (MAP_FAILED == heap)) {
+			std::printf("kmalloc: can't map %zu Mb.\n", std::size_t((BENCH_KMALLOC_MEMORY + mem::HOST_HEAP_SIZE) >> 20));
+			return;
+		}
+		mem::hostHeap = static_cast<byte_t*>(heap);
+		mem::hostPages.init(memory.frames, nullptr);
+		mem::hostPages.addRegion(memory.frames);
+		const auto total = mem::hostPages.freePages();
+
+		std::printf("kmalloc (%zu ops, ns. per kmalloc or kfree at %.0f MHz TSC):\n", std::size_t(BENCH_KMALLOC_OPERATIONS), rate);
+		std::printf("%-32s %12s %14s\n", "workload", "kmalloc", "malloc (libc)");
+		for (const auto &sizes : BENCH_KMALLOC_SIZES) {
+			// Same operations for both allocators
+			std::mt19937_64 random {2021U};
+			std::vector<operation_t> operations(BENCH_KMALLOC_OPERATIONS);
+			for (auto &op : operations) {
+				op.slot	= random() % sizes.slots;
+				op.size	= size(sizes, random);
+			}
+			std::vector<pointer_t> slots(sizes.slots, nullptr);
+			// First round grows slabs and carves blocks, second one is measured
+			static_cast<void>(run(operations, slots, [](const std::size_t bytes) noexcept {return klib::kmalloc(bytes);}, [](const pointer_t ptr) noexcept {klib::kfree(ptr);}));
+			const auto kernel	= run(operations, slots, [](const std::size_t bytes) noexcept {return klib::kmalloc(bytes);}, [](const pointer_t ptr) noexcept {klib::kfree(ptr);});
+			static_cast<void>(run(operations, slots, [](const std::size_t bytes) noexcept {return std::malloc(bytes);}, [](const pointer_t ptr) noexcept {std::free(ptr);}));
+			const auto libc		= run(operations, slots, [](const std::size_t bytes) noexcept {return std::malloc(bytes);}, [](const pointer_t ptr) noexcept {std::free(ptr);});
+			std::printf("%-32s %12.1f %14.1f\n", sizes.name, kernel * 1000.0 / rate, libc * 1000.0 / rate);
+		}
+		// Everything is freed, size classes keep magazines and few empty slabs
+		std::printf("%-32s %12zu of %zu\n", "pages kept by size classes", total - mem::hostPages.freePages(), total);
+		std::printf("%-32s %12zu\n", "kernel heap areas left", mem::hostAreas.size());
+		// Size classes caches are never used again (their slabs go away with arena)
+		::munmap(heap, mem::HOST_HEAP_SIZE);
+		mem::hostHeap = nullptr;
+		release(memory);
+	}
+
+
+}	// namespace igros::host
+
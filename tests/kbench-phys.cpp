@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////
+//
+//	Physical memory allocator host benchmarks
+//
+//	File:	kbench-phys.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <klib/kmemory.hpp>
+
+#include <mem/buddy.hpp>
+#include <mem/bitmap.hpp>
+
+#include "khost.hpp"
+#include "kbench.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Benchmark memory size
+	constexpr auto BENCH_PHYS_MEMORY	= 256ULL << 20;
+	// Random workload operations
+	constexpr auto BENCH_PHYS_OPERATIONS	= 1000000ULL;
+	// Random workload keeps about this share of memory allocated (percents)
+	constexpr auto BENCH_PHYS_LOAD		= 80ULL;
+
+
+	// Memory sizes of boot benchmark
+	constexpr std::size_t BENCH_BOOT_MEMORY[] {2ULL << 30, 8ULL << 30};
+	// Memory touched by eager setup reference (cost is linear, bigger sizes are scaled)
+	constexpr auto BENCH_BOOT_EAGER		= 1ULL << 30;
+
+
+	// Allocated block
+	struct block_t final {
+		pointer_t	page;		// Block address
+		std::size_t	order;		// Block order
+	};
+
+	// Random block order (every next order is twice as rare)
+	[[nodiscard]]
+	static std::size_t order(std::mt19937_64 &random) noexcept {
+		return static_cast<std::size_t>(__builtin_ctzll(random() | (1ULL << mem::PHYS_MAX_ORDER)));
+	}
+
+	// Largest free block order (-1 if there is no free memory)
+	template<typename T>
+	[[nodiscard]]
+	static int largest(T &allocator) noexcept {
+		for (auto current = static_cast<int>(mem::PHYS_MAX_ORDER); current >= 0; current--) {
+			const auto page = allocator.alloc(static_cast<std::size_t>(current));
+			if (nullptr != page) {
+				allocator.free(page, static_cast<std::size_t>(current));
+				return current;
+			}
+		}
+		return -1;
+	}
+
+	// Free pages inside max order blocks
+	template<typename T>
+	[[nodiscard]]
+	static std::size_t whole(T &allocator) noexcept {
+		std::vector<pointer_t> blocks;
+		for (auto page = allocator.alloc(mem::PHYS_MAX_ORDER); nullptr != page; page = allocator.alloc(mem::PHYS_MAX_ORDER)) {
+			blocks.push_back(page);
+		}
+		for (const auto page : blocks) {
+			allocator.free(page, mem::PHYS_MAX_ORDER);
+		}
+		return blocks.size() << mem::PHYS_MAX_ORDER;
+	}
+
+
+	// Physical allocator workload results
+	struct physResult_t final {
+		double		alloc;		// Single page alloc TSC cycles
+		double		free;		// Single page free TSC cycles
+		double		random;		// Random alloc/free TSC cycles
+		double		range;		// Range above max order allocation TSC cycles
+		std::size_t	freePages;	// Free pages at target load
+		int		maxOrder;	// Largest free order at target load
+		std::size_t	inWhole;	// Free pages inside max order blocks at target load
+		std::size_t	failures;	// Refused allocations with enough free memory
+		std::size_t	refused;	// Refused allocations
+		bool		merged;		// All pages form max order blocks after free
+		bool		ranged;		// Range above max order was allocated
+	};
+
+	// Run single page, random and range workloads (allocator manages whole arena)
+	template<typename T>
+	[[nodiscard]]
+	static physResult_t run(T &allocator, const std::size_t total) noexcept {
+		physResult_t result {};
+
+		// Single pages (first round carves blocks from region, best round is taken)
+		const auto pages	= total / 2ULL;
+		std::vector<pointer_t> list(pages);
+		auto allocCycles	= ~0ULL;
+		auto freeCycles		= ~0ULL;
+		for (auto round = 0ULL; round < 8ULL; round++) {
+			auto start = cycles();
+			for (auto &page : list) {
+				page = allocator.alloc(0ULL);
+			}
+			const auto allocSpent	= cycles() - start;
+			start			= cycles();
+			for (const auto page : list) {
+				allocator.free(page, 0ULL);
+			}
+			const auto freeSpent	= cycles() - start;
+			allocCycles	= (allocSpent < allocCycles) ? allocSpent : allocCycles;
+			freeCycles	= (freeSpent < freeCycles) ? freeSpent : freeCycles;
+		}
+		result.alloc	= double(allocCycles) / double(pages);
+		result.free	= double(freeCycles) / double(pages);
+
+		// Random workload around target load (same sequence for every allocator)
+		std::mt19937_64 random {2021U};
+		std::vector<block_t> live;
+		auto used	= 0ULL;
+		const auto start = cycles();
+		for (auto i = 0ULL; i < BENCH_PHYS_OPERATIONS; i++) {
+			// Allocate more often below target load
+			const auto below	= (used * 100ULL) < (total * BENCH_PHYS_LOAD);
+			const auto allocate	= live.empty() || ((random() % 100ULL) < (below ? 60ULL : 40ULL));
+			if (allocate) {
+				const auto current	= order(random);
+				const auto page		= allocator.alloc(current);
+				if (nullptr == page) {
+					// Enough free memory but no contiguous block
+					result.failures += ((total - used) >= (1ULL << current)) ? 1ULL : 0ULL;
+					result.refused++;
+					continue;
+				}
+				live.push_back({page, current});
+				used += (1ULL << current);
+			} else {
+				// Free random block
+				const auto index = random() % live.size();
+				allocator.free(live[index].page, live[index].order);
+				used -= (1ULL << live[index].order);
+				live[index] = live.back();
+				live.pop_back();
+			}
+		}
+		result.random		= double(cycles() - start) / double(BENCH_PHYS_OPERATIONS);
+		// Fragmentation at target load
+		result.freePages	= allocator.freePages();
+		result.maxOrder		= largest(allocator);
+		result.inWhole		= whole(allocator);
+
+		// Free everything (all blocks should merge back)
+		for (const auto &block : live) {
+			allocator.free(block.page, block.order);
+		}
+		result.merged		= (total == whole(allocator));
+		// Exact range above max order
+		const auto rangeStart	= cycles();
+		const auto range	= allocator.allocRange((1ULL << mem::PHYS_MAX_ORDER) + 1ULL, 1ULL);
+		result.range		= double(cycles() - rangeStart);
+		result.ranged		= (nullptr != range);
+		allocator.freeRange(range, (1ULL << mem::PHYS_MAX_ORDER) + 1ULL);
+		return result;
+	}
+
+
+	// Measure buddy and bitmap allocators single page throughput and random workload fragmentation
+	void benchPhys() noexcept {
+		klib::kmemoryInit();
+		physResult_t results[2] {};
+		// Buddy allocator (host memory is populated, so host page faults are not measured)
+		auto memory = arena(BENCH_PHYS_MEMORY, true);
+		if (nullptr == memory.base) {
+			std::printf("phys: can't map %zu Mb.\n", std::size_t(BENCH_PHYS_MEMORY >> 20));
+			return;
+		}
+		const auto total = memory.frames.last - memory.frames.first;
+		static mem::buddy buddy;
+		buddy.init(memory.frames, nullptr);
+		buddy.addRegion(memory.frames);
+		results[0] = run(buddy, total);
+		release(memory);
+		// Bitmap allocator on fresh memory (bitmap and summary come from host)
+		memory = arena(BENCH_PHYS_MEMORY, true);
+		if (nullptr == memory.base) {
+			std::printf("phys: can't map %zu Mb.\n", std::size_t(BENCH_PHYS_MEMORY >> 20));
+			return;
+		}
+		std::vector<std::size_t> storage((mem::bitmap::metadata(memory.frames) + sizeof(std::size_t) - 1ULL) / sizeof(std::size_t));
+		static mem::bitmap bitmap;
+		bitmap.init(memory.frames, storage.data());
+		bitmap.addRegion(memory.frames);
+		results[1] = run(bitmap, total);
+		release(memory);
+
+		// Print results
+		const auto &[buddyResult, bitmapResult] = results;
+		std::printf("phys (%zu Mb., TSC cycles per call):\n", std::size_t(BENCH_PHYS_MEMORY >> 20));
+		std::printf("%-40s %12s %12s\n", "", "buddy", "bitmap");
+		std::printf("%-40s %12.1f %12.1f\n", "alloc order 0", buddyResult.alloc, bitmapResult.alloc);
+		std::printf("%-40s %12.1f %12.1f\n", "free order 0", buddyResult.free, bitmapResult.free);
+		std::printf("%-40s %12.1f %12.1f\n", "random alloc/free order 0-10", buddyResult.random, bitmapResult.random);
+		std::printf("%-40s %12.1f %12.1f\n", "allocRange 1025 pages", buddyResult.range, bitmapResult.range);
+		std::printf("random workload (%zu ops, ~%zu%% load, %zu pages):\n", std::size_t(BENCH_PHYS_OPERATIONS), std::size_t(BENCH_PHYS_LOAD), total);
+		std::printf("%-40s %12zu %12zu\n", "free pages", buddyResult.freePages, bitmapResult.freePages);
+		std::printf("%-40s %12d %12d\n", "largest free order", buddyResult.maxOrder, bitmapResult.maxOrder);
+		std::printf("%-40s %11.1f%% %11.1f%%\n", "free pages in max order blocks",
+			(0ULL != buddyResult.freePages) ? (100.0 * double(buddyResult.inWhole) / double(buddyResult.freePages)) : 0.0,
+			(0ULL != bitmapResult.freePages) ? (100.0 * double(bitmapResult.inWhole) / double(bitmapResult.freePages)) : 0.0);
+		std::printf("%-40s %12zu %12zu\n", "refused with enough free memory", buddyResult.failures, bitmapResult.failures);
+		std::printf("%-40s %12zu %12zu\n", "refused allocations", buddyResult.refused, bitmapResult.refused);
+		std::printf("%-40s %12s %12s\n", "all blocks merged after free", buddyResult.merged ? "yes" : "NO", bitmapResult.merged ? "yes" : "NO");
+		std::printf("%-40s %12s %12s\n", "allocRange 1025 pages", buddyResult.ranged ? "ok" : "FAILED", bitmapResult.ranged ? "ok" : "FAILED");
+	}
+
+
+	// Measure physical memory setup with lazy carving and eager free list walk
+	void benchBoot() noexcept {
+		klib::kmemoryInit();
+		const auto rate = frequency();
+		// Eager setup writes frame descriptor and free list link of every page (memory is populated first)
+		const auto eager = arena(BENCH_BOOT_EAGER, true);
+		if (nullptr == eager.base) {
+			std::printf("boot: can't map %zu Mb.\n", std::size_t(BENCH_BOOT_EAGER >> 20));
+			return;
+		}
+		const auto eagerStart = cycles();
+		klib::kmemset(hostFrames.data(), hostFrames.size() * sizeof(mem::frame_t), byte_t(0x00));
+		auto head = static_cast<pointer_t>(nullptr);
+		for (auto pfn = eager.frames.first; pfn < eager.frames.last; pfn++) {
+			const auto page	= mem::frameAddress(pfn);
+			*static_cast<pointer_t*>(page) = head;
+			head		= page;
+		}
+		keep(head);
+		const auto eagerPage = double(cycles() - eagerStart) / double(eager.frames.last - eager.frames.first);
+		release(eager);
+		// Print results
+		std::printf("boot (physical memory setup, us. at %.0f MHz TSC):\n", rate);
+		std::printf("%10s %16s %16s %16s\n", "memory", "eager (scaled)", "lazy setup", "first alloc");
+		for (const auto size : BENCH_BOOT_MEMORY) {
+			// Lazy setup touches nothing but regions list and chunks bitmap
+			const auto memory = arena(size, false);
+			if (nullptr == memory.base) {
+				std::printf("%8zu Mb. can't be mapped\n", std::size_t(size >> 20));
+				continue;
+			}
+			static mem::buddy allocator;
+			const auto start = cycles();
+			hostChunks.assign(hostChunks.size(), false);
+			allocator.init(memory.frames, nullptr);
+			// Low megabyte is reserved (same as real memory map)
+			allocator.addRegion({memory.frames.first + (0x100000ULL >> mem::DEFAULT_PAGE_SHIFT), memory.frames.last});
+			const auto setup = cycles() - start;
+			// First allocation carves max order block and initializes its descriptors
+			const auto allocStart	= cycles();
+			const auto page		= allocator.alloc(0ULL);
+			const auto alloc	= cycles() - allocStart;
+			keep(page);
+			std::printf("%8zu Mb. %16.1f %16.1f %16.1f\n", std::size_t(size >> 20), eagerPage * double(size >> mem::DEFAULT_PAGE_SHIFT) / rate, double(setup) / rate, double(alloc) / rate);
+			release(memory);
+		}
+	}
+
+
+}	// namespace igros::host
+
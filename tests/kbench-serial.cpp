@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////
+//
+//	Serial driver host benchmark
+//
+//	File:	kbench-serial.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdio>
+
+#include <arch/irq.hpp>
+
+#include <drivers/uart/serial.hpp>
+
+#include "khost.hpp"
+#include "kbench.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Serial line speed (8N1 - 10 bits per byte)
+	constexpr auto BENCH_SERIAL_BAUD	= 115200ULL;
+	// Log line size
+	constexpr auto BENCH_SERIAL_LINE	= 64ULL;
+	// Log lines written per run
+	constexpr auto BENCH_SERIAL_LINES	= 128ULL;
+
+
+	// Serial output run result
+	struct serialResult_t final {
+		double	rate;		// Bytes per second on line
+		double	cpu;		// TSC cycles spent in driver per byte
+		double	share;		// Driver share of run time
+	};
+
+
+	// Deliver pending UART interrupt (returns cycles spent in handler)
+	[[nodiscard]]
+	static quad_t service() noexcept {
+		if (!uartInterrupt()) {
+			return 0ULL;
+		}
+		const auto start = cycles();
+		interrupt(static_cast<dword_t>(arch::irq::irq_t::UART1));
+		return cycles() - start;
+	}
+
+	// Write log lines every interval cycles (0 - back to back) and wait until all of them leave UART
+	[[nodiscard]]
+	static serialResult_t run(const quad_t interval, const double rate) noexcept {
+		sbyte_t line[BENCH_SERIAL_LINE];
+		for (auto i = 0ULL; i < BENCH_SERIAL_LINE; i++) {
+			line[i] = static_cast<sbyte_t>('A' + (i % 26ULL));
+		}
+		line[BENCH_SERIAL_LINE - 2ULL] = '\r';
+		line[BENCH_SERIAL_LINE - 1ULL] = '\n';
+		written = 0ULL;
+		// Driver time (writes and interrupts)
+		auto spent = 0ULL;
+		const auto start = cycles();
+		for (auto i = 0ULL; i < BENCH_SERIAL_LINES; i++) {
+			// Interrupts are taken while writer is busy with something else
+			while (cycles() < (start + i * interval)) {
+				spent += service();
+			}
+			const auto begin = cycles();
+			static_cast<void>(arch::serialWrite(line, BENCH_SERIAL_LINE));
+			spent += cycles() - begin;
+		}
+		// Rest of the ring leaves on interrupts
+		while ((written < (BENCH_SERIAL_LINE * BENCH_SERIAL_LINES)) || !uartIdle()) {
+			spent += service();
+		}
+		const auto total = double(cycles() - start);
+		return {
+			double(written) * rate * 1000000.0 / total,
+			double(spent) / double(written),
+			double(spent) / total
+		};
+	}
+
+	// Write paced and back to back log lines
+	static void runAll(const char* const mode, const double rate) noexcept {
+		// Writer uses 80% of line speed
+		const auto paced = run((uartByte * BENCH_SERIAL_LINE * 5ULL) / 4ULL, rate);
+		const auto burst = run(0ULL, rate);
+		std::printf("%-28s %12.0f %12.1f %11.1f%%\n", (std::string(mode) + ", 80% load").c_str(), paced.rate, paced.cpu, 100.0 * paced.share);
+		std::printf("%-28s %12.0f %12.1f %11.1f%%\n", (std::string(mode) + ", burst").c_str(), burst.rate, burst.cpu, 100.0 * burst.share);
+	}
+
+
+	// Serial output at 115200 baud: polled transmit compared with interrupt-driven ring
+	void benchSerial() noexcept {
+		capture = false;
+		// UART sends bytes at line speed
+		const auto rate	= frequency();
+		uartByte	= static_cast<quad_t>(rate * 1000000.0 * 10.0 / double(BENCH_SERIAL_BAUD));
+		uartOverrun	= 0ULL;
+		std::printf("serial (%llu baud, %zu x %zu byte lines, line limit %llu bytes/s):\n", BENCH_SERIAL_BAUD, BENCH_SERIAL_LINES, BENCH_SERIAL_LINE, BENCH_SERIAL_BAUD / 10ULL);
+		std::printf("%-28s %12s %12s %12s\n", "mode", "bytes/s", "cycles/byte", "CPU share");
+		// Polled transmit (interrupts are not set up yet)
+		static_cast<void>(arch::serialInit(arch::BAUD_RATE::BAUD_115200, arch::DATA_SIZE::CHAR_8, arch::STOP_BITS::STOP_1, arch::PARITY::NONE));
+		runAll("polled", rate);
+		// Interrupt-driven transmit (setup greeting is sent first)
+		arch::serialSetup();
+		while (!uartIdle()) {
+			static_cast<void>(service());
+		}
+		runAll("interrupt", rate);
+		std::printf("%-28s %12zu\n", "FIFO overruns", uartOverrun);
+		uartByte	= 0ULL;
+		capture		= true;
+	}
+
+
+}	// namespace igros::host
+
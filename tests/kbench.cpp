@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel library host benchmarks
+//
+//	File:	kbench.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstring>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <klib/kmath.hpp>
+#include <klib/kmemory.hpp>
+#include <klib/kprint.hpp>
+#include <klib/ktrace.hpp>
+
+#include "khost.hpp"
+#include "kbench.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Divisions per measured round
+	constexpr auto BENCH_DIVIDE_CALLS	= 4096ULL;
+	// Calls per measured round of print routines
+	constexpr auto BENCH_PRINT_CALLS	= 10000ULL;
+	// Events per measured round of trace
+	constexpr auto BENCH_TRACE_CALLS	= 10000ULL;
+	// Bytes moved per measured round (repeat count is scaled to it)
+	constexpr auto BENCH_ROUND_BYTES	= 4ULL << 20;
+	// Smallest memory block
+	constexpr auto BENCH_MEMORY_MIN		= 8ULL;
+	// Biggest memory block
+	constexpr auto BENCH_MEMORY_MAX		= 4ULL << 20;
+
+
+	// libc routines (called through pointers so compiler can't inline or drop them)
+	static void* (* volatile libcSet)(void*, int, std::size_t)		= std::memset;
+	static void* (* volatile libcCopy)(void*, const void*, std::size_t)	= std::memcpy;
+
+
+	// Calls count for block size
+	[[nodiscard]]
+	static std::size_t repeats(const std::size_t size) noexcept {
+		return ((BENCH_ROUND_BYTES / size) > 4ULL) ? (BENCH_ROUND_BYTES / size) : 4ULL;
+	}
+
+	// Fill and copy cycles per call of one block size
+	struct memoryResult_t final {
+		double	set;
+		double	copy;
+	};
+
+	// Measure kernel fill and copy of every block size
+	static void benchMemoryKernel(std::vector<memoryResult_t> &results, byte_t* const dst, byte_t* const src) noexcept {
+		for (auto size = BENCH_MEMORY_MIN; size <= BENCH_MEMORY_MAX; size <<= 1) {
+			const auto count = repeats(size);
+			results.push_back({
+				double(measure(count, [dst, size]() noexcept {klib::kmemset(dst, size, byte_t(0x5A)); keep(dst);})) / double(count),
+				double(measure(count, [dst, src, size]() noexcept {klib::kmemcpy(dst, src, size); keep(dst);})) / double(count)
+			});
+		}
+	}
+
+	// Compare kernel fill and copy routines with boot-time loops and libc (8 b. - 4 Mb.)
+	static void benchMemory() noexcept {
+		// Blocks (page aligned, same as most kernel callers)
+		std::vector<byte_t> dstBuffer(BENCH_MEMORY_MAX + 4096ULL);
+		std::vector<byte_t> srcBuffer(BENCH_MEMORY_MAX + 4096ULL, byte_t(0xA5));
+		const auto dst = reinterpret_cast<byte_t*>((reinterpret_cast<std::size_t>(dstBuffer.data()) + 4095ULL) & ~4095ULL);
+		const auto src = reinterpret_cast<byte_t*>((reinterpret_cast<std::size_t>(srcBuffer.data()) + 4095ULL) & ~4095ULL);
+		// Plain loops are used until boot selects routines
+		std::vector<memoryResult_t> loops;
+		benchMemoryKernel(loops, dst, src);
+		// Routines picked by CPUID
+		klib::kmemoryInit();
+		std::vector<memoryResult_t> kernel;
+		benchMemoryKernel(kernel, dst, src);
+		// Print results with libc reference
+		std::printf("memory (TSC cycles per call):\n");
+		std::printf("%10s %12s %12s %12s %12s %12s %12s\n", "size", "set loop", "set kernel", "set libc", "copy loop", "copy kernel", "copy libc");
+		auto i = 0ULL;
+		for (auto size = BENCH_MEMORY_MIN; size <= BENCH_MEMORY_MAX; size <<= 1, i++) {
+			const auto count	= repeats(size);
+			const auto set		= double(measure(count, [dst, size]() noexcept {libcSet(dst, 0x5A, size); keep(dst);})) / double(count);
+			const auto copy		= double(measure(count, [dst, src, size]() noexcept {libcCopy(dst, src, size); keep(dst);})) / double(count);
+			std::printf("%10zu %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n", size, loops[i].set, kernel[i].set, set, loops[i].copy, kernel[i].copy, copy);
+		}
+	}
+
+
+	// Sum of quotients and reminders of all dividends
+	template<typename F>
+	[[nodiscard]]
+	static double divide(const std::vector<quad_t> &values, F &&func) noexcept {
+		return double(measure(1ULL, [&values, &func]() noexcept {
+			auto sum = 0ULL;
+			for (const auto value : values) {
+				const auto res = func(value);
+				sum += res.quotient + res.reminder;
+			}
+			keep(sum);
+		})) / double(values.size());
+	}
+
+	// Compare kernel division with compiler 64-bit division (libgcc on i386)
+	static void benchDivide() noexcept {
+		std::mt19937_64 random {2021U};
+		std::vector<quad_t> values(BENCH_DIVIDE_CALLS);
+		for (auto &value : values) {
+			value = random();
+		}
+		// Runtime divisor (not known to compiler)
+		volatile dword_t divisor = 1193182U;
+		const auto runtime = static_cast<dword_t>(divisor);
+		// Print results
+		std::printf("divide (TSC cycles per division of random 64-bit value):\n");
+		std::printf("%-12s %12s %12s\n", "divisor", "kernel", "compiler");
+		std::printf("%-12s %12.1f %12.1f\n", "10", divide(values, [](const quad_t value) noexcept {return klib::kudivmod<10U>(value);}), divide(values, [](const quad_t value) noexcept {return klib::udivmod_t{value / 10U, value % 10U};}));
+		std::printf("%-12s %12.1f %12.1f\n", "1000", divide(values, [](const quad_t value) noexcept {return klib::kudivmod<1000U>(value);}), divide(values, [](const quad_t value) noexcept {return klib::udivmod_t{value / 1000U, value % 1000U};}));
+		std::printf("%-12s %12.1f %12.1f\n", "100000000", divide(values, [](const quad_t value) noexcept {return klib::kudivmod<100000000U>(value);}), divide(values, [](const quad_t value) noexcept {return klib::udivmod_t{value / 100000000U, value % 100000000U};}));
+		std::printf("%-12s %12.1f %12.1f\n", "runtime", divide(values, [runtime](const quad_t value) noexcept {return klib::kudivmod(value, runtime);}), divide(values, [runtime](const quad_t value) noexcept {return klib::udivmod_t{value / runtime, value % runtime};}));
+	}
+
+
+	// Measure integer conversion and formatting (console output is counted, not kept)
+	static void benchPrint() noexcept {
+		klib::kmemoryInit();
+		capture = false;
+		sbyte_t buffer[128];
+		// Conversion of short and longest decimal values
+		const auto small	= double(measure(BENCH_PRINT_CALLS, [&buffer]() noexcept {klib::kitoa(buffer, sizeof(buffer), quad_t(42ULL)); keep(buffer);})) / double(BENCH_PRINT_CALLS);
+		const auto large	= double(measure(BENCH_PRINT_CALLS, [&buffer]() noexcept {klib::kitoa(buffer, sizeof(buffer), quad_t(18446744073709551615ULL)); keep(buffer);})) / double(BENCH_PRINT_CALLS);
+		const auto hex		= double(measure(BENCH_PRINT_CALLS, [&buffer]() noexcept {klib::kitoa(buffer, sizeof(buffer), quad_t(0xFFFFFFFFFFFFFFFFULL), klib::radix_t::HEX); keep(buffer);})) / double(BENCH_PRINT_CALLS);
+		// Typical log line formatted to buffer and printed to console
+		const auto format	= double(measure(BENCH_PRINT_CALLS, [&buffer]() noexcept {klib::ksnprintf(buffer, sizeof(buffer), u8"Page %p mapped (%z bytes, flags %x) at %llu", &buffer, sizeof(buffer), 0x63U, 18446744073709551615ULL); keep(buffer);})) / double(BENCH_PRINT_CALLS);
+		const auto libc		= double(measure(BENCH_PRINT_CALLS, [&buffer]() noexcept {std::snprintf(buffer, sizeof(buffer), "Page %p mapped (%zu bytes, flags %x) at %llu", &buffer, sizeof(buffer), 0x63U, 18446744073709551615ULL); keep(buffer);})) / double(BENCH_PRINT_CALLS);
+		written = 0ULL;
+		const auto print	= double(measure(BENCH_PRINT_CALLS, [&buffer]() noexcept {klib::kprintf(u8"Page %p mapped (%z bytes, flags %x) at %llu", &buffer, sizeof(buffer), 0x63U, 18446744073709551615ULL);})) / double(BENCH_PRINT_CALLS);
+		const auto bytes	= double(written) / double(8ULL * BENCH_PRINT_CALLS);
+		capture = true;
+		// Print results
+		std::printf("print (TSC cycles per call):\n");
+		std::printf("%-32s %12.1f\n", "kitoa 42", small);
+		std::printf("%-32s %12.1f\n", "kitoa 2^64-1", large);
+		std::printf("%-32s %12.1f\n", "kitoa 2^64-1 hex", hex);
+		std::printf("%-32s %12.1f\n", "ksnprintf log line", format);
+		std::printf("%-32s %12.1f\n", "snprintf log line (libc)", libc);
+		std::printf("%-32s %12.1f (%.3f bytes per cycle)\n", "kprintf log line to console", print, bytes / print);
+	}
+
+
+	// Measure trace event cost against formatting same event (timestamp read is part of both)
+	static void benchTrace() noexcept {
+		klib::kmemoryInit();
+		sbyte_t buffer[128];
+		// Same event formatted right away (as klog does it)
+		using fault_t = decltype(u8"%llu: Page fault at %p (error %x)"_fmt);
+		const auto time		= double(measure(BENCH_TRACE_CALLS, []() noexcept {keep(cpuTimestamp());})) / double(BENCH_TRACE_CALLS);
+		const auto none		= double(measure(BENCH_TRACE_CALLS, []() noexcept {klib::ktrace(u8"Idle"_fmt);})) / double(BENCH_TRACE_CALLS);
+		const auto two		= double(measure(BENCH_TRACE_CALLS, [&buffer]() noexcept {klib::ktrace(u8"Page fault at %p (error %x)"_fmt, static_cast<pointer_t>(&buffer), dword_t(0x02U));})) / double(BENCH_TRACE_CALLS);
+		const auto six		= double(measure(BENCH_TRACE_CALLS, [&buffer]() noexcept {klib::ktrace(u8"Map %p -> %llx (%z bytes, flags %x, node %d, cpu %d)"_fmt, static_cast<pointer_t>(&buffer), quad_t(0x1234000ULL), sizeof(buffer), dword_t(0x63U), dword_t(0U), dword_t(1U));})) / double(BENCH_TRACE_CALLS);
+		const auto format	= double(measure(BENCH_TRACE_CALLS, [&buffer]() noexcept {const quad_t args[] {cpuTimestamp(), reinterpret_cast<std::size_t>(&buffer), 0x02ULL}; klib::kvformat(buffer, sizeof(buffer), fault_t::TEXT, fault_t::SPECS.data(), args); keep(buffer);})) / double(BENCH_TRACE_CALLS);
+		// Print results
+		std::printf("trace (TSC cycles per event):\n");
+		std::printf("%-32s %12.1f\n", "timestamp only", time);
+		std::printf("%-32s %12.1f\n", "ktrace no arguments", none);
+		std::printf("%-32s %12.1f\n", "ktrace 2 arguments", two);
+		std::printf("%-32s %12.1f\n", "ktrace 6 arguments", six);
+		std::printf("%-32s %12.1f\n", "kvformat same 2 arguments", format);
+	}
+
+
+	// Benchmark description
+	struct bench_t final {
+		const char*	name;		// Benchmark name
+		void		(*run)() noexcept;	// Benchmark function
+	};
+
+	// Benchmarks
+	constexpr bench_t BENCHMARKS[] {
+		{"memory",	benchMemory},
+		{"divide",	benchDivide},
+		{"print",	benchPrint},
+		{"phys",	benchPhys},
+		{"kmalloc",	benchKmalloc},
+		{"boot",	benchBoot},
+		{"serial",	benchSerial},
+		{"trace",	benchTrace}
+	};
+
+
+}	// namespace igros::host
+
+
+// Run benchmarks (all or named in command line)
+int main(int argc, char** argv) {
+	for (const auto &bench : igros::host::BENCHMARKS) {
+		// Check benchmark is selected
+		auto selected = (argc < 2);
+		for (auto i = 1; i < argc; i++) {
+			selected = selected || (0 == std::strcmp(argv[i], bench.name));
+		}
+		if (selected) {
+			bench.run();
+		}
+	}
+	return 0;
+}
+
@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel host benchmarks
+//
+//	File:	kbench.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Buddy and bitmap allocators throughput and fragmentation under same random workload
+	void	benchPhys() noexcept;
+	// Physical memory setup cost (lazy carving and eager free list)
+	void	benchBoot() noexcept;
+	// Serial output at 115200 baud: polled transmit compared with interrupt-driven ring
+	void	benchSerial() noexcept;
+	// Kernel allocator mixed sizes: size classes, page blocks and kernel heap ranges
+	void	benchKmalloc() noexcept;
+
+
+}	// namespace igros::host
+
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel trace decoder
+//
+//	File:	kdecode.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstring>
+#include <cstdio>
+
+#include <elf.h>
+
+#include <klib/kformat.hpp>
+#include <klib/ktrace.hpp>
+
+#include "kdecode.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Decoded message size (same as kernel dump)
+	constexpr auto DECODE_MESSAGE_SIZE	= 256ULL;
+
+
+	// Loaded section of ELF image
+	struct section_t final {
+		quad_t		addr;		// Kernel address
+		quad_t		size;		// Section size
+		std::size_t	offset;		// Offset in image
+	};
+
+	// ELF image sections
+	struct image_t final {
+		std::vector<section_t>	sections;	// Loaded sections
+		quad_t			mask;		// Address bits kept in image (ELF32 kernel runs with sign extended addresses)
+	};
+
+
+	// Read loaded sections of ELF image
+	template<typename H, typename S>
+	static void imageRead(const std::vector<byte_t> &elf, image_t &image) noexcept {
+		// Check header
+		if (elf.size() < sizeof(H)) {
+			return;
+		}
+		H header {};
+		std::memcpy(&header, elf.data(), sizeof(H));
+		for (auto i = 0ULL; i < header.e_shnum; i++) {
+			// Check section header
+			const auto offset = header.e_shoff + i * header.e_shentsize;
+			if ((offset + sizeof(S)) > elf.size()) {
+				break;
+			}
+			S section {};
+			std::memcpy(&section, elf.data() + offset, sizeof(S));
+			// Only sections with data in image
+			if (	(0U != (section.sh_flags & SHF_ALLOC))
+				&& (SHT_NOBITS != section.sh_type)
+				&& ((section.sh_offset + section.sh_size) <= elf.size())) {
+				image.sections.push_back({section.sh_addr & image.mask, section.sh_size, section.sh_offset});
+			}
+		}
+	}
+
+	// Read ELF image (both ELF32 and ELF64 kernels)
+	[[nodiscard]]
+	static image_t imageInit(const std::vector<byte_t> &elf) noexcept {
+		auto image = image_t {{}, ~0ULL};
+		// Check magic
+		if (	(elf.size() < EI_NIDENT)
+			|| (0 != std::memcmp(elf.data(), ELFMAG, SELFMAG))) {
+			return image;
+		}
+		if (ELFCLASS32 == elf[EI_CLASS]) {
+			image.mask = 0xFFFFFFFFULL;
+			imageRead<Elf32_Ehdr, Elf32_Shdr>(elf, image);
+		} else {
+			imageRead<Elf64_Ehdr, Elf64_Shdr>(elf, image);
+		}
+		return image;
+	}
+
+	// Find string at kernel address (nullptr if it's not in image)
+	[[nodiscard]]
+	static const sbyte_t* imageString(const std::vector<byte_t> &elf, const image_t &image, const quad_t address) noexcept {
+		const auto addr = address & image.mask;
+		for (const auto &section : image.sections) {
+			if ((addr - section.addr) < section.size) {
+				const auto text = elf.data() + section.offset + (addr - section.addr);
+				// String should end in section
+				if (nullptr != std::memchr(text, 0, section.size - (addr - section.addr))) {
+					return reinterpret_cast<const sbyte_t*>(text);
+				}
+			}
+		}
+		return nullptr;
+	}
+
+
+	// Decode one raw trace line
+	[[nodiscard]]
+	static std::string decode(const std::vector<byte_t> &elf, const image_t &image, const char* const line) noexcept {
+		// Event fields
+		auto cpu	= 0U;
+		auto count	= 0U;
+		auto timestamp	= 0ULL;
+		auto format	= 0ULL;
+		quad_t args[klib::KTRACE_ARGS] {};
+		static_assert(6ULL == klib::KTRACE_ARGS, "Raw trace line has 6 argument words");
+		if (10 != std::sscanf(line, "KTRACE %u %llx %llx %u %llx %llx %llx %llx %llx %llx", &cpu, &timestamp, &format, &count, &args[0], &args[1], &args[2], &args[3], &args[4], &args[5])) {
+			return {};
+		}
+		sbyte_t message[DECODE_MESSAGE_SIZE] {};
+		const auto text = imageString(elf, image, format);
+		if (nullptr == text) {
+			std::snprintf(message, sizeof(message), "<unknown format 0x%llX>", format);
+		} else {
+			// Specifiers are parsed same way as compiler did it for kernel
+			std::vector<klib::kformatSpec_t> specs(klib::kformatParse(text));
+			static_cast<void>(klib::kformatParse(text, specs.data()));
+			// String arguments point to kernel image too
+			auto arg = 0ULL;
+			for (const auto &spec : specs) {
+				if ((0U == spec.size) || (arg >= klib::KTRACE_ARGS)) {
+					continue;
+				}
+				if (u8's' == spec.type) {
+					const auto string = imageString(elf, image, args[arg]);
+					args[arg] = reinterpret_cast<std::size_t>((nullptr != string) ? string : u8"<?>");
+				}
+				arg++;
+			}
+			if (arg != count) {
+				std::snprintf(message, sizeof(message), "<%u arguments for \"%s\">", count, text);
+			} else {
+				klib::kvformat(message, sizeof(message), text, specs.data(), args);
+			}
+		}
+		// Same form as kernel dump
+		sbyte_t decoded[DECODE_MESSAGE_SIZE + 64ULL] {};
+		std::snprintf(decoded, sizeof(decoded), "[CPU %u] %llu:\t%s", cpu, timestamp, message);
+		return decoded;
+	}
+
+
+	// Decode raw trace lines ("KTRACE cpu tsc text count args...") with format strings from kernel ELF image
+	[[nodiscard]]
+	std::vector<std::string> ktraceDecode(const std::vector<byte_t> &elf, const std::string &log) noexcept {
+		const auto image = imageInit(elf);
+		std::vector<std::string> lines;
+		// Raw lines could be mixed with other console output
+		for (auto pos = log.find("KTRACE "); std::string::npos != pos; pos = log.find("KTRACE ", pos + 1ULL)) {
+			const auto end	= log.find_first_of("\r\n", pos);
+			const auto line	= log.substr(pos, (std::string::npos == end) ? std::string::npos : (end - pos));
+			if (auto decoded = decode(elf, image, line.c_str()); !decoded.empty()) {
+				lines.push_back(std::move(decoded));
+			}
+		}
+		return lines;
+	}
+
+
+}	// namespace igros::host
+
@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel trace decoder
+//
+//	File:	kdecode.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <string>
+#include <vector>
+
+#include <arch/types.hpp>
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Decode raw trace lines ("KTRACE cpu tsc text count args...") with format strings from kernel ELF image
+	// Returns lines in the same form as ktraceRing::dump() prints them
+	[[nodiscard]]
+	std::vector<std::string>	ktraceDecode(const std::vector<byte_t> &elf, const std::string &log) noexcept;
+
+
+}	// namespace igros::host
+
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////
+//
+//	Host memory managed as physical frames
+//
+//	File:	khost-phys.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstring>
+
+#include <sys/mman.h>
+
+#include <mem/mmap.hpp>
+
+#include "khost.hpp"
+
+
+// Memory code zone
+namespace igros::mem {
+
+
+	// Get frame descriptor by frame number (nullptr if not managed or not initialized)
+	[[nodiscard]]
+	frame_t* phys::frame(const std::size_t pfn) noexcept {
+		// Check frame is managed and its chunk is initialized
+		if (	(pfn < host::hostFirst)
+			|| (pfn >= (host::hostFirst + host::hostFrames.size()))
+			|| !host::hostChunks[(pfn - host::hostFirst) >> PHYS_MAX_ORDER]) {
+			return nullptr;
+		}
+		return &host::hostFrames[pfn - host::hostFirst];
+	}
+
+	// Initialize frames descriptors of range on first touch
+	void phys::prepare(const range_t &range) noexcept {
+		for (auto pfn = range.first; pfn < range.last; pfn += (1ULL << PHYS_MAX_ORDER)) {
+			const auto chunk = (pfn - host::hostFirst) >> PHYS_MAX_ORDER;
+			// Zero chunk descriptors once
+			if (!host::hostChunks[chunk]) {
+				std::memset(&host::hostFrames[chunk << PHYS_MAX_ORDER], 0, sizeof(frame_t) << PHYS_MAX_ORDER);
+				host::hostChunks[chunk] = true;
+			}
+		}
+	}
+
+
+}	// namespace igros::mem
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Map host memory and set up frames descriptors
+	[[nodiscard]]
+	arena_t arena(const std::size_t size, const bool populate) noexcept {
+		// Extra max order block for alignment
+		constexpr auto block	= mem::DEFAULT_PAGE_SIZE << mem::PHYS_MAX_ORDER;
+		const auto map		= ::mmap(nullptr, size + block, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | (populate ? MAP_POPULATE : 0), -1, 0);
+		if (MAP_FAILED == map) {
+			return {nullptr, 0ULL, {0ULL, 0ULL}};
+		}
+		// Frames are naturally aligned to max order block
+		const auto base		= reinterpret_cast<byte_t*>((reinterpret_cast<std::size_t>(map) + block - 1ULL) & ~(block - 1ULL));
+		const auto first	= mem::frameNumber(base);
+		// Frames descriptors are initialized on first touch
+		hostFirst	= first;
+		hostFrames.assign(size >> mem::DEFAULT_PAGE_SHIFT, mem::frame_t{});
+		hostChunks.assign((size >> mem::DEFAULT_PAGE_SHIFT) >> mem::PHYS_MAX_ORDER, false);
+		return {static_cast<byte_t*>(map), size + block, {first, first + (size >> mem::DEFAULT_PAGE_SHIFT)}};
+	}
+
+	// Unmap host memory
+	void release(const arena_t &memory) noexcept {
+		::munmap(memory.base, memory.size);
+		hostFrames	= {};
+		hostChunks	= {};
+	}
+
+
+}	// namespace igros::host
+
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////
+//
+//	Host UART (serial driver ports)
+//
+//	File:	khost-uart.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <deque>
+
+#include <arch/types.hpp>
+
+#include "khost.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Host UART port (COM1)
+	constexpr auto UART_PORT	= word_t {0x03F8};
+	// Host UART transmit FIFO size
+	constexpr auto UART_FIFO_SIZE	= 16ULL;
+
+
+	// Host UART (16550A transmitter, receiver only answers loopback test)
+	struct uart_t final {
+		std::deque<byte_t>	fifo;		// Transmit FIFO
+		quad_t			start;		// Time first byte of FIFO started to leave
+		byte_t			ier;		// Interrupt enable register
+		byte_t			lcr;		// Line control register
+		byte_t			mcr;		// Modem control register
+		byte_t			loopback;	// Byte looped back to receiver
+		bool			ready;		// Received byte is ready
+		bool			thre;		// THR empty interrupt is pending
+	};
+
+	// Host UART state
+	static uart_t	uart {};
+
+
+	// Byte left transmitter
+	static void uartSend(const byte_t value) noexcept {
+		written++;
+		if (capture) {
+			console.push_back(static_cast<sbyte_t>(value));
+		}
+	}
+
+	// Send bytes whose line time passed (FIFO drained to empty raises THR empty interrupt)
+	static void uartDrain() noexcept {
+		if (uart.fifo.empty()) {
+			return;
+		}
+		const auto now = cycles();
+		while (!uart.fifo.empty() && ((now - uart.start) >= uartByte)) {
+			uartSend(uart.fifo.front());
+			uart.fifo.pop_front();
+			uart.start += uartByte;
+		}
+		uart.thre = uart.fifo.empty();
+	}
+
+	// Write UART register
+	static void uartWrite(const word_t reg, const byte_t value) noexcept {
+		uartDrain();
+		switch (reg) {
+			// Data register (divisor latch low byte is ignored)
+			case 0U:
+				if (0U != (uart.lcr & 0x80)) {
+					break;
+				}
+				if (0U != (uart.mcr & 0x10)) {
+					uart.loopback	= value;
+					uart.ready	= true;
+					break;
+				}
+				uart.thre = false;
+				// Line is idle - byte starts to leave right away
+				if (0ULL == uartByte) {
+					uartSend(value);
+					uart.thre = true;
+				} else if (uart.fifo.empty()) {
+					uart.start = cycles();
+					uart.fifo.push_back(value);
+				} else if (uart.fifo.size() < UART_FIFO_SIZE) {
+					uart.fifo.push_back(value);
+				} else {
+					uartOverrun++;
+				}
+				break;
+			// Interrupt enable register (enabling THR empty interrupt with empty FIFO raises it)
+			case 1U:
+				if (0U == (uart.lcr & 0x80)) {
+					uart.ier	= value;
+					uart.thre	= uart.fifo.empty();
+				}
+				break;
+			// Line control register
+			case 3U:
+				uart.lcr = value;
+				break;
+			// Modem control register
+			case 4U:
+				uart.mcr = value;
+				break;
+			// FIFO control and scratch registers are ignored
+			default:
+				break;
+		}
+	}
+
+	// Read UART register
+	[[nodiscard]]
+	static byte_t uartRead(const word_t reg) noexcept {
+		uartDrain();
+		switch (reg) {
+			// Data register (loopback only)
+			case 0U:
+				uart.ready = false;
+				return uart.loopback;
+			// Interrupt identification register (reading THR empty source clears it)
+			case 2U:
+				if ((0U != (uart.ier & 0x02)) && uart.thre) {
+					uart.thre = false;
+					return 0xC2;
+				}
+				return 0xC1;
+			// Line status register
+			case 5U:
+				return (uart.fifo.empty() ? 0x60 : 0x00) | (uart.ready ? 0x01 : 0x00);
+			// Other registers read zero
+			default:
+				return 0x00;
+		}
+	}
+
+
+	// Host UART requests interrupt (enabled source is pending)
+	[[nodiscard]]
+	bool uartInterrupt() noexcept {
+		uartDrain();
+		return (0U != (uart.ier & 0x02)) && uart.thre;
+	}
+
+	// Host UART transmit FIFO is empty
+	[[nodiscard]]
+	bool uartIdle() noexcept {
+		uartDrain();
+		return uart.fifo.empty();
+	}
+
+
+}	// namespace igros::host
+
+
+#ifdef	__cplusplus
+
+extern "C" {
+
+#endif	// __cplusplus
+
+
+	// Read byte from port (only host UART is there)
+	igros::byte_t outPort8(const igros::word_t addr) noexcept {
+		return ((addr - igros::host::UART_PORT) < 8U) ? igros::host::uartRead(addr - igros::host::UART_PORT) : 0x00;
+	}
+
+	// Write byte to port (only host UART is there)
+	void inPort8(const igros::word_t addr, const igros::byte_t value) noexcept {
+		if ((addr - igros::host::UART_PORT) < 8U) {
+			igros::host::uartWrite(addr - igros::host::UART_PORT, value);
+		}
+	}
+
+
+#ifdef	__cplusplus
+
+}	// extern "C"
+
+#endif	// __cplusplus
+
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////
+//
+//	Host replacements of kernel drivers and privileged routines
+//
+//	File:	khost.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <arch/types.hpp>
+#include <arch/irq.hpp>
+
+#include <drivers/vga/vmem.hpp>
+
+#include "khost.hpp"
+
+
+#if	defined (IGROS_ARCH_i386)
+// Platform of host build
+namespace platform = igros::i386;
+#elif	defined (IGROS_ARCH_x86_64)
+// Platform of host build
+namespace platform = igros::x86_64;
+#endif
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// CPU flags interrupt enable bit (user space always runs with interrupts enabled)
+	constexpr auto CPU_FLAGS_IF	= std::size_t {0x0200};
+
+
+	// Installed interrupt handlers
+	static arch::irq::isr_t	handlers[::platform::ISR_SIZE] {};
+
+
+	// Call handler installed for hardware interrupt (same ISR number as kernel IRQ stubs push)
+	void interrupt(const dword_t number) noexcept {
+		arch::register_t regs {};
+		regs.number = arch::IRQ_OFFSET + number;
+		if (const auto isr = handlers[regs.number]; nullptr != isr) {
+			isr(&regs);
+		}
+	}
+
+
+}	// namespace igros::host
+
+
+#ifdef	__cplusplus
+
+extern "C" {
+
+#endif	// __cplusplus
+
+
+	// Read time-stamp counter
+	igros::quad_t cpuTimestamp() noexcept {
+		return igros::host::cycles();
+	}
+
+
+#if	defined (IGROS_ARCH_x86_64)
+
+	// Read CR0 register (host OS already allows SSE)
+	igros::quad_t outCR0() noexcept {
+		return 0ULL;
+	}
+
+	// Read CR4 register (host OS already allows SSE)
+	igros::quad_t outCR4() noexcept {
+		return 0ULL;
+	}
+
+	// Write CR0 register (ignored)
+	void inCR0(const igros::quad_t) noexcept {}
+
+	// Write CR4 register (ignored)
+	void inCR4(const igros::quad_t) noexcept {}
+
+#endif
+
+
+#ifdef	__cplusplus
+
+}	// extern "C"
+
+#endif	// __cplusplus
+
+
+// Arch namespace
+namespace igros::arch {
+
+
+	// Write string to VGA memory (serial copy is captured instead)
+	void vmemWrite(const sbyte_t*) noexcept {}
+
+
+}	// namespace igros::arch
+
+
+// Save interrupts state and disable interrupts (user space can't, tests are single threaded)
+std::size_t platform::irq::save() noexcept {
+	return igros::host::CPU_FLAGS_IF;
+}
+
+// Restore interrupts state
+void platform::irq::restore(const std::size_t) noexcept {}
+
+// Mask interrupt (host interrupts are delivered by hand)
+void platform::irq::mask(const irq_t) noexcept {}
+
+// Send EOI (ignored)
+void platform::irq::eoi(const irq_t) noexcept {}
+
+// Install interrupt service routine handler
+void platform::isrHandlerInstall(const igros::dword_t isrNumber, const igros::arch::irq::isr_t isrHandler) noexcept {
+	igros::host::handlers[isrNumber] = isrHandler;
+}
+
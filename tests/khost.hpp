@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////
+//
+//	Host environment for kernel library tests and benchmarks
+//
+//	File:	khost.hpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#pragma once
+
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <arch/types.hpp>
+
+#include <mem/frame.hpp>
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Failed checks count
+	inline std::size_t	failures	{0ULL};
+	// Console output captured from kernel library
+	inline std::string	console		{};
+	// Capture console output (benchmarks only count symbols)
+	inline bool		capture		{true};
+	// Console symbols written
+	inline std::size_t	written		{0ULL};
+	// Host UART time of one byte on line in TSC cycles (0 - bytes leave transmitter at once)
+	inline quad_t		uartByte	{0ULL};
+	// Bytes lost on host UART transmit FIFO overrun
+	inline std::size_t	uartOverrun	{0ULL};
+
+	// Host frames descriptors (phys::frame of host arena)
+	inline std::vector<mem::frame_t>	hostFrames	{};
+	// Host initialized frames descriptors chunks (one per max order block)
+	inline std::vector<bool>		hostChunks	{};
+	// First host frame number
+	inline std::size_t			hostFirst	{0ULL};
+
+
+	// Host memory managed as physical frames (direct map address of frame wraps to host address)
+	struct arena_t final {
+		byte_t*		base;		// Mapped memory
+		std::size_t	size;		// Mapped memory size
+		mem::range_t	frames;		// Managed frames (aligned to max order block)
+	};
+
+
+	// Host UART requests interrupt (enabled source is pending)
+	[[nodiscard]]
+	bool	uartInterrupt() noexcept;
+	// Host UART transmit FIFO is empty
+	[[nodiscard]]
+	bool	uartIdle() noexcept;
+	// Call handler installed for hardware interrupt
+	void	interrupt(const dword_t number) noexcept;
+
+	// Map host memory and set up frames descriptors (one arena at a time)
+	[[nodiscard]]
+	arena_t	arena(const std::size_t size, const bool populate) noexcept;
+	// Unmap host memory
+	void	release(const arena_t &memory) noexcept;
+
+
+	// Check condition (failure is reported with formatted context)
+	template<typename ...Args>
+	inline bool check(const bool condition, const char* const format, const Args ...args) noexcept {
+		// Condition holds
+		if (condition) {
+			return true;
+		}
+		// Report first failures only
+		if (++failures <= 32ULL) {
+			std::printf("FAIL:\t");
+			std::printf(format, args...);
+			std::printf("\n");
+		}
+		return false;
+	}
+
+	// Print test result (returns process exit code)
+	[[nodiscard]]
+	inline int result(const char* const name) noexcept {
+		std::printf("%s:\t%s (%zu failed checks)\n", name, (0ULL == failures) ? "passed" : "FAILED", failures);
+		return (0ULL == failures) ? 0 : 1;
+	}
+
+
+	// Read time-stamp counter
+	[[nodiscard]]
+	inline quad_t cycles() noexcept {
+		return __builtin_ia32_rdtsc();
+	}
+
+	// Measure best time of repeated call in TSC cycles (best of rounds filters out interrupts and migrations)
+	template<typename F>
+	[[nodiscard]]
+	inline quad_t measure(const std::size_t repeat, F &&func) noexcept {
+		// Best round
+		auto best = ~0ULL;
+		for (auto round = 0ULL; round < 8ULL; round++) {
+			const auto start = cycles();
+			for (auto i = 0ULL; i < repeat; i++) {
+				func();
+			}
+			const auto spent = cycles() - start;
+			best = (spent < best) ? spent : best;
+		}
+		return best;
+	}
+
+	// TSC cycles per microsecond
+	[[nodiscard]]
+	inline double frequency() noexcept {
+		const auto clock	= std::chrono::steady_clock::now();
+		const auto start	= cycles();
+		while ((std::chrono::steady_clock::now() - clock) < std::chrono::milliseconds(50)) {}
+		return double(cycles() - start) / 50000.0;
+	}
+
+	// Keep value alive (benchmarked code is not optimized away)
+	template<typename T>
+	inline void keep(const T &value) noexcept {
+		asm volatile("" : : "g"(&value) : "memory");
+	}
+
+
+}	// namespace igros::host
+
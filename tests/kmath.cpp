@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel math routines tests
+//
+//	File:	kmath.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cinttypes>
+#include <random>
+#include <vector>
+
+#include <klib/kmath.hpp>
+
+#include "khost.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Random values
+	static std::mt19937_64	random {2021U};
+
+
+	// Dividends around word boundaries and divisor multiples
+	[[nodiscard]]
+	static std::vector<quad_t> dividends(const dword_t divisor) noexcept {
+		std::vector<quad_t> values {0ULL, 1ULL, 0xFFFFULL, 0x10000ULL, 0xFFFFFFFFULL, 0x100000000ULL, 0xFFFFFFFFFFFFULL, 0x7FFFFFFFFFFFFFFFULL, 0x8000000000000000ULL, ~0ULL};
+		// Multiples of divisor (reminder wraps around)
+		for (const auto multiple : {1ULL, 2ULL, 0xFFFFULL, 0x10000ULL, 0xFFFFFFFFULL, 0x100000000ULL, ~0ULL / divisor}) {
+			const auto value = multiple * divisor;
+			values.insert(values.end(), {value - 1ULL, value, value + 1ULL});
+		}
+		// Random values of every length
+		for (auto shift = 0U; shift < 64U; shift++) {
+			for (auto i = 0U; i < 64U; i++) {
+				values.push_back(random() >> shift);
+			}
+		}
+		return values;
+	}
+
+
+	// Check constant divisor division (shift, 16-bit steps or hardware division) and runtime division
+	template<dword_t D>
+	static void testDivisor() noexcept {
+		for (const auto dividend : dividends(D)) {
+			const auto fixed	= klib::kudivmod<D>(dividend);
+			const auto runtime	= klib::kudivmod(dividend, D);
+			check((dividend / D == fixed.quotient) && (dividend % D == fixed.reminder), "kudivmod<%u>: %" PRIu64 " -> %" PRIu64 " %" PRIu64, D, dividend, fixed.quotient, fixed.reminder);
+			check((dividend / D == runtime.quotient) && (dividend % D == runtime.reminder), "kudivmod: %" PRIu64 " / %u -> %" PRIu64 " %" PRIu64, dividend, D, runtime.quotient, runtime.reminder);
+		}
+	}
+
+	// Check every divisor kind
+	template<dword_t ...D>
+	static void testDivisors() noexcept {
+		(testDivisor<D>(), ...);
+	}
+
+
+	// Check signed division (quotient truncated toward zero, reminder has dividend sign)
+	static void testSigned() noexcept {
+		std::vector<squad_t> values {0LL, 1LL, -1LL, INT64_MAX, INT64_MIN, INT64_MIN + 1LL, 0x7FFFFFFFLL, -0x80000000LL};
+		for (auto shift = 0U; shift < 64U; shift++) {
+			for (auto i = 0U; i < 16U; i++) {
+				values.push_back(static_cast<squad_t>(random()) >> shift);
+			}
+		}
+		std::vector<sdword_t> divisors {1, -1, 2, -2, 3, -3, 10, -10, 0xFFFF, 0x10000, INT32_MAX, INT32_MIN, INT32_MIN + 1};
+		for (auto i = 0U; i < 64U; i++) {
+			divisors.push_back(static_cast<sdword_t>(random()));
+		}
+		for (const auto dividend : values) {
+			for (const auto divisor : divisors) {
+				// Quotient doesn't fit
+				if ((INT64_MIN == dividend) && (-1 == divisor)) {
+					continue;
+				}
+				const auto res = klib::kdivmod(dividend, divisor);
+				check((dividend / divisor == res.quotient) && (dividend % divisor == res.reminder), "kdivmod: %" PRId64 " / %d -> %" PRId64 " %" PRId64, dividend, divisor, res.quotient, res.reminder);
+			}
+		}
+	}
+
+
+	// Check runtime division by random divisors
+	static void testRandom() noexcept {
+		for (auto i = 0U; i < 100000U; i++) {
+			const auto dividend	= random() >> (i & 63U);
+			const auto divisor	= static_cast<dword_t>(random() >> (32U + (i % 32U))) | 1U;
+			const auto res		= klib::kudivmod(dividend, divisor);
+			check((dividend / divisor == res.quotient) && (dividend % divisor == res.reminder), "kudivmod: %" PRIu64 " / %u -> %" PRIu64 " %" PRIu64, dividend, divisor, res.quotient, res.reminder);
+		}
+	}
+
+
+}	// namespace igros::host
+
+
+// Test kernel math routines
+int main() {
+	// Powers of 2, 16-bit divisors, divisors wider than 16 bits
+	igros::host::testDivisors<1U, 2U, 3U, 7U, 10U, 100U, 1000U, 4096U, 0xFFFFU, 0x10000U, 0x10001U, 1193182U, 100000000U, 0x80000000U, 0xFFFFFFFFU>();
+	igros::host::testSigned();
+	igros::host::testRandom();
+	return igros::host::result("kmath");
+}
+
@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel memory routines tests
+//
+//	File:	kmemory.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstring>
+#include <array>
+#include <random>
+
+#include <klib/kmemory.hpp>
+
+#include "khost.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Alignments checked for every pointer
+	constexpr auto TEST_ALIGNMENTS	= 16ULL;
+	// Sizes checked exhaustively
+	constexpr auto TEST_SIZES	= 200ULL;
+	// Sizes around routine switch points and string instruction paths
+	constexpr std::size_t TEST_LARGE_SIZES[] {255ULL, 256ULL, 1023ULL, 1024ULL, 1025ULL, 4095ULL, 4096ULL, 4097ULL, 65543ULL};
+	// Test buffer size (largest size, alignment and guard space)
+	constexpr auto TEST_BUFFER	= 65543ULL + 4ULL * TEST_ALIGNMENTS;
+	// Guard byte
+	constexpr auto TEST_GUARD	= byte_t(0xCC);
+
+
+	// Test buffers
+	static std::array<byte_t, TEST_BUFFER>	buffer;
+	static std::array<byte_t, TEST_BUFFER>	expect;
+	static std::array<byte_t, TEST_BUFFER>	source;
+
+	// Random bytes
+	static std::mt19937			random {2021U};
+
+
+	// Fill buffer with random bytes
+	static void fill(byte_t* const dst, const std::size_t size) noexcept {
+		for (auto i = 0ULL; i < size; i++) {
+			dst[i] = static_cast<byte_t>(random());
+		}
+	}
+
+	// Loop through all checked sizes
+	template<typename F>
+	static void forSizes(F &&func) noexcept {
+		for (auto size = 0ULL; size < TEST_SIZES; size++) {
+			func(size);
+		}
+		for (const auto size : TEST_LARGE_SIZES) {
+			func(size);
+		}
+	}
+
+
+	// Check fill of every alignment and size (bytes around block stay intact)
+	static void testSet() noexcept {
+		forSizes([](const std::size_t size) noexcept {
+			for (auto align = 0ULL; align < TEST_ALIGNMENTS; align++) {
+				std::memset(buffer.data(), TEST_GUARD, size + 2ULL * TEST_ALIGNMENTS);
+				std::memcpy(expect.data(), buffer.data(), size + 2ULL * TEST_ALIGNMENTS);
+				std::memset(&expect[TEST_ALIGNMENTS + align], 0x5A, size);
+				klib::kmemset(&buffer[TEST_ALIGNMENTS + align], size, byte_t(0x5A));
+				check(0 == std::memcmp(buffer.data(), expect.data(), size + 2ULL * TEST_ALIGNMENTS), "kmemset: align %zu, size %zu", align, size);
+			}
+		});
+	}
+
+	// Check copy of every source and destination alignment
+	static void testCopy() noexcept {
+		fill(source.data(), source.size());
+		forSizes([](const std::size_t size) noexcept {
+			for (auto srcAlign = 0ULL; srcAlign < TEST_ALIGNMENTS; srcAlign++) {
+				for (auto dstAlign = 0ULL; dstAlign < TEST_ALIGNMENTS; dstAlign++) {
+					std::memset(buffer.data(), TEST_GUARD, size + 2ULL * TEST_ALIGNMENTS);
+					std::memcpy(expect.data(), buffer.data(), size + 2ULL * TEST_ALIGNMENTS);
+					std::memcpy(&expect[TEST_ALIGNMENTS + dstAlign], &source[srcAlign], size);
+					klib::kmemcpy(&buffer[TEST_ALIGNMENTS + dstAlign], &source[srcAlign], size);
+					check(0 == std::memcmp(buffer.data(), expect.data(), size + 2ULL * TEST_ALIGNMENTS), "kmemcpy: src align %zu, dst align %zu, size %zu", srcAlign, dstAlign, size);
+				}
+			}
+		});
+	}
+
+	// Check move of every overlap distance in both directions
+	static void testMove() noexcept {
+		// Distances up to 64 cover head, word and string instruction paths
+		constexpr auto distances = 4ULL * TEST_ALIGNMENTS;
+		forSizes([](const std::size_t size) noexcept {
+			// Every offset for small blocks, a few for large ones
+			const auto step = (size < TEST_SIZES) ? 1ULL : 7ULL;
+			for (auto srcOffset = 0ULL; srcOffset < distances; srcOffset += step) {
+				for (auto dstOffset = 0ULL; dstOffset < distances; dstOffset += step) {
+					// Same random contents for both buffers
+					fill(buffer.data(), size + distances);
+					std::memcpy(expect.data(), buffer.data(), size + distances);
+					std::memmove(&expect[dstOffset], &expect[srcOffset], size);
+					klib::kmemmove(&buffer[dstOffset], &buffer[srcOffset], size);
+					check(0 == std::memcmp(buffer.data(), expect.data(), size + distances), "kmemmove: src offset %zu, dst offset %zu, size %zu", srcOffset, dstOffset, size);
+				}
+			}
+		});
+	}
+
+	// Check compare of every alignment and difference position (result sign matches memcmp)
+	static void testCompare() noexcept {
+		// Sign of comparison result
+		const auto sign = [](const int value) noexcept {
+			return (value > 0) - (value < 0);
+		};
+		fill(source.data(), source.size());
+		forSizes([&sign](const std::size_t size) noexcept {
+			for (auto lhsAlign = 0ULL; lhsAlign < TEST_ALIGNMENTS; lhsAlign++) {
+				for (auto rhsAlign = 0ULL; rhsAlign < TEST_ALIGNMENTS; rhsAlign++) {
+					const auto lhs = &source[lhsAlign];
+					const auto rhs = &buffer[rhsAlign];
+					std::memcpy(rhs, lhs, size);
+					// Equal blocks (bytes after block differ)
+					rhs[size] = static_cast<byte_t>(lhs[size] + 1U);
+					check(0 == klib::kmemcmp(lhs, rhs, size), "kmemcmp: equal, lhs align %zu, rhs align %zu, size %zu", lhsAlign, rhsAlign, size);
+					// Single difference at every position of small blocks, at a few of large ones
+					const auto step = (size < TEST_SIZES) ? 1ULL : ((size / 7ULL) + 1ULL);
+					for (auto pos = 0ULL; pos < size; pos += step) {
+						rhs[pos] = static_cast<byte_t>(lhs[pos] ^ (1U << (pos & 7ULL)));
+						check(sign(std::memcmp(lhs, rhs, size)) == sign(klib::kmemcmp(lhs, rhs, size)), "kmemcmp: lhs align %zu, rhs align %zu, size %zu, diff at %zu", lhsAlign, rhsAlign, size, pos);
+						rhs[pos] = lhs[pos];
+					}
+				}
+			}
+		});
+	}
+
+	// Check search of every alignment and match position (matches after block are ignored)
+	static void testFind() noexcept {
+		forSizes([](const std::size_t size) noexcept {
+			for (auto align = 0ULL; align < TEST_ALIGNMENTS; align++) {
+				const auto block = &buffer[align];
+				// Block without searched byte, searched byte right after it
+				std::memset(block, 0x11, size);
+				block[size] = 0x80;
+				check(nullptr == klib::kmemchr(block, 0x80, size), "kmemchr: not found, align %zu, size %zu", align, size);
+				check(&block[size] == klib::kmemscan(block, 0x80, size), "kmemscan: not found, align %zu, size %zu", align, size);
+				// Searched byte at every position of small blocks (second one after it), at a few of large ones
+				const auto step = (size < TEST_SIZES) ? 1ULL : ((size / 7ULL) + 1ULL);
+				for (auto pos = 0ULL; pos < size; pos += step) {
+					block[pos] = 0x80;
+					if ((pos + 1ULL) < size) {
+						block[pos + 1ULL] = 0x80;
+					}
+					check(&block[pos] == klib::kmemchr(block, 0x80, size), "kmemchr: align %zu, size %zu, match at %zu", align, size, pos);
+					check(&block[pos] == klib::kmemscan(block, 0x80, size), "kmemscan: align %zu, size %zu, match at %zu", align, size, pos);
+					block[pos] = 0x11;
+					if ((pos + 1ULL) < size) {
+						block[pos + 1ULL] = 0x11;
+					}
+				}
+			}
+		});
+		// Zero byte and bytes with high bit set are not confused with each other
+		std::memset(buffer.data(), 0xFF, 64ULL);
+		buffer[37] = 0x00;
+		check(&buffer[37] == klib::kmemchr(buffer.data(), 0x00, 64ULL), "kmemchr: zero byte among 0xFF");
+		buffer[37] = 0x7F;
+		check(nullptr == klib::kmemchr(buffer.data(), 0x00, 64ULL), "kmemchr: no zero byte among 0xFF");
+	}
+
+
+	// Run all memory tests
+	static void testAll() noexcept {
+		testSet();
+		testCopy();
+		testMove();
+		testCompare();
+		testFind();
+	}
+
+
+}	// namespace igros::host
+
+
+// Test kernel memory routines
+int main() {
+	// Plain loops (before boot selects routines)
+	igros::host::testAll();
+	// String instruction and SSE2 routines picked by CPUID
+	igros::klib::kmemoryInit();
+	igros::host::testAll();
+	return igros::host::result("kmemory");
+}
+
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////
+//
+//	Physical memory allocators tests
+//
+//	File:	kphys.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <vector>
+
+#include <mem/buddy.hpp>
+#include <mem/bitmap.hpp>
+
+#include "khost.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Test memory size (4 max order blocks)
+	constexpr auto TEST_MEMORY	= 16ULL << 20;
+	// Range above max order
+	constexpr auto TEST_RANGE	= (1ULL << mem::PHYS_MAX_ORDER) + 1ULL;
+
+
+	// Frames of test memory handed out (overlap check)
+	static std::vector<bool>	used	{};
+
+
+	// Check block is inside region, aligned and doesn't overlap other blocks (marks block frames as used)
+	static bool take(const char* const name, const mem::range_t &region, const pointer_t page, const std::size_t count, const std::size_t align) noexcept {
+		if (!check(nullptr != page, "%s: %zu frames not allocated", name, count)) {
+			return false;
+		}
+		const auto pfn = mem::frameNumber(page);
+		if (	!check((pfn >= region.first) && ((pfn + count) <= region.last), "%s: %zu frames at %zx outside region", name, count, pfn)
+			|| !check(0ULL == (pfn & (align - 1ULL)), "%s: %zu frames at %zx not aligned to %zu", name, count, pfn, align)) {
+			return false;
+		}
+		for (auto i = 0ULL; i < count; i++) {
+			if (!check(!used[pfn - hostFirst + i], "%s: frame %zx handed out twice", name, pfn + i)) {
+				return false;
+			}
+			used[pfn - hostFirst + i] = true;
+		}
+		return true;
+	}
+
+	// Forget block frames
+	static void drop(const pointer_t page, const std::size_t count) noexcept {
+		const auto pfn = mem::frameNumber(page);
+		for (auto i = 0ULL; i < count; i++) {
+			used[pfn - hostFirst + i] = false;
+		}
+	}
+
+
+	// Check alloc, free, allocRange and freeRange of allocator managing single region
+	template<typename T>
+	static void testAllocator(const char* const name, T &allocator, const mem::range_t &region) noexcept {
+		const auto total = region.last - region.first;
+		used.assign(hostFrames.size(), false);
+		check(total == allocator.freePages(), "%s: %zu free pages of %zu after init", name, allocator.freePages(), total);
+
+		// Every order is naturally aligned
+		pointer_t blocks[mem::PHYS_MAX_ORDER + 1ULL] {};
+		for (auto order = 0ULL; order <= mem::PHYS_MAX_ORDER; order++) {
+			blocks[order] = allocator.alloc(order);
+			static_cast<void>(take(name, region, blocks[order], 1ULL << order, 1ULL << order));
+		}
+		check(nullptr == allocator.alloc(mem::PHYS_MAX_ORDER + 1ULL), "%s: order above max allocated", name);
+		for (auto order = 0ULL; order <= mem::PHYS_MAX_ORDER; order++) {
+			allocator.free(blocks[order], order);
+			drop(blocks[order], 1ULL << order);
+		}
+		check(total == allocator.freePages(), "%s: %zu free pages of %zu after orders free", name, allocator.freePages(), total);
+
+		// Whole region by single pages (second free of same page is ignored)
+		std::vector<pointer_t> pages;
+		for (auto page = allocator.alloc(0ULL); nullptr != page; page = allocator.alloc(0ULL)) {
+			if (!take(name, region, page, 1ULL, 1ULL)) {
+				break;
+			}
+			pages.push_back(page);
+		}
+		check(total == pages.size(), "%s: %zu single pages of %zu allocated", name, pages.size(), total);
+		check(0ULL == allocator.freePages(), "%s: %zu free pages left when exhausted", name, allocator.freePages());
+		for (const auto page : pages) {
+			allocator.free(page, 0ULL);
+			drop(page, 1ULL);
+		}
+		allocator.free(pages.front(), 0ULL);
+		check(total == allocator.freePages(), "%s: %zu free pages of %zu after pages free", name, allocator.freePages(), total);
+
+		// Exact ranges (above max order and aligned small one)
+		const auto range	= allocator.allocRange(TEST_RANGE, 1ULL);
+		const auto rangeOk	= take(name, region, range, TEST_RANGE, 1ULL);
+		check(!rangeOk || ((total - TEST_RANGE) == allocator.freePages()), "%s: %zu free pages after %zu frames range", name, allocator.freePages(), TEST_RANGE);
+		const auto small	= allocator.allocRange(3ULL, 4ULL);
+		const auto smallOk	= take(name, region, small, 3ULL, 4ULL);
+		if (rangeOk) {
+			allocator.freeRange(range, TEST_RANGE);
+			drop(range, TEST_RANGE);
+		}
+		if (smallOk) {
+			allocator.freeRange(small, 3ULL);
+			drop(small, 3ULL);
+		}
+		check(total == allocator.freePages(), "%s: %zu free pages of %zu after ranges free", name, allocator.freePages(), total);
+
+		// Freed memory forms max order blocks again (region start is not aligned, first block is lost)
+		auto whole = 0ULL;
+		for (auto page = allocator.alloc(mem::PHYS_MAX_ORDER); nullptr != page; page = allocator.alloc(mem::PHYS_MAX_ORDER)) {
+			blocks[whole++] = page;
+		}
+		check((total >> mem::PHYS_MAX_ORDER) == whole, "%s: %zu max order blocks of %zu after free", name, whole, total >> mem::PHYS_MAX_ORDER);
+		for (auto i = 0ULL; i < whole; i++) {
+			allocator.free(blocks[i], mem::PHYS_MAX_ORDER);
+		}
+	}
+
+
+	// Check buddy allocator on region without first frame
+	static void testBuddy() noexcept {
+		const auto memory = arena(TEST_MEMORY, false);
+		if (!check(nullptr != memory.base, "buddy: can't map %zu Mb.", std::size_t(TEST_MEMORY >> 20))) {
+			return;
+		}
+		const mem::range_t region {memory.frames.first + 1ULL, memory.frames.last};
+		static mem::buddy allocator;
+		allocator.init(memory.frames, nullptr);
+		allocator.addRegion(region);
+		testAllocator("buddy", allocator, region);
+		release(memory);
+	}
+
+	// Check bitmap allocator on region without first frame
+	static void testBitmap() noexcept {
+		const auto memory = arena(TEST_MEMORY, false);
+		if (!check(nullptr != memory.base, "bitmap: can't map %zu Mb.", std::size_t(TEST_MEMORY >> 20))) {
+			return;
+		}
+		const mem::range_t region {memory.frames.first + 1ULL, memory.frames.last};
+		std::vector<std::size_t> storage((mem::bitmap::metadata(memory.frames) + sizeof(std::size_t) - 1ULL) / sizeof(std::size_t));
+		static mem::bitmap allocator;
+		allocator.init(memory.frames, storage.data());
+		allocator.addRegion(region);
+		testAllocator("bitmap", allocator, region);
+		release(memory);
+	}
+
+	// Check neighbour buddy allocators (zones or nodes) never merge or take each other's free blocks
+	static void testBuddyNeighbours() noexcept {
+		const auto memory = arena(TEST_MEMORY, false);
+		if (!check(nullptr != memory.base, "buddy: can't map %zu Mb.", std::size_t(TEST_MEMORY >> 20))) {
+			return;
+		}
+		const auto first	= memory.frames.first;
+		const auto half		= 1ULL << (mem::PHYS_MAX_ORDER - 1ULL);
+		static mem::buddy low;
+		static mem::buddy high;
+		low.init({first, first + half}, nullptr);
+		low.addRegion({first, first + half});
+		high.init({first + half, memory.frames.last}, nullptr);
+		high.addRegion({first + half, memory.frames.last});
+		// Free blocks of upper allocator right after lower one
+		std::vector<pointer_t> blocks;
+		for (auto page = high.alloc(mem::PHYS_MAX_ORDER - 1ULL); nullptr != page; page = high.alloc(mem::PHYS_MAX_ORDER - 1ULL)) {
+			blocks.push_back(page);
+		}
+		for (const auto page : blocks) {
+			high.free(page, mem::PHYS_MAX_ORDER - 1ULL);
+		}
+		const auto highFree = high.freePages();
+		// Lower half block doesn't merge with its buddy from upper allocator
+		const auto page = low.alloc(mem::PHYS_MAX_ORDER - 1ULL);
+		check(nullptr != page, "buddy neighbours: lower block not allocated");
+		low.free(page, mem::PHYS_MAX_ORDER - 1ULL);
+		check(half == low.freePages(), "buddy neighbours: lower allocator has %zu free pages of %zu", low.freePages(), half);
+		check(nullptr == low.alloc(mem::PHYS_MAX_ORDER), "buddy neighbours: lower allocator merged upper allocator block");
+		// Range doesn't run into upper allocator free blocks
+		check(nullptr == low.allocRange(TEST_RANGE, 1ULL), "buddy neighbours: lower allocator took upper allocator blocks");
+		check(highFree == high.freePages(), "buddy neighbours: upper allocator has %zu free pages of %zu", high.freePages(), highFree);
+		release(memory);
+	}
+
+
+}	// namespace igros::host
+
+
+// Test physical memory allocators
+int main() {
+	igros::host::testBuddy();
+	igros::host::testBitmap();
+	igros::host::testBuddyNeighbours();
+	return igros::host::result("kphys");
+}
+
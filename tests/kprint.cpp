@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel print routines tests
+//
+//	File:	kprint.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstring>
+#include <cinttypes>
+#include <random>
+#include <vector>
+
+#include <klib/kmemory.hpp>
+#include <klib/kprint.hpp>
+
+#include "khost.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Random values
+	static std::mt19937_64	random {2021U};
+
+
+	// Reference conversion of unsigned value
+	static void reference(char* const buffer, const std::size_t size, const quad_t value, const klib::radix_t radix) noexcept {
+		switch (radix) {
+			// No binary conversion in libc
+			case klib::radix_t::BIN: {
+				auto digits = 64 - __builtin_clzll(value | 1ULL);
+				for (auto i = 0; i < digits; i++) {
+					buffer[i] = static_cast<char>('0' + ((value >> (digits - i - 1)) & 1ULL));
+				}
+				buffer[digits] = '\0';
+			} break;
+			case klib::radix_t::OCT:
+				std::snprintf(buffer, size, "%" PRIo64, value);
+				break;
+			case klib::radix_t::DEC:
+				std::snprintf(buffer, size, "%" PRIu64, value);
+				break;
+			case klib::radix_t::HEX:
+				std::snprintf(buffer, size, "%" PRIX64, value);
+				break;
+		}
+	}
+
+	// Values around every digit count change of every radix
+	[[nodiscard]]
+	static std::vector<quad_t> boundaries() noexcept {
+		std::vector<quad_t> values {0ULL, 1ULL, 9ULL, 10ULL, 99ULL, 100ULL, 0xFFFFFFFFULL, 0x100000000ULL, ~0ULL};
+		// Powers of 10 (10^19 is the largest one that fits)
+		for (auto power = 10ULL; ; power *= 10ULL) {
+			values.insert(values.end(), {power - 1ULL, power, power + 1ULL});
+			if (power > (~0ULL / 10ULL)) {
+				break;
+			}
+		}
+		// Powers of 2
+		for (auto shift = 1U; shift < 64U; shift++) {
+			values.insert(values.end(), {(1ULL << shift) - 1ULL, 1ULL << shift, (1ULL << shift) + 1ULL});
+		}
+		// Random values of every length
+		for (auto shift = 0U; shift < 64U; shift++) {
+			for (auto i = 0U; i < 16U; i++) {
+				values.push_back(random() >> shift);
+			}
+		}
+		return values;
+	}
+
+
+	// Check integer conversion of every radix (digits count and writing)
+	static void testItoa() noexcept {
+		constexpr klib::radix_t radices[] {klib::radix_t::BIN, klib::radix_t::OCT, klib::radix_t::DEC, klib::radix_t::HEX};
+		for (const auto value : boundaries()) {
+			for (const auto radix : radices) {
+				char expect[80];
+				sbyte_t buffer[80];
+				// Unsigned value
+				reference(expect, sizeof(expect), value, radix);
+				klib::kitoa(buffer, sizeof(buffer), value, radix);
+				check(0 == std::strcmp(expect, buffer), "kitoa: %" PRIu64 " radix %u, \"%s\" != \"%s\"", value, unsigned(radix), buffer, expect);
+				// Buffer of exact size fits, one symbol less is left untouched
+				const auto length = std::strlen(expect);
+				std::memset(buffer, 0x7E, sizeof(buffer));
+				klib::kitoa(buffer, length + 1ULL, value, radix);
+				check(0 == std::strcmp(expect, buffer), "kitoa: exact size, %" PRIu64 " radix %u", value, unsigned(radix));
+				std::memset(buffer, 0x7E, sizeof(buffer));
+				klib::kitoa(buffer, length, value, radix);
+				check(0x7E == buffer[0], "kitoa: small size, %" PRIu64 " radix %u", value, unsigned(radix));
+				// Signed value (only decimal one has sign)
+				const auto signedValue = static_cast<squad_t>(value);
+				if (klib::radix_t::DEC == radix) {
+					std::snprintf(expect, sizeof(expect), "%" PRId64, signedValue);
+				}
+				klib::kitoa(buffer, sizeof(buffer), signedValue, radix);
+				check(0 == std::strcmp(expect, buffer), "kitoa: %" PRId64 " radix %u, \"%s\" != \"%s\"", signedValue, unsigned(radix), buffer, expect);
+				// Negated value
+				const auto negated = static_cast<squad_t>(~value + 1ULL);
+				if (klib::radix_t::DEC == radix) {
+					std::snprintf(expect, sizeof(expect), "%" PRId64, negated);
+				} else {
+					reference(expect, sizeof(expect), static_cast<quad_t>(negated), radix);
+				}
+				klib::kitoa(buffer, sizeof(buffer), negated, radix);
+				check(0 == std::strcmp(expect, buffer), "kitoa: %" PRId64 " radix %u, \"%s\" != \"%s\"", negated, unsigned(radix), buffer, expect);
+			}
+		}
+	}
+
+
+	// Check formatting of every conversion against snprintf (kernel prints upper case hex, width is one digit)
+	static void testFormat() noexcept {
+		for (const auto value : boundaries()) {
+			const auto low = static_cast<dword_t>(value);
+			char expect[160];
+			sbyte_t buffer[160];
+			// Quad conversions
+			std::snprintf(expect, sizeof(expect), "%" PRIu64 " %" PRId64 " %" PRIX64 " %" PRIo64 " %09" PRIu64 " %8" PRId64, value, static_cast<squad_t>(value), value, value, value, static_cast<squad_t>(value));
+			klib::ksnprintf(buffer, sizeof(buffer), u8"%llu %lld %llx %llo %09llu %8lld", value, static_cast<squad_t>(value), value, value, value, static_cast<squad_t>(value));
+			check(0 == std::strcmp(expect, buffer), "ksnprintf: quad, \"%s\" != \"%s\"", buffer, expect);
+			// Double word conversions (zero fill goes after sign)
+			std::snprintf(expect, sizeof(expect), "%u %d %X %o %08X %05d %5d", low, static_cast<int>(low), low, low, low, static_cast<int>(low), static_cast<int>(low));
+			klib::ksnprintf(buffer, sizeof(buffer), u8"%u %d %x %o %08x %05d %5d", low, static_cast<sdword_t>(low), low, low, low, static_cast<sdword_t>(low), static_cast<sdword_t>(low));
+			check(0 == std::strcmp(expect, buffer), "ksnprintf: dword, \"%s\" != \"%s\"", buffer, expect);
+			// Word, byte, size and pointer conversions
+			std::snprintf(expect, sizeof(expect), "%hu %hd %hhu %hhd %zu %0*zX", static_cast<unsigned short>(low), static_cast<short>(low), static_cast<unsigned char>(low), static_cast<signed char>(low), static_cast<std::size_t>(value), int(sizeof(pointer_t) << 1), static_cast<std::size_t>(value));
+			klib::ksnprintf(buffer, sizeof(buffer), u8"%hu %hd %hhu %hhd %z %p", low, static_cast<sdword_t>(low), low, static_cast<sdword_t>(low), static_cast<std::size_t>(value), reinterpret_cast<pointer_t>(static_cast<std::size_t>(value)));
+			check(0 == std::strcmp(expect, buffer), "ksnprintf: word, \"%s\" != \"%s\"", buffer, expect);
+			// Binary conversion
+			reference(expect, sizeof(expect), value, klib::radix_t::BIN);
+			klib::ksnprintf(buffer, sizeof(buffer), u8"%llb", value);
+			check(0 == std::strcmp(expect, buffer), "ksnprintf: binary, \"%s\" != \"%s\"", buffer, expect);
+		}
+		// Characters, strings and percent sign
+		sbyte_t buffer[64];
+		klib::ksnprintf(buffer, sizeof(buffer), u8"%c%3c %s %% [%s]", u8'a', u8'b', u8"string", u8"");
+		check(0 == std::strcmp("a  b string % []", buffer), "ksnprintf: symbols, \"%s\"", buffer);
+	}
+
+	// Check output is clipped to every buffer size (always terminated, same prefix as snprintf)
+	static void testClip() noexcept {
+		char expect[128];
+		sbyte_t buffer[128];
+		const auto length = static_cast<std::size_t>(std::snprintf(expect, sizeof(expect), "%s %09" PRIu64 " %" PRId64 " %s", "head", 12345678901234567890ULL, INT64_MIN, "tail"));
+		for (auto size = 1ULL; size < length + 4ULL; size++) {
+			char clipped[128];
+			std::snprintf(clipped, size, "%s", expect);
+			std::memset(buffer, 0x7E, sizeof(buffer));
+			klib::ksnprintf(buffer, size, u8"%s %09llu %lld %s", u8"head", 12345678901234567890ULL, INT64_MIN, u8"tail");
+			check(0 == std::strcmp(clipped, buffer), "ksnprintf: size %zu, \"%s\" != \"%s\"", size, buffer, clipped);
+			check(0x7E == buffer[size], "ksnprintf: size %zu, write past buffer", size);
+		}
+	}
+
+	// Check console output goes through log ring
+	static void testPrint() noexcept {
+		console.clear();
+		klib::kprintf(u8"%s %d %llx", u8"kprintf", -42, 0xDEADBEEFCAFEULL);
+		klib::kprintf(u8"second line");
+		check("kprintf -42 DEADBEEFCAFE\r\nsecond line\r\n" == console, "kprintf: console \"%s\"", console.c_str());
+	}
+
+
+}	// namespace igros::host
+
+
+// Test kernel print routines
+int main() {
+	igros::klib::kmemoryInit();
+	igros::host::testItoa();
+	igros::host::testFormat();
+	igros::host::testClip();
+	igros::host::testPrint();
+	return igros::host::result("kprint");
+}
+
@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel string routines tests
+//
+//	File:	kstring.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstring>
+#include <array>
+#include <random>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <klib/kmemory.hpp>
+#include <klib/kstring.hpp>
+
+#include "khost.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Alignments checked for every pointer
+	constexpr auto TEST_ALIGNMENTS	= 16ULL;
+	// Lengths checked exhaustively
+	constexpr auto TEST_LENGTHS	= 100ULL;
+	// Test buffer size (longest string, alignment and guard space)
+	constexpr auto TEST_BUFFER	= TEST_LENGTHS + 4ULL * TEST_ALIGNMENTS;
+	// Guard byte
+	constexpr auto TEST_GUARD	= sbyte_t(0x7E);
+
+
+	// Test buffers
+	static std::array<sbyte_t, TEST_BUFFER>	buffer;
+	static std::array<sbyte_t, TEST_BUFFER>	expect;
+	static std::array<sbyte_t, TEST_BUFFER>	source;
+
+	// Random symbols
+	static std::mt19937			random {2021U};
+
+	// Page followed by inaccessible page (reads past string end fault)
+	static sbyte_t*				page	{nullptr};
+	static std::size_t			pageSize{0ULL};
+
+
+	// Fill buffer with random non-zero symbols
+	static void fill(sbyte_t* const dst, const std::size_t size) noexcept {
+		for (auto i = 0ULL; i < size; i++) {
+			dst[i] = static_cast<sbyte_t>(1U + (random() % 255U));
+		}
+	}
+
+	// Make string of given length at given alignment
+	static sbyte_t* string(sbyte_t* const base, const std::size_t align, const std::size_t length) noexcept {
+		const auto str = &base[align];
+		fill(str, length);
+		str[length] = u8'\0';
+		return str;
+	}
+
+	// Sign of comparison result
+	[[nodiscard]]
+	static int sign(const int value) noexcept {
+		return (value > 0) - (value < 0);
+	}
+
+
+	// Check length of every alignment and length
+	static void testLength() noexcept {
+		for (auto length = 0ULL; length < TEST_LENGTHS; length++) {
+			for (auto align = 0ULL; align < TEST_ALIGNMENTS; align++) {
+				// Symbols after terminator are not zero
+				fill(buffer.data(), buffer.size());
+				const auto str = string(buffer.data(), align, length);
+				check(&str[length] == klib::kstrend(str), "kstrend: align %zu, length %zu", align, length);
+				check(length == klib::kstrlen(str), "kstrlen: align %zu, length %zu", align, length);
+				// Limit below, at and above string length
+				for (auto size = 0ULL; size < length + 2ULL * TEST_ALIGNMENTS; size++) {
+					check(::strnlen(str, size) == klib::kstrnlen(str, size), "kstrnlen: align %zu, length %zu, size %zu", align, length, size);
+				}
+			}
+		}
+	}
+
+	// Check compare of every alignment pair and difference position (result sign matches strncmp)
+	static void testCompare() noexcept {
+		for (auto length = 0ULL; length < TEST_LENGTHS; length += 3ULL) {
+			for (auto lhsAlign = 0ULL; lhsAlign < TEST_ALIGNMENTS; lhsAlign++) {
+				for (auto rhsAlign = 0ULL; rhsAlign < TEST_ALIGNMENTS; rhsAlign++) {
+					const auto lhs = string(source.data(), lhsAlign, length);
+					const auto rhs = &buffer[rhsAlign];
+					std::memcpy(rhs, lhs, length + 1ULL);
+					// Symbols after terminators differ
+					lhs[length + 1ULL] = u8'a';
+					rhs[length + 1ULL] = u8'b';
+					for (const auto size : {1ULL, length + 1ULL, length + 8ULL}) {
+						check(0 == klib::kstrcmp(lhs, rhs, size), "kstrcmp: equal, lhs align %zu, rhs align %zu, length %zu, size %zu", lhsAlign, rhsAlign, length, size);
+					}
+					// Zero size is wrong input
+					check(1 == klib::kstrcmp(lhs, rhs, 0ULL), "kstrcmp: zero size, lhs align %zu, rhs align %zu", lhsAlign, rhsAlign);
+					// Single difference (bigger and smaller symbol, shorter string) at every position
+					for (auto pos = 0ULL; pos < length; pos++) {
+						const auto symbol = lhs[pos];
+						for (const auto diff : {sbyte_t(symbol + 1), sbyte_t(symbol - 1), u8'\0'}) {
+							rhs[pos] = diff;
+							for (const auto size : {pos + 1ULL, pos + 2ULL, length + 1ULL}) {
+								check(sign(std::strncmp(lhs, rhs, size)) == sign(klib::kstrcmp(lhs, rhs, size)), "kstrcmp: lhs align %zu, rhs align %zu, length %zu, diff at %zu, size %zu", lhsAlign, rhsAlign, length, pos, size);
+							}
+						}
+						rhs[pos] = symbol;
+					}
+				}
+			}
+		}
+	}
+
+	// Check bounded copy of every alignment pair (rest of destination is padded)
+	static void testCopy() noexcept {
+		for (auto length = 0ULL; length < TEST_LENGTHS; length += 3ULL) {
+			for (auto srcAlign = 0ULL; srcAlign < TEST_ALIGNMENTS; srcAlign++) {
+				for (auto dstAlign = 0ULL; dstAlign < TEST_ALIGNMENTS; dstAlign++) {
+					const auto src = string(source.data(), srcAlign, length);
+					for (const auto size : {0ULL, length / 2ULL, length, length + 1ULL, length + 17ULL}) {
+						std::memset(buffer.data(), TEST_GUARD, buffer.size());
+						std::memcpy(expect.data(), buffer.data(), buffer.size());
+						std::strncpy(&expect[TEST_ALIGNMENTS + dstAlign], src, size);
+						klib::kstrncpy(src, &buffer[TEST_ALIGNMENTS + dstAlign], size);
+						check(0 == std::memcmp(buffer.data(), expect.data(), buffer.size()), "kstrncpy: src align %zu, dst align %zu, length %zu, size %zu", srcAlign, dstAlign, length, size);
+					}
+				}
+			}
+		}
+	}
+
+	// Check concatenation (whole destination buffer size, truncated result is terminated)
+	static void testConcat() noexcept {
+		// Reference - append what fits, destination without terminator stays as is
+		const auto concat = [](const sbyte_t* src, sbyte_t* dst, const std::size_t size) noexcept {
+			const auto dstLen = ::strnlen(dst, size);
+			if (dstLen >= size) {
+				return;
+			}
+			const auto srcLen = ::strnlen(src, size - dstLen - 1ULL);
+			std::memcpy(&dst[dstLen], src, srcLen);
+			dst[dstLen + srcLen] = u8'\0';
+		};
+		for (auto dstLength = 0ULL; dstLength < 40ULL; dstLength += 3ULL) {
+			for (auto srcLength = 0ULL; srcLength < 40ULL; srcLength += 5ULL) {
+				for (auto srcAlign = 0ULL; srcAlign < TEST_ALIGNMENTS; srcAlign++) {
+					for (auto dstAlign = 0ULL; dstAlign < TEST_ALIGNMENTS; dstAlign++) {
+						const auto src = string(source.data(), srcAlign, srcLength);
+						for (const auto size : {1ULL, dstLength, dstLength + 1ULL, dstLength + srcLength, dstLength + srcLength + 1ULL, dstLength + srcLength + 9ULL}) {
+							std::memset(buffer.data(), TEST_GUARD, buffer.size());
+							const auto dst = string(buffer.data(), TEST_ALIGNMENTS + dstAlign, dstLength);
+							std::memcpy(expect.data(), buffer.data(), buffer.size());
+							concat(src, &expect[TEST_ALIGNMENTS + dstAlign], size);
+							klib::kstrcat(src, dst, size);
+							check(0 == std::memcmp(buffer.data(), expect.data(), buffer.size()), "kstrcat: src align %zu, dst align %zu, src length %zu, dst length %zu, size %zu", srcAlign, dstAlign, srcLength, dstLength, size);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Check symbol search of every alignment and position (search stops at terminator and size)
+	static void testFind() noexcept {
+		// Reference - first symbol inside size symbols of string
+		const auto find = [](const sbyte_t* src, const sbyte_t chr, const std::size_t size) noexcept -> const sbyte_t* {
+			for (auto i = 0ULL; i < size; i++) {
+				if (chr == src[i]) {
+					return &src[i];
+				}
+				if (u8'\0' == src[i]) {
+					break;
+				}
+			}
+			return nullptr;
+		};
+		for (auto length = 0ULL; length < TEST_LENGTHS; length++) {
+			for (auto align = 0ULL; align < TEST_ALIGNMENTS; align++) {
+				// String without searched symbol, searched symbol right after terminator
+				const auto str = &buffer[align];
+				std::memset(str, 0x11, length);
+				str[length] = u8'\0';
+				str[length + 1ULL] = sbyte_t(0x80);
+				for (const auto size : {1ULL, length, length + 1ULL, length + 9ULL}) {
+					check(find(str, sbyte_t(0x80), size) == klib::kstrchr(str, sbyte_t(0x80), size), "kstrchr: not found, align %zu, length %zu, size %zu", align, length, size);
+					check(find(str, u8'\0', size) == klib::kstrchr(str, u8'\0', size), "kstrchr: terminator, align %zu, length %zu, size %zu", align, length, size);
+				}
+				// Searched symbol at every position (second one after it)
+				for (auto pos = 0ULL; pos < length; pos++) {
+					str[pos] = sbyte_t(0x80);
+					if ((pos + 1ULL) < length) {
+						str[pos + 1ULL] = sbyte_t(0x80);
+					}
+					for (const auto size : {pos, pos + 1ULL, length + 1ULL}) {
+						check(find(str, sbyte_t(0x80), size) == klib::kstrchr(str, sbyte_t(0x80), size), "kstrchr: align %zu, length %zu, match at %zu, size %zu", align, length, pos, size);
+					}
+					str[pos] = 0x11;
+					if ((pos + 1ULL) < length) {
+						str[pos + 1ULL] = 0x11;
+					}
+				}
+			}
+		}
+	}
+
+	// Check strings ending right before inaccessible page (word reads must not cross page)
+	static void testPageEnd() noexcept {
+		const auto end = &page[pageSize];
+		for (auto length = 0ULL; length < 4ULL * TEST_ALIGNMENTS; length++) {
+			// Terminator is the last accessible byte (every start alignment)
+			const auto str = string(end - length - 1ULL, 0ULL, length);
+			check(&str[length] == klib::kstrend(str), "kstrend: page end, length %zu", length);
+			check(length == klib::kstrnlen(str, length + 64ULL), "kstrnlen: page end, length %zu", length);
+			check(&str[length] == klib::kstrchr(str, u8'\0', length + 64ULL), "kstrchr: page end, length %zu", length);
+			// Other string at every alignment
+			for (auto align = 0ULL; align < TEST_ALIGNMENTS; align++) {
+				const auto other = &buffer[align];
+				std::memcpy(other, str, length + 1ULL);
+				check(0 == klib::kstrcmp(str, other, length + 64ULL), "kstrcmp: page end, length %zu, align %zu", length, align);
+				check(0 == klib::kstrcmp(other, str, length + 64ULL), "kstrcmp: page end, length %zu, align %zu", length, align);
+				klib::kstrncpy(str, other, length + 1ULL);
+				check(0 == std::memcmp(other, str, length + 1ULL), "kstrncpy: page end, length %zu, align %zu", length, align);
+			}
+			// String without terminator up to page end (size stops reading)
+			const auto full = end - length;
+			fill(full, length);
+			check(length == klib::kstrnlen(full, length), "kstrnlen: no terminator, length %zu", length);
+			check(nullptr == klib::kstrchr(full, u8'\0', length), "kstrchr: no terminator, length %zu", length);
+		}
+	}
+
+
+	// Run all string tests
+	static void testAll() noexcept {
+		testLength();
+		testCompare();
+		testCopy();
+		testConcat();
+		testFind();
+		testPageEnd();
+	}
+
+
+}	// namespace igros::host
+
+
+// Test kernel string routines
+int main() {
+	// Accessible page followed by guard page
+	igros::host::pageSize	= static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	const auto pages	= ::mmap(nullptr, 2ULL * igros::host::pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (MAP_FAILED == pages) {
+		std::printf("kstring:\tcan't map test pages\n");
+		return 1;
+	}
+	igros::host::page	= static_cast<igros::sbyte_t*>(pages);
+	::mprotect(igros::host::page + igros::host::pageSize, igros::host::pageSize, PROT_NONE);
+	// String routines use memory routines (plain loops and ones picked by CPUID)
+	igros::host::testAll();
+	igros::klib::kmemoryInit();
+	igros::host::testAll();
+	return igros::host::result("kstring");
+}
+
@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel trace decoder tool
+//
+//	File:	ktrace-decode.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+#include "kdecode.hpp"
+
+
+// Decode raw trace of kernel console log (ktrace-decode kernel.bin < serial.log)
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::fprintf(stderr, "Usage: %s <kernel ELF> < <console log>\n", argv[0]);
+		return 1;
+	}
+	// Kernel image
+	std::ifstream file(argv[1], std::ios::binary);
+	if (!file) {
+		std::fprintf(stderr, "Can't read %s\n", argv[1]);
+		return 1;
+	}
+	const std::vector<igros::byte_t> elf {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+	// Console log
+	std::stringstream log;
+	log << std::cin.rdbuf();
+	for (const auto &line : igros::host::ktraceDecode(elf, log.str())) {
+		std::printf("%s\n", line.c_str());
+	}
+	return 0;
+}
+
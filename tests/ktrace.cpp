@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////
+//
+//	Kernel trace tests
+//
+//	File:	ktrace.cpp
+//	Date:	16 Oct 2026
+//
+//	Copyright (c) 2017 - 2021, Igor Baklykov
+//	All rights reserved.
+//
+//
+
+
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <klib/kmemory.hpp>
+#include <klib/ktrace.hpp>
+
+#include "khost.hpp"
+#include "kdecode.hpp"
+
+
+// Host tests code zone
+namespace igros::host {
+
+
+	// Events traced (oldest ones are overwritten)
+	constexpr auto TEST_EVENTS	= klib::KTRACE_EVENTS + 37ULL;
+
+
+	// Traced pointer
+	static const dword_t	value {0U};
+
+
+	// Split console output to lines
+	[[nodiscard]]
+	static std::vector<std::string> lines(const std::string &text) noexcept {
+		std::vector<std::string> result;
+		for (auto pos = 0ULL; pos < text.size();) {
+			const auto end = text.find("\r\n", pos);
+			result.push_back(text.substr(pos, end - pos));
+			pos = (std::string::npos == end) ? text.size() : (end + 2ULL);
+		}
+		return result;
+	}
+
+	// Expected message of event
+	[[nodiscard]]
+	static std::string message(const std::size_t index) noexcept {
+		char text[128];
+		if (0ULL == (index & 1ULL)) {
+			std::snprintf(text, sizeof(text), "event %d of %s", static_cast<int>(index), "test");
+		} else {
+			std::snprintf(text, sizeof(text), "value %llu at %0*llX, flags %X", index * 1000000007ULL, static_cast<int>(2ULL * sizeof(pointer_t)), static_cast<unsigned long long>(reinterpret_cast<std::size_t>(&value)), 0x5AU);
+		}
+		return text;
+	}
+
+
+	// Check formatted dump of the newest events (arguments are read back by precomputed specifiers)
+	static void testDump() noexcept {
+		for (auto i = 0ULL; i < TEST_EVENTS; i++) {
+			if (0ULL == (i & 1ULL)) {
+				klib::ktrace(u8"event %d of %s"_fmt, static_cast<dword_t>(i), u8"test");
+			} else {
+				klib::ktrace(u8"value %llu at %p, flags %x"_fmt, quad_t(i * 1000000007ULL), &value, byte_t(0x5A));
+			}
+		}
+		console.clear();
+		klib::ktraceRing::dump();
+		const auto dump = lines(console);
+		check(klib::KTRACE_EVENTS == dump.size(), "dump: %zu events instead of %llu", dump.size(), klib::KTRACE_EVENTS);
+		auto last = 0ULL;
+		for (auto i = 0ULL; i < dump.size(); i++) {
+			// "[CPU 0] timestamp:\tmessage"
+			auto timestamp = 0ULL;
+			auto offset = 0;
+			check(1 == std::sscanf(dump[i].c_str(), "[CPU 0] %llu:\t%n", &timestamp, &offset) && (0 != offset), "dump: bad line \"%s\"", dump[i].c_str());
+			check(timestamp >= last, "dump: event %zu goes back in time", i);
+			last = timestamp;
+			const auto expect = message(TEST_EVENTS - klib::KTRACE_EVENTS + i);
+			check(expect == (dump[i].c_str() + offset), "dump: \"%s\" instead of \"%s\"", dump[i].c_str() + offset, expect.c_str());
+		}
+	}
+
+	// Check host decoder turns raw dump into same lines (test executable is ELF image with format strings)
+	static void testDecode() noexcept {
+		console.clear();
+		klib::ktraceRing::dump();
+		const auto dump = lines(console);
+		console.clear();
+		klib::ktraceRing::dumpRaw();
+		const auto raw = console;
+		// Own image
+		std::ifstream file("/proc/self/exe", std::ios::binary);
+		const std::vector<byte_t> elf {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+		const auto decoded = ktraceDecode(elf, u8"noise before\r\n" + raw);
+		check(dump.size() == decoded.size(), "decode: %zu events instead of %zu", decoded.size(), dump.size());
+		for (auto i = 0ULL; (i < dump.size()) && (i < decoded.size()); i++) {
+			check(dump[i] == decoded[i], "decode: \"%s\" instead of \"%s\"", decoded[i].c_str(), dump[i].c_str());
+		}
+		// Format outside of image
+		const auto unknown = ktraceDecode(elf, u8"KTRACE 0 1 12 0 0 0 0 0 0 0\r\n");
+		check((1ULL == unknown.size()) && (std::string::npos != unknown[0].find("<unknown format")), "decode: unknown format is not reported");
+	}
+
+
+}	// namespace igros::host
+
+
+// Test kernel trace
+int main() {
+	igros::klib::kmemoryInit();
+	igros::host::testDump();
+	igros::host::testDecode();
+	return igros::host::result("ktrace");
+}
+